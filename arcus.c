@@ -7,6 +7,228 @@
 
 #include "arcus.h"
 
+#if defined(ARCUS_EMBEDDED)
+  #include "arcus_embedded.h"
+#endif
+
+#pragma region INSTRUMENTATION
+
+  /**
+   * @author https://github.com/SigmaEG/Arcus
+   * @brief Reads a monotonic clock for `--stats`
+   * 
+   * @return `int64_t` - > Nanoseconds since an arbitrary point
+  */
+  static
+  int64_t
+  stats_now_ns(void) {
+    #if defined(_WIN32)
+      return (int64_t)GetTickCount64() * 1000000;
+    #else
+      struct timespec now;
+
+      clock_gettime(CLOCK_MONOTONIC, &now);
+
+      return (int64_t)now.tv_sec * 1000000000 + now.tv_nsec;
+    #endif
+  }
+
+  /**
+   * @author https://github.com/SigmaEG/Arcus
+   * @brief Counts a `malloc(...)` towards `--stats`
+   * 
+   * @param size > Passed to `malloc(...)`
+   * 
+   * @return `void*` - > As returned by `malloc(...)`
+  */
+  static
+  void*
+  counted_malloc(const size_t size) {
+    ++stats.allocations;
+    stats.bytes_allocated += (int64_t)size;
+
+    return malloc(size);
+  }
+
+  /**
+   * @author https://github.com/SigmaEG/Arcus
+   * @brief Counts a `calloc(...)` towards `--stats`
+   * 
+   * @param count > Passed to `calloc(...)`
+   * @param size > Passed to `calloc(...)`
+   * 
+   * @return `void*` - > As returned by `calloc(...)`
+  */
+  static
+  void*
+  counted_calloc(
+    const size_t count,
+    const size_t size
+  ) {
+    ++stats.allocations;
+    stats.bytes_allocated += (int64_t)(count * size);
+
+    return calloc(count, size);
+  }
+
+  /**
+   * @author https://github.com/SigmaEG/Arcus
+   * @brief Counts a `realloc(...)` towards `--stats`, as an allocation of its new size
+   * 
+   * @param block > Passed to `realloc(...)`
+   * @param size > Passed to `realloc(...)`
+   * 
+   * @return `void*` - > As returned by `realloc(...)`
+  */
+  static
+  void*
+  counted_realloc(
+    void* block,
+    const size_t size
+  ) {
+    ++stats.allocations;
+    stats.bytes_allocated += (int64_t)size;
+
+    return realloc(block, size);
+  }
+
+  /**
+   * @author https://github.com/SigmaEG/Arcus
+   * @brief Counts an `fread(...)` and the bytes it read towards `--stats`
+   * 
+   * @param buffer > Passed to `fread(...)`
+   * @param size > Passed to `fread(...)`
+   * @param count > Passed to `fread(...)`
+   * @param stream > Passed to `fread(...)`
+   * 
+   * @return `size_t` - > As returned by `fread(...)`
+  */
+  static
+  size_t
+  counted_fread(
+    void* buffer,
+    const size_t size,
+    const size_t count,
+    FILE* stream
+  ) {
+    size_t n_read = fread(buffer, size, count, stream);
+
+    ++stats.freads;
+    stats.bytes_read += (int64_t)(n_read * size);
+
+    return n_read;
+  }
+
+  /**
+   * @author https://github.com/SigmaEG/Arcus
+   * @brief Counts a `system(...)` towards `--stats`, as a child process Arcus waits on
+   * 
+   * @param command > Passed to `system(...)`
+   * 
+   * @return `int` - > As returned by `system(...)`
+  */
+  static
+  int
+  counted_system(const char* command) {
+    int64_t start_ns = stats.enabled ? stats_now_ns() : 0;
+    int status = system(command);
+
+    ++stats.children;
+
+    if (stats.enabled)
+      stats.child_wait_ns += stats_now_ns() - start_ns;
+
+    return status;
+  }
+
+  #if defined(__unix__) || defined(__linux__)
+    /**
+     * @author https://github.com/SigmaEG/Arcus
+     * @brief Counts a `fork(...)` towards `--stats`
+     * 
+     * @return `pid_t` - > As returned by `fork(...)`
+    */
+    static
+    pid_t
+    counted_fork(void) {
+      pid_t pid = fork();
+
+      if (pid > 0)
+        ++stats.children;
+
+      return pid;
+    }
+
+    /**
+     * @author https://github.com/SigmaEG/Arcus
+     * @brief Counts the time blocked in `waitpid(...)` towards `--stats`
+     * 
+     * @param pid > Passed to `waitpid(...)`
+     * @param status > Passed to `waitpid(...)`
+     * @param options > Passed to `waitpid(...)`
+     * 
+     * @return `pid_t` - > As returned by `waitpid(...)`
+    */
+    static
+    pid_t
+    counted_waitpid(
+      pid_t pid,
+      int* status,
+      int options
+    ) {
+      if (!stats.enabled || (options & WNOHANG) != 0)
+        return waitpid(pid, status, options);
+
+      int64_t start_ns = stats_now_ns();
+      pid_t done = waitpid(pid, status, options);
+
+      stats.child_wait_ns += stats_now_ns() - start_ns;
+
+      return done;
+    }
+  #endif
+
+  // Every allocation, read, spawn and wait below this point goes through the counters above
+  #define malloc(size) counted_malloc(size)
+  #define calloc(count, size) counted_calloc(count, size)
+  #define realloc(block, size) counted_realloc(block, size)
+  #define fread(buffer, size, count, stream) counted_fread(buffer, size, count, stream)
+  #define system(command) counted_system(command)
+
+  #if defined(__unix__) || defined(__linux__)
+    #define fork() counted_fork()
+    #define waitpid(pid, status, options) counted_waitpid(pid, status, options)
+  #endif
+
+  /**
+   * @author https://github.com/SigmaEG/Arcus
+   * @brief Records the time and bytes spent parsing an Arcus file for `--stats`
+   * 
+   * @param path > Path of the file
+   * @param start_ns > `stats_now_ns()` before parsing
+   * @param bytes_before > `stats.bytes_read` before parsing
+   * 
+   * @return `void`
+  */
+  static
+  void
+  record_parse(
+    const char* path,
+    const int64_t start_ns,
+    const int64_t bytes_before
+  ) {
+    if (!stats.enabled || stats.n_files == ARCUS_STATS_MAX_FILES)
+      return;
+
+    arcus_file_stats_t* file = &stats.files[stats.n_files++];
+
+    snprintf(file->path, sizeof(file->path), "%s", path);
+    file->elapsed_ns = stats_now_ns() - start_ns;
+    file->bytes_read = stats.bytes_read - bytes_before;
+  }
+
+#pragma endregion INSTRUMENTATION
+
 #pragma region LOCAL FUNCTION DECLARATIONS
 
   /**
@@ -67,16 +289,13 @@
     } else {
       bool char_found = false;
 
+      // The first character is always kept, `new_pos` is the last character kept
       for (int32_t idx = string_len - 1; idx > 0; --idx) {
-        new_pos = idx;
-
-        if (!char_found) {
-          if ((*string)[idx] == to_strip)
-            char_found = true;
-        }
-
         if ((*string)[idx] != to_strip)
           break;
+
+        char_found = true;
+        new_pos = idx - 1;
       }
 
       if (char_found) {
@@ -94,6 +313,87 @@
     }
   }
 
+  /**
+   * @author https://github.com/SigmaEG/Arcus/Arcus
+   * @brief Strips the indentation, quotes and trailing comma surrounding a header line
+   * 
+   * @param line > Reference to the line to be stripped
+   * 
+   * @return `void`
+  */
+  static
+  void
+  strip_header(char** line) {
+    strip_trailing_char(
+      line,
+      '\t',
+      false
+    );
+    strip_trailing_char(
+      line,
+      ' ',
+      false
+    );
+    strip_trailing_char(
+      line,
+      '"',
+      false
+    );
+    strip_trailing_char(
+      line,
+      ' ',
+      true
+    );
+    strip_trailing_char(
+      line,
+      ',',
+      true
+    );
+    strip_trailing_char(
+      line,
+      '"',
+      true
+    );
+  }
+
+  /**
+   * @author https://github.com/SigmaEG/Arcus/Arcus
+   * @brief Strips the indentation and quotes surrounding a body line
+   * 
+   * @param line > Reference to the line to be stripped
+   * 
+   * @return `void`
+  */
+  static
+  void
+  strip_body(char** line) {
+    strip_trailing_char(
+      line,
+      '\t',
+      false
+    );
+    strip_trailing_char(
+      line,
+      ' ',
+      false
+    );
+    strip_trailing_char(
+      line,
+      '"',
+      false
+    );
+    strip_trailing_char(
+      line,
+      ' ',
+      true
+    );
+    strip_trailing_char(
+      line,
+      '"',
+      true
+    );
+  }
+
   /**
    * @author https://github.com/SigmaEG/Arcus/Arcus
    * @brief Frees a 2D C-Style String Array
@@ -136,33 +436,28 @@
   }
 
   /**
-   * @author https://github.com/SigmaEG/Arcus/Arcus
-   * @brief Parses Arcus files efficiently
+   * @author https://github.com/SigmaEG/Arcus
+   * @brief Reads the next entry of an Arcus file in the brace format, consuming no more of it than the entry
    * 
    * @param file > Arcus file reference
-   * @param size_out > Reference to an `int32_t` that will store the amount of elements in `return`
+   * @param parsing_package > Whether an entry has been opened, carried between calls (initially false)
+   * @param header_out > Receives the stripped header
+   * @param body_out > Receives the stripped body
    * 
-   * @return `char***` - > A 2D C-Style String Array containing Arcus data
+   * @return `bool` - > Whether an entry was read, false once the closing brace, an empty line or the end of the file is reached
   */
   static
-  char***
-  parse(
+  bool
+  next_entry(
     FILE* file,
-    int32_t* size_out
+    bool* parsing_package,
+    char** header_out,
+    char** body_out
   ) {
-    if (file == NULL)
-      return NULL;
-
-    char*** parsed_data = NULL;
-    int32_t data_size = 0;
-
     char* line = NULL;
     int32_t line_size;
 
-    bool parsing_package = false;
-
     char* header = NULL;
-    char* body = NULL;
 
     while ((line = arcus_getline(
       &line_size,
@@ -171,166 +466,111 @@
       file
     )) != NULL) {
       if (line_size <= 0) {
-        if (line != NULL) {
-          free(line);
-          line = NULL;
-        }
+        free(line);
+
+        // Entries cut off by the end of the stream (or a cancellation whilst waiting on it) are dropped
+        if (feof(file) || ferror(file))
+          break;
 
         continue;
       }
 
       if (strcmp(line, "{") == 0 || strcmp(line, "},") == 0) {
-        parsing_package = true;
-        
-        if (line != NULL) {
-          free(line);
-          line = NULL;
-        }
+        *parsing_package = true;
+        free(line);
 
         continue;
       }
 
       if (strcmp(line, "}") == 0) {
-        parsing_package = false;
-
-        if (line != NULL) {
-          free(line);
-          line = NULL;
-        }
+        *parsing_package = false;
+        free(line);
 
         break;
       }
 
-      if (parsing_package) {
-        if (header == NULL && body == NULL) {
-          strip_trailing_char(
-            &line,
-            '\t',
-            false
-          );
-          strip_trailing_char(
-            &line,
-            ' ',
-            false
-          );
-          strip_trailing_char(
-            &line,
-            '"',
-            false
-          );
-          strip_trailing_char(
-            &line,
-            ' ',
-            true
-          );
-          strip_trailing_char(
-            &line,
-            ',',
-            true
-          );
-          strip_trailing_char(
-            &line,
-            '"',
-            true
-          );
-
-          header = line;
-
-          continue;
-        }
-
-        if (body == NULL && header != NULL) {
-          strip_trailing_char(
-            &line,
-            '\t',
-            false
-          );
-          strip_trailing_char(
-            &line,
-            ' ',
-            false
-          );
-          strip_trailing_char(
-            &line,
-            '"',
-            false
-          );
-          strip_trailing_char(
-            &line,
-            ' ',
-            true
-          );
-          strip_trailing_char(
-            &line,
-            '"',
-            true
-          );
-
-          body = line;
-        }
-
-        if (header != NULL && body != NULL) {
-          if (parsed_data == NULL) {
-            parsed_data = (char***)calloc(1, sizeof(char**));
-
-            if (parsed_data != NULL) {
-              parsed_data[0] = (char**)calloc(2, sizeof(char*));
-              
-              if (parsed_data[0] != NULL) {
-                parsed_data[0][0] = header;
-                parsed_data[0][1] = body;
-
-                data_size = 1;
-              } else {
-                free(parsed_data);
-                parsed_data = NULL;
-                data_size = 0;
-
-                free(header);
-                free(body);
-
-                continue;
-              }
-            } else {
-              free(header);
-              free(body);
+      if (!*parsing_package) {
+        free(line);
 
-              continue;
-            }
-          } else {
-            char*** re_alloc = (char***)realloc(parsed_data, (data_size + 1) * sizeof(char**));
-          
-            if (re_alloc != NULL) {
-              parsed_data = re_alloc;
-              parsed_data[data_size] = (char**)calloc(2, sizeof(char*));
-              
-              if (parsed_data[data_size] != NULL) {
-                parsed_data[data_size][0] = header;
-                parsed_data[data_size][1] = body;
-
-                ++data_size;
-              } else {
-                parsed_data = (char***)realloc(parsed_data, data_size * sizeof(char**));
-
-                free(header);
-                free(body);
-
-                continue;
-              }
-            } else {
-              free(header);
-              free(body);
+        continue;
+      }
 
-              continue;
-            }
-          }
-        }
+      if (header == NULL) {
+        strip_header(&line);
+
+        header = line;
+
+        continue;
+      }
+
+      strip_body(&line);
+
+      *header_out = header;
+      *body_out = line;
+
+      return true;
+    }
+
+    free(header);
+
+    return false;
+  }
+
+  /**
+   * @author https://github.com/SigmaEG/Arcus/Arcus
+   * @brief Parses Arcus files efficiently
+   * 
+   * @param file > Arcus file reference
+   * @param size_out > Reference to an `int32_t` that will store the amount of elements in `return`
+   * 
+   * @return `char***` - > A 2D C-Style String Array containing Arcus data
+  */
+  static
+  char***
+  parse(
+    FILE* file,
+    int32_t* size_out
+  ) {
+    if (file == NULL)
+      return NULL;
+
+    char*** parsed_data = NULL;
+    int32_t data_size = 0;
+
+    bool parsing_package = false;
+
+    char* header = NULL;
+    char* body = NULL;
+
+    while (next_entry(
+      file,
+      &parsing_package,
+      &header,
+      &body
+    )) {
+      char*** re_alloc = (char***)realloc(parsed_data, (data_size + 1) * sizeof(char**));
 
-        header = NULL;
-        body = NULL;
+      if (re_alloc == NULL) {
+        free(header);
+        free(body);
 
         continue;
       }
+
+      parsed_data = re_alloc;
+      parsed_data[data_size] = (char**)calloc(2, sizeof(char*));
+
+      if (parsed_data[data_size] == NULL) {
+        free(header);
+        free(body);
+
+        continue;
+      }
+
+      parsed_data[data_size][0] = header;
+      parsed_data[data_size][1] = body;
+
+      ++data_size;
     }
 
     if (size_out != NULL)
@@ -341,48 +581,7176 @@
     return parsed_data;
   }
 
-#pragma endregion LOCAL FUNCTION DECLARATIONS
-
-#pragma region FUNCTION DECLARATIONS
-
+  /**
+   * @author https://github.com/SigmaEG/Arcus
+   * @brief Lists the packages to be installed and asks the user for confirmation
+   * 
+   * @param ignore > The ignore list to query
+   * @param n_ignore > Number of ignored packages (size of `ignore`)
+   * 
+   * @return `bool` - > Whether the user confirmed the installation
+  */
+  static
   bool
-  pathexists(const char* path) {
-    struct stat file;
-
-    if (stat(path, &file) == 0)
-      return true;
+  confirm_installation(
+    const char** ignore,
+    const int32_t n_ignore
+  ) {
+    list_packages(ignore, n_ignore);
 
-    return false;
-  }
+    printf("%s\nAre you sure you'd like to continue to installation? (%sY%s/%sn%s):%s ", KBLU, KGRN, KBLU, KRED, KBLU, KGRN);
 
-  #pragma region OS-SPECIFIC DECLARATIONS
+    int64_t start_ns = stats.enabled ? stats_now_ns() : 0;
+    char* confirmation = arcus_getline(NULL, true, '\n', stdin);
 
-    #if defined(__unix__) || defined(__linux__)
-      bool
-      has_neofetch(void) {
-        if (pathexists("/usr/local/bin/neofetch")
-            || pathexists("/usr/bin/neofetch")
-            || pathexists("/var/lib/flatpak/exports/bin/neofetch")
-        ) {
-          return true;
-        }
+    if (stats.enabled)
+      stats.input_wait_ns += stats_now_ns() - start_ns;
 
-        return false;
-      }
+    if (confirmation != NULL) {
+      bool confirmed = tolower(confirmation[0]) == 'y';
 
-      bool
-      has_lolcat(void) {
-        if (pathexists("/usr/local/bin/lolcat")
-            || pathexists("/usr/bin/lolcat")
-            || pathexists("/var/lib/flatpak/exports/bin/lolcat")
-        ) {
-          if (LOLCAT_SUPPORT)
-            return true;
-        }
+      free(confirmation);
 
-        return false;
-      }
-    #endif
+      return confirmed;
+    }
+
+    return true;
+  }
+
+  /**
+   * @author https://github.com/SigmaEG/Arcus
+   * @brief Writes a string as a quoted C string literal
+   * 
+   * @param out > Stream to write to
+   * @param string > String to quote and escape
+   * 
+   * @return `void`
+  */
+  static
+  void
+  write_c_string(
+    FILE* out,
+    const char* string
+  ) {
+    fputc('"', out);
+
+    for (const unsigned char* cursor = (const unsigned char*)string; *cursor != '\0'; ++cursor) {
+      if (*cursor == '\\' || *cursor == '"' || *cursor == '?')
+        fprintf(out, "\\%c", *cursor);
+      else if (*cursor == '\n')
+        fprintf(out, "\\n");
+      else if (*cursor == '\t')
+        fprintf(out, "\\t");
+      else if (!isprint(*cursor))
+        fprintf(out, "\\%03o", *cursor);
+      else
+        fputc(*cursor, out);
+    }
+
+    fputc('"', out);
+  }
+
+  /**
+   * @author https://github.com/SigmaEG/Arcus
+   * @brief Parses an integer parameter of a single-valued argument (command) from the argv list
+   * 
+   * @param argv > Passed from `int32_t main(..., const char** argv)`
+   * @param n_max_argv > Passed from `int32_t main(int32_t argc, ...)`
+   * @param arg_name > Name of the Command to Parse
+   * @param value_out > Receives the parsed value, -1 if the parameter is missing or -2 if it isn't a non-negative integer
+   * 
+   * @return `bool` - > Whether the argument was specified
+  */
+  static
+  bool
+  parse_integer_argument(
+    const char** argv,
+    const int32_t n_max_argv,
+    const char* arg_name,
+    int64_t* value_out
+  ) {
+    bool found = false;
+
+    for (int32_t arg_idx = 0; arg_idx < n_max_argv; ++arg_idx) {
+      if (strcmp(argv[arg_idx], arg_name) == 0)
+        found = true;
+    }
+
+    if (!found)
+      return false;
+
+    int32_t n_params = 0;
+    const char** params = parse_arguments(
+      argv,
+      n_max_argv,
+      arg_name,
+      1,
+      &n_params
+    );
+
+    *value_out = -1;
+
+    if (params != NULL && n_params == 1) {
+      char* end = NULL;
+      long long value = strtoll(params[0], &end, 10);
+
+      *value_out = end != params[0] && *end == '\0' && value >= 0 ? (int64_t)value : -2;
+    }
+
+    free(params);
+
+    return true;
+  }
+
+  /**
+   * @author https://github.com/SigmaEG/Arcus
+   * @brief Resets a resource budget so that every setting is left alone
+   * 
+   * @param limits > Budget to reset
+   * 
+   * @return `void`
+  */
+  static
+  void
+  clear_limits(arcus_limits_t* limits) {
+    limits->active = false;
+    limits->nice = ARCUS_LIMIT_UNSET;
+    limits->io_class = ARCUS_LIMIT_UNSET;
+    limits->io_level = 0;
+    limits->address_space = ARCUS_LIMIT_UNSET;
+    limits->processes = ARCUS_LIMIT_UNSET;
+    limits->cpu_seconds = ARCUS_LIMIT_UNSET;
+    limits->cpu_max_percent = ARCUS_LIMIT_UNSET;
+    limits->memory_max = ARCUS_LIMIT_UNSET;
+  }
+
+  /**
+   * @author https://github.com/SigmaEG/Arcus
+   * @brief Parses a non-negative number of an `arcus.limits` setting
+   * 
+   * @param value > Text of the value
+   * @param size > Whether a K, M, G or T (binary) suffix is allowed
+   * @param value_out > Receives the parsed value
+   * 
+   * @return `bool` - > Whether the value was valid
+  */
+  static
+  bool
+  parse_limit_value(
+    const char* value,
+    const bool size,
+    int64_t* value_out
+  ) {
+    const char units[] = "KMGT";
+    char* end = NULL;
+    long long parsed = strtoll(value, &end, 10);
+    int32_t shift = 0;
+
+    if (end == value || parsed < 0)
+      return false;
+
+    if (size && *end != '\0') {
+      const char* unit = strchr(units, toupper((unsigned char)*end));
+
+      if (unit == NULL || end[1] != '\0')
+        return false;
+
+      shift = 10 * (int32_t)(unit - units + 1);
+      ++end;
+    }
+
+    if (*end != '\0' || parsed > (INT64_MAX >> shift))
+      return false;
+
+    *value_out = (int64_t)parsed << shift;
+
+    return true;
+  }
+
+  /**
+   * @author https://github.com/SigmaEG/Arcus
+   * @brief Parses the whitespace-separated `<setting>=<value>` list of an `arcus.limits` entry on top of a budget
+   * 
+   * @param name > Header of the entry, for error messages
+   * @param settings > Body of the entry
+   * @param limits > Budget the settings are written to, settings that aren't mentioned are kept
+   * 
+   * @return `bool` - > Whether every setting was valid
+  */
+  static
+  bool
+  parse_limit_settings(
+    const char* name,
+    const char* settings,
+    arcus_limits_t* limits
+  ) {
+    char* copy = strdup(settings);
+    bool valid = copy != NULL;
+
+    for (char* token = valid ? strtok(copy, " \t") : NULL; token != NULL && valid; token = strtok(NULL, " \t")) {
+      char* equals = strchr(token, '=');
+
+      valid = equals != NULL;
+
+      if (!valid) {
+        fprintf(stderr, "%s< INVALID LIMIT FOR %s%s%s : %s >\n", KRED, KMAG, name, KRED, token);
+
+        break;
+      }
+
+      const char* value = equals + 1;
+      int64_t number = 0;
+
+      *equals = '\0';
+
+      if (strcmp(token, "nice") == 0) {
+        char* end = NULL;
+        long level = strtol(value, &end, 10);
+
+        valid = end != value && *end == '\0' && level >= -20 && level <= 19;
+        limits->nice = (int32_t)level;
+      } else if (strcmp(token, "ionice") == 0) {
+        const char* classes[] = { "realtime", "best-effort", "idle" };
+        size_t class_len = strcspn(value, ":");
+
+        valid = false;
+
+        for (int32_t class_idx = 0; class_idx < 3; ++class_idx) {
+          if (strlen(classes[class_idx]) == class_len && strncmp(value, classes[class_idx], class_len) == 0) {
+            limits->io_class = class_idx + 1;
+            limits->io_level = class_idx == 2 ? 0 : 4;
+            valid = true;
+          }
+        }
+
+        if (valid && value[class_len] == ':') {
+          valid = limits->io_class != 3 && parse_limit_value(value + class_len + 1, false, &number) && number <= 7;
+          limits->io_level = (int32_t)number;
+        }
+      } else if (strcmp(token, "as") == 0 || strcmp(token, "memory.max") == 0) {
+        valid = parse_limit_value(value, true, &number) && number > 0;
+        *(strcmp(token, "as") == 0 ? &limits->address_space : &limits->memory_max) = number;
+      } else if (strcmp(token, "nproc") == 0 || strcmp(token, "cpu") == 0) {
+        valid = parse_limit_value(value, false, &number) && number > 0;
+        *(strcmp(token, "nproc") == 0 ? &limits->processes : &limits->cpu_seconds) = number;
+      } else if (strcmp(token, "cpu.max") == 0) {
+        char percent[32];
+
+        snprintf(percent, sizeof(percent), "%s", value);
+        percent[strcspn(percent, "%")] = '\0';
+        valid = strlen(value) < sizeof(percent) && parse_limit_value(percent, false, &number) && number > 0 && number <= 100000;
+        limits->cpu_max_percent = number;
+      } else
+        valid = false;
+
+      if (!valid) {
+        *equals = '=';
+        fprintf(stderr, "%s< INVALID LIMIT FOR %s%s%s : %s >\n", KRED, KMAG, name, KRED, token);
+      }
+    }
+
+    free(copy);
+
+    return valid;
+  }
+
+  /**
+   * @author https://github.com/SigmaEG/Arcus
+   * @brief Marks a budget as active when any of its settings is set
+   * 
+   * @param limits > Budget to update
+   * 
+   * @return `void`
+  */
+  static
+  void
+  update_limits_active(arcus_limits_t* limits) {
+    limits->active =
+      limits->nice != ARCUS_LIMIT_UNSET || limits->io_class != ARCUS_LIMIT_UNSET ||
+      limits->address_space != ARCUS_LIMIT_UNSET || limits->processes != ARCUS_LIMIT_UNSET ||
+      limits->cpu_seconds != ARCUS_LIMIT_UNSET || limits->cpu_max_percent != ARCUS_LIMIT_UNSET ||
+      limits->memory_max != ARCUS_LIMIT_UNSET;
+  }
+
+  /**
+   * @author https://github.com/SigmaEG/Arcus
+   * @brief Builds the budget of a single Package from the entries of `arcus.limits`, for Packages that aren't in `packages`
+   * 
+   * @param entries > Parsed entries of `arcus.limits`
+   * @param n_entries > Number of elements in `entries`
+   * @param pkg_name > Name (header) of the Package
+   * @param limits > Receives the `default` entry overridden by the Package's own entry
+   * 
+   * @return `void`
+   * @note The entries must have been validated beforehand, invalid settings are skipped
+  */
+  static
+  void
+  select_limits(
+    char*** entries,
+    const int32_t n_entries,
+    const char* pkg_name,
+    arcus_limits_t* limits
+  ) {
+    clear_limits(limits);
+
+    for (int32_t entry_idx = 0; entry_idx < n_entries; ++entry_idx) {
+      if (strcmp(entries[entry_idx][0], ARCUS_LIMITS_DEFAULT) == 0)
+        parse_limit_settings(entries[entry_idx][0], entries[entry_idx][1], limits);
+    }
+
+    for (int32_t entry_idx = 0; entry_idx < n_entries; ++entry_idx) {
+      if (strcmp(entries[entry_idx][0], pkg_name) == 0 && strcmp(pkg_name, ARCUS_LIMITS_DEFAULT) != 0)
+        parse_limit_settings(entries[entry_idx][0], entries[entry_idx][1], limits);
+    }
+
+    update_limits_active(limits);
+  }
+
+  /**
+   * @author https://github.com/SigmaEG/Arcus
+   * @brief Formats an amount of bytes with a binary unit
+   * 
+   * @param bytes > Amount of bytes
+   * @param out > Buffer receiving the text
+   * @param out_size > Size of `out`
+   * 
+   * @return `void`
+  */
+  static
+  void
+  format_size(
+    const int64_t bytes,
+    char* out,
+    const size_t out_size
+  ) {
+    const char units[] = "KMGT";
+    double scaled = (double)bytes;
+    int32_t unit_idx = -1;
+
+    while (scaled >= 1024.0 && unit_idx < 3) {
+      scaled /= 1024.0;
+      ++unit_idx;
+    }
+
+    if (unit_idx < 0)
+      snprintf(out, out_size, "%lldB", (long long)bytes);
+    else
+      snprintf(out, out_size, "%.1f%c", scaled, units[unit_idx]);
+  }
+
+  /**
+   * @author https://github.com/SigmaEG/Arcus
+   * @brief Describes the settings of a budget, e.g. `nice 10, ionice idle, memory.max 2.0G`
+   * 
+   * @param limits > Budget to describe
+   * @param out > Buffer receiving the description
+   * @param out_size > Size of `out`
+   * 
+   * @return `void`
+  */
+  static
+  void
+  describe_limits(
+    const arcus_limits_t* limits,
+    char* out,
+    const size_t out_size
+  ) {
+    const char* classes[] = { "realtime", "best-effort", "idle" };
+    char size[32];
+    char part[64];
+
+    out[0] = '\0';
+
+    for (int32_t setting_idx = 0; setting_idx < 7; ++setting_idx) {
+      part[0] = '\0';
+
+      switch (setting_idx) {
+        case 0:
+          if (limits->nice != ARCUS_LIMIT_UNSET)
+            snprintf(part, sizeof(part), "nice %d", limits->nice);
+
+          break;
+        case 1:
+          if (limits->io_class == 3)
+            snprintf(part, sizeof(part), "ionice idle");
+          else if (limits->io_class != ARCUS_LIMIT_UNSET)
+            snprintf(part, sizeof(part), "ionice %s:%d", classes[limits->io_class - 1], limits->io_level);
+
+          break;
+        case 2:
+          if (limits->address_space != ARCUS_LIMIT_UNSET) {
+            format_size(limits->address_space, size, sizeof(size));
+            snprintf(part, sizeof(part), "as %s", size);
+          }
+
+          break;
+        case 3:
+          if (limits->processes != ARCUS_LIMIT_UNSET)
+            snprintf(part, sizeof(part), "nproc %lld", (long long)limits->processes);
+
+          break;
+        case 4:
+          if (limits->cpu_seconds != ARCUS_LIMIT_UNSET)
+            snprintf(part, sizeof(part), "cpu %llds", (long long)limits->cpu_seconds);
+
+          break;
+        case 5:
+          if (limits->cpu_max_percent != ARCUS_LIMIT_UNSET)
+            snprintf(part, sizeof(part), "cpu.max %lld%%", (long long)limits->cpu_max_percent);
+
+          break;
+        default:
+          if (limits->memory_max != ARCUS_LIMIT_UNSET) {
+            format_size(limits->memory_max, size, sizeof(size));
+            snprintf(part, sizeof(part), "memory.max %s", size);
+          }
+
+          break;
+      }
+
+      size_t used = strlen(out);
+
+      if (part[0] != '\0' && used + 1 < out_size)
+        snprintf(out + used, out_size - used, "%s%s", used > 0 ? ", " : "", part);
+    }
+  }
+
+  /**
+   * @author https://github.com/SigmaEG/Arcus
+   * @brief Writes the outcome of every Package of a cancelled run, one `<state>\t<package>` line each
+   * 
+   * @param states > Per-Package state (`installed`, `failed`, `ignored`, `cancelled`), NULL for Packages that never started
+   * 
+   * @return `void`
+   * @note Written to `log_run_dir/results.txt` when logging, else `ARCUS_LOG_DIR/cancelled-<date>-<time>-<pid>.txt`
+  */
+  static
+  void
+  write_partial_results(const char** states) {
+    char path[ARCUS_PATH_MAX + 32];
+
+    if (log_run_dir[0] != '\0')
+      snprintf(path, sizeof(path), "%s/results.txt", log_run_dir);
+    else {
+      char stamp[32];
+      time_t now = time(NULL);
+
+      strftime(stamp, sizeof(stamp), "%Y%m%d-%H%M%S", localtime(&now));
+
+      #if defined(__unix__) || defined(__linux__)
+        if (!pathexists(ARCUS_LOG_DIR))
+          mkdir(ARCUS_LOG_DIR, 0755);
+
+        snprintf(path, sizeof(path), ARCUS_LOG_DIR "/cancelled-%s-%ld.txt", stamp, (long)getpid());
+      #else
+        snprintf(path, sizeof(path), ARCUS_LOG_DIR "/cancelled-%s.txt", stamp);
+      #endif
+    }
+
+    FILE* file = fopen(path, "w");
+
+    if (file == NULL) {
+      fprintf(stderr, "%s< FAILED TO WRITE PARTIAL RESULTS : %s >\n", KRED, path);
+
+      return;
+    }
+
+    for (int32_t pkg_idx = 0; pkg_idx < n_packages; ++pkg_idx)
+      fprintf(file, "%s\t%s\n", states[pkg_idx] != NULL ? states[pkg_idx] : "not-started", packages[pkg_idx][0]);
+
+    if (fclose(file) == 0)
+      printf("%s< PARTIAL RESULTS WRITTEN TO : %s%s%s >\n", KYEL, KMAG, path, KYEL);
+  }
+
+  /**
+   * @author https://github.com/SigmaEG/Arcus
+   * @brief Checks whether a Package's status says it was interrupted by a Ctrl-C
+   * 
+   * @param status > Wait status of the body (as returned by `system(...)`), -1 if it couldn't be run
+   * 
+   * @return `bool` - > Whether the body was killed by SIGINT or exited with 128 + SIGINT, as shells do after one
+  */
+  static
+  bool
+  interrupted_by(const int32_t status) {
+    if (status == -1)
+      return false;
+
+    #if defined(__unix__) || defined(__linux__)
+      return (WIFSIGNALED(status) && WTERMSIG(status) == SIGINT) || (WIFEXITED(status) && WEXITSTATUS(status) == 128 + SIGINT);
+    #else
+      // `system(...)` returns the exit code itself, STATUS_CONTROL_C_EXIT when the console killed it
+      return status == 128 + SIGINT || status == SIGINT || (uint32_t)status == 0xC000013AU;
+    #endif
+  }
+
+  #if defined(__unix__) || defined(__linux__)
+
+    /**
+     * @author https://github.com/SigmaEG/Arcus
+     * @brief Computes the size of a file, or of every file beneath a directory
+     * 
+     * @param path > File or directory to measure
+     * 
+     * @return `int64_t` - > Size in bytes (0 if the path can't be `stat`'d)
+    */
+    static
+    int64_t
+    tree_size(const char* path) {
+      struct stat info;
+
+      if (lstat(path, &info) != 0)
+        return 0;
+
+      if (!S_ISDIR(info.st_mode))
+        return (int64_t)info.st_size;
+
+      DIR* dir = opendir(path);
+
+      if (dir == NULL)
+        return 0;
+
+      int64_t total = 0;
+      struct dirent* entry = NULL;
+      char child[ARCUS_PATH_MAX];
+
+      while ((entry = readdir(dir)) != NULL) {
+        if (strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0)
+          continue;
+
+        snprintf(child, sizeof(child), "%s/%s", path, entry->d_name);
+        total += tree_size(child);
+      }
+
+      closedir(dir);
+
+      return total;
+    }
+
+    /**
+     * @author https://github.com/SigmaEG/Arcus
+     * @brief Removes a file, or a directory and everything beneath it
+     * 
+     * @param path > File or directory to remove
+     * 
+     * @return `bool` - > Whether `path` was removed
+    */
+    static
+    bool
+    remove_tree(const char* path) {
+      struct stat info;
+
+      if (lstat(path, &info) != 0)
+        return false;
+
+      if (!S_ISDIR(info.st_mode))
+        return unlink(path) == 0;
+
+      DIR* dir = opendir(path);
+
+      if (dir != NULL) {
+        struct dirent* entry = NULL;
+        char child[ARCUS_PATH_MAX];
+
+        while ((entry = readdir(dir)) != NULL) {
+          if (strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0)
+            continue;
+
+          snprintf(child, sizeof(child), "%s/%s", path, entry->d_name);
+          remove_tree(child);
+        }
+
+        closedir(dir);
+      }
+
+      return rmdir(path) == 0;
+    }
+
+    /**
+     * @author https://github.com/SigmaEG/Arcus
+     * @brief Replaces every character that isn't safe in a file name with `_`
+     * 
+     * @param name > String to sanitize in place
+     * 
+     * @return `void`
+    */
+    static
+    void
+    sanitize_file_name(char* name) {
+      for (char* cursor = name; *cursor != '\0'; ++cursor) {
+        if (!isalnum((unsigned char)*cursor) && *cursor != '.' && *cursor != '_' && *cursor != '-')
+          *cursor = '_';
+      }
+    }
+
+    /**
+     * @author https://github.com/SigmaEG/Arcus
+     * @brief Writes an entire buffer to a file descriptor, retrying on partial writes
+     * 
+     * @param fd > File descriptor to write to
+     * @param buffer > Data to write
+     * @param length > Amount of bytes in `buffer`
+     * 
+     * @return `bool` - > Whether every byte was written
+    */
+    static
+    bool
+    write_all(
+      const int32_t fd,
+      const char* buffer,
+      size_t length
+    ) {
+      while (length > 0) {
+        ssize_t written = write(fd, buffer, length);
+
+        if (written < 0) {
+          if (errno == EINTR)
+            continue;
+
+          return false;
+        }
+
+        buffer += written;
+        length -= (size_t)written;
+      }
+
+      return true;
+    }
+
+    /**
+     * @author https://github.com/SigmaEG/Arcus
+     * @brief Copies up to `length` bytes between file descriptors through user space
+     * 
+     * @param in_fd > File descriptor to read from
+     * @param out_fd > File descriptor to write to (written data is discarded if negative)
+     * @param length > Amount of bytes to copy, or -1 to copy until end-of-file
+     * 
+     * @return `void`
+    */
+    static
+    void
+    copy_fd(
+      const int32_t in_fd,
+      const int32_t out_fd,
+      int64_t length
+    ) {
+      static char buffer[ARCUS_RELAY_CHUNK];
+
+      while (length != 0) {
+        size_t chunk = length < 0 || length > (int64_t)sizeof(buffer) ? sizeof(buffer) : (size_t)length;
+        ssize_t n_read = read(in_fd, buffer, chunk);
+
+        if (n_read < 0 && errno == EINTR)
+          continue;
+
+        if (n_read <= 0)
+          break;
+
+        if (out_fd >= 0)
+          write_all(out_fd, buffer, (size_t)n_read);
+
+        if (length > 0)
+          length -= n_read;
+      }
+    }
+
+    #if defined(__linux__)
+
+      /**
+       * @author https://github.com/SigmaEG/Arcus
+       * @brief Moves `length` bytes out of a pipe with `splice(...)`, without copying them through user space
+       * 
+       * @param in_fd > Pipe to move data out of
+       * @param out_fd > File descriptor to move data into
+       * @param length > Amount of bytes to move
+       * 
+       * @return `int64_t` - > Amount of bytes moved (less than `length` if `out_fd` doesn't support splicing)
+      */
+      static
+      int64_t
+      splice_all(
+        const int32_t in_fd,
+        const int32_t out_fd,
+        const int64_t length
+      ) {
+        int64_t moved = 0;
+
+        while (moved < length) {
+          ssize_t n_moved = splice(in_fd, NULL, out_fd, NULL, (size_t)(length - moved), SPLICE_F_MOVE);
+
+          if (n_moved < 0 && errno == EINTR)
+            continue;
+
+          if (n_moved <= 0)
+            break;
+
+          moved += n_moved;
+        }
+
+        return moved;
+      }
+
+    #endif
+
+    /**
+     * @author https://github.com/SigmaEG/Arcus
+     * @brief Relays a child's output pipe into both a log file and the terminal until end-of-file
+     * 
+     * @param in_fd > Read end of the child's output pipe
+     * @param log_fd > Log file receiving the output
+     * @param term_fd > Terminal (or whatever stdout is) receiving the output
+     * 
+     * @return `void`
+     * @note On Linux the pipe is duplicated with `tee(...)` and both copies are `splice(...)`'d, so the data never enters user space unless the terminal can't be spliced into.
+    */
+    static
+    void
+    relay_output(
+      const int32_t in_fd,
+      const int32_t log_fd,
+      const int32_t term_fd
+    ) {
+      #if defined(__linux__)
+        int32_t dup_fds[2];
+
+        if (pipe(dup_fds) == 0) {
+          bool term_splice = true;
+
+          for (;;) {
+            ssize_t n_teed = tee(in_fd, dup_fds[1], ARCUS_RELAY_CHUNK, 0);
+
+            if (n_teed < 0 && errno == EINTR)
+              continue;
+
+            if (n_teed <= 0)
+              break;
+
+            int64_t logged = splice_all(in_fd, log_fd, n_teed);
+
+            if (logged < n_teed)
+              copy_fd(in_fd, log_fd, n_teed - logged);
+
+            int64_t shown = term_splice ? splice_all(dup_fds[0], term_fd, n_teed) : 0;
+
+            if (shown < n_teed) {
+              term_splice = false;
+              copy_fd(dup_fds[0], term_fd, n_teed - shown);
+            }
+          }
+
+          close(dup_fds[0]);
+          close(dup_fds[1]);
+        }
+      #endif
+
+      static char buffer[ARCUS_RELAY_CHUNK];
+      ssize_t n_read = 0;
+
+      while ((n_read = read(in_fd, buffer, sizeof(buffer))) != 0) {
+        if (n_read < 0) {
+          if (errno == EINTR)
+            continue;
+
+          break;
+        }
+
+        write_all(log_fd, buffer, (size_t)n_read);
+        write_all(term_fd, buffer, (size_t)n_read);
+      }
+    }
+
+    /**
+     * @author https://github.com/SigmaEG/Arcus
+     * @brief Writes a value to a cgroup interface file
+     * 
+     * @param cgroup > cgroup directory
+     * @param file > Interface file, e.g. `memory.max`
+     * @param value > Value to write
+     * 
+     * @return `bool` - > Whether the kernel accepted the value
+    */
+    static
+    bool
+    write_cgroup_file(
+      const char* cgroup,
+      const char* file,
+      const char* value
+    ) {
+      char path[ARCUS_PATH_MAX + 64];
+
+      snprintf(path, sizeof(path), "%s/%s", cgroup, file);
+
+      int32_t fd = open(path, O_WRONLY);
+
+      if (fd < 0)
+        return false;
+
+      bool written = write_all(fd, value, strlen(value));
+
+      return close(fd) == 0 && written;
+    }
+
+    /**
+     * @author https://github.com/SigmaEG/Arcus
+     * @brief Reads a number from a cgroup interface file
+     * 
+     * @param cgroup > cgroup directory
+     * @param file > Interface file, e.g. `memory.peak`
+     * @param key > Key of a flat-keyed file (e.g. `usage_usec` in `cpu.stat`), NULL for a single-value file
+     * @param value_out > Receives the value
+     * 
+     * @return `bool` - > Whether the value was found
+    */
+    static
+    bool
+    read_cgroup_value(
+      const char* cgroup,
+      const char* file,
+      const char* key,
+      int64_t* value_out
+    ) {
+      char path[ARCUS_PATH_MAX + 64];
+      char contents[1024];
+
+      snprintf(path, sizeof(path), "%s/%s", cgroup, file);
+
+      int32_t fd = open(path, O_RDONLY);
+
+      if (fd < 0)
+        return false;
+
+      ssize_t n_read = read(fd, contents, sizeof(contents) - 1);
+
+      close(fd);
+
+      if (n_read <= 0)
+        return false;
+
+      contents[n_read] = '\0';
+
+      const char* cursor = contents;
+      size_t key_len = key != NULL ? strlen(key) : 0;
+
+      while (key != NULL && cursor != NULL && (strncmp(cursor, key, key_len) != 0 || cursor[key_len] != ' ')) {
+        cursor = strchr(cursor, '\n');
+
+        if (cursor != NULL)
+          ++cursor;
+      }
+
+      if (cursor == NULL)
+        return false;
+
+      char* end = NULL;
+      long long value = strtoll(cursor + key_len, &end, 10);
+
+      if (end == cursor + key_len)
+        return false;
+
+      *value_out = (int64_t)value;
+
+      return true;
+    }
+
+    /**
+     * @author https://github.com/SigmaEG/Arcus
+     * @brief Reads the cgroup v2 path of a process
+     * 
+     * @param pid > Process to look up
+     * @param path_out > Receives the path relative to `ARCUS_CGROUP_ROOT`, e.g. `/system.slice/arcus.scope`
+     * @param size > Size of `path_out`
+     * 
+     * @return `bool` - > Whether the process is in a cgroup v2 hierarchy
+    */
+    static
+    bool
+    process_cgroup(
+      const pid_t pid,
+      char* path_out,
+      const size_t size
+    ) {
+      char path[64];
+      char line[ARCUS_PATH_MAX];
+      bool found = false;
+
+      snprintf(path, sizeof(path), "/proc/%ld/cgroup", (long)pid);
+
+      FILE* cgroups = fopen(path, "r");
+
+      // cgroup v2 is the `0::<path>` line
+      while (!found && cgroups != NULL && fgets(line, sizeof(line), cgroups) != NULL) {
+        line[strcspn(line, "\n")] = '\0';
+
+        if (strncmp(line, "0::/", 4) == 0 && strstr(line, "..") == NULL && strlen(line + 3) < size) {
+          memcpy(path_out, line + 3, strlen(line + 3) + 1);
+          found = true;
+        }
+      }
+
+      if (cgroups != NULL)
+        fclose(cgroups);
+
+      return found;
+    }
+
+    /**
+     * @author https://github.com/SigmaEG/Arcus
+     * @brief Finds the cgroup the per-Package cgroups of a process belong in: its own, or the parent of the `ARCUS_CGROUP_DIR` leaf Arcus moved it into
+     * 
+     * @param pid > Process to look up
+     * @param base_out > Receives the path relative to `ARCUS_CGROUP_ROOT`
+     * @param size > Size of `base_out`
+     * 
+     * @return `bool` - > Whether the process is in a cgroup v2 hierarchy
+    */
+    static
+    bool
+    arcus_cgroup_base(
+      const pid_t pid,
+      char* base_out,
+      const size_t size
+    ) {
+      if (!process_cgroup(pid, base_out, size))
+        return false;
+
+      size_t base_len = strlen(base_out);
+      size_t leaf_len = strlen("/" ARCUS_CGROUP_DIR);
+
+      if (base_len >= leaf_len && strcmp(base_out + base_len - leaf_len, "/" ARCUS_CGROUP_DIR) == 0)
+        base_out[base_len - leaf_len] = '\0';
+
+      return true;
+    }
+
+    /**
+     * @author https://github.com/SigmaEG/Arcus
+     * @brief Prepares the cgroup Arcus was started in (`cgroup_parent`) to hold per-Package cgroups, once per process
+     * 
+     * @return `bool` - > Whether per-Package cgroups can be created
+     * @note Arcus moves itself into the `ARCUS_CGROUP_DIR` leaf of its cgroup, as only a cgroup without processes of its own can enable controllers for its children, then enables the cpu and memory controllers delegated to it. It never touches the root of the hierarchy.
+     * @note Warns once when cgroup v2 isn't mounted at `ARCUS_CGROUP_ROOT`, Arcus runs in the root cgroup, its cgroup isn't delegated or a controller isn't, `cpu.max`/`memory.max` are then not enforced
+    */
+    static
+    bool
+    cgroups_ready(void) {
+      if (cgroup_state != 0)
+        return cgroup_state > 0;
+
+      static const char* const controllers[] = { "cpu", "memory", NULL };
+
+      char base[ARCUS_PATH_MAX - 64];
+      char leaf[ARCUS_PATH_MAX + 16];
+      char available[512] = " ";
+      bool enabled = false;
+
+      cgroup_state = -1;
+
+      if (!pathexists(ARCUS_CGROUP_ROOT "/cgroup.controllers") || !arcus_cgroup_base(getpid(), base, sizeof(base))) {
+        fprintf(stderr, "%s< CGROUP V2 IS NOT MOUNTED AT %s, cpu.max AND memory.max ARE NOT ENFORCED >\n", KYEL, ARCUS_CGROUP_ROOT);
+
+        return false;
+      }
+
+      // The root belongs to the init system, per-Package cgroups only go below a cgroup delegated to Arcus
+      if (base[0] == '\0' || strcmp(base, "/") == 0) {
+        fprintf(stderr, "%s< ARCUS RUNS IN THE ROOT CGROUP, START IT WITH systemd-run --scope -p Delegate=yes TO ENFORCE cpu.max AND memory.max >\n", KYEL);
+
+        return false;
+      }
+
+      snprintf(cgroup_parent, sizeof(cgroup_parent), ARCUS_CGROUP_ROOT "%s", base);
+      snprintf(leaf, sizeof(leaf), "%s/" ARCUS_CGROUP_DIR, cgroup_parent);
+
+      if (
+        access(cgroup_parent, W_OK) != 0 ||
+        (mkdir(leaf, 0755) != 0 && errno != EEXIST) ||
+        !write_cgroup_file(leaf, "cgroup.procs", "0")
+      ) {
+        fprintf(stderr, "%s< CGROUP %s IS NOT DELEGATED TO ARCUS, START IT WITH systemd-run --scope -p Delegate=yes TO ENFORCE cpu.max AND memory.max >\n", KYEL, cgroup_parent);
+        cgroup_parent[0] = '\0';
+
+        return false;
+      }
+
+      char controllers_path[ARCUS_PATH_MAX + 32];
+
+      snprintf(controllers_path, sizeof(controllers_path), "%s/cgroup.controllers", cgroup_parent);
+
+      int32_t fd = open(controllers_path, O_RDONLY);
+      ssize_t n_read = fd >= 0 ? read(fd, available + 1, sizeof(available) - 3) : -1;
+
+      if (fd >= 0)
+        close(fd);
+
+      if (n_read > 0) {
+        available[n_read + 1] = '\0';
+        available[strcspn(available, "\n")] = '\0';
+        strcat(available, " ");
+      }
+
+      // Each controller is optional, a Package whose setting can't be applied is reported when its cgroup is created
+      for (int32_t controller_idx = 0; controllers[controller_idx] != NULL; ++controller_idx) {
+        char word[32];
+
+        snprintf(word, sizeof(word), " %s ", controllers[controller_idx]);
+
+        if (strstr(available, word) == NULL) {
+          fprintf(stderr, "%s< THE %s CONTROLLER IS NOT DELEGATED TO %s, %s.max IS NOT ENFORCED >\n", KYEL, controllers[controller_idx], cgroup_parent, controllers[controller_idx]);
+
+          continue;
+        }
+
+        snprintf(word, sizeof(word), "+%s", controllers[controller_idx]);
+
+        // Fails whilst other processes (e.g. the shell Arcus was started from) share its cgroup
+        if (!write_cgroup_file(cgroup_parent, "cgroup.subtree_control", word)) {
+          fprintf(stderr, "%s< FAILED TO ENABLE THE %s CONTROLLER IN %s (%s), %s.max IS NOT ENFORCED >\n", KYEL, controllers[controller_idx], cgroup_parent, strerror(errno), controllers[controller_idx]);
+
+          continue;
+        }
+
+        enabled = true;
+      }
+
+      if (!enabled) {
+        cgroup_parent[0] = '\0';
+
+        return false;
+      }
+
+      cgroup_state = 1;
+
+      return true;
+    }
+
+    /**
+     * @author https://github.com/SigmaEG/Arcus
+     * @brief Applies the resource budget of a Package to the calling (forked) process before it execs the body
+     * 
+     * @param pkg_idx > Index of the Package in `packages`
+     * 
+     * @return `void`
+     * @note A budget that can't be applied fails the Package (exit status 126) rather than running it unconstrained
+    */
+    static
+    void
+    apply_limits(const int32_t pkg_idx) {
+      if (package_limits == NULL || pkg_idx < 0 || !package_limits[pkg_idx].active)
+        return;
+
+      const arcus_limits_t* limits = &package_limits[pkg_idx];
+      const char* failed = NULL;
+      struct rlimit limit;
+
+      if (package_cgroup[0] != '\0' && !write_cgroup_file(package_cgroup, "cgroup.procs", "0"))
+        failed = "cgroup";
+
+      if (failed == NULL && limits->nice != ARCUS_LIMIT_UNSET && setpriority(PRIO_PROCESS, 0, limits->nice) != 0)
+        failed = "nice";
+
+      if (failed == NULL && limits->io_class != ARCUS_LIMIT_UNSET) {
+        #if defined(__linux__)
+          // IOPRIO_WHO_PROCESS, class in the bits above IOPRIO_CLASS_SHIFT (13)
+          if (syscall(SYS_ioprio_set, 1, 0, (limits->io_class << 13) | limits->io_level) != 0)
+            failed = "ionice";
+        #else
+          errno = ENOSYS;
+          failed = "ionice";
+        #endif
+      }
+
+      if (failed == NULL && limits->address_space != ARCUS_LIMIT_UNSET) {
+        limit.rlim_cur = limit.rlim_max = (rlim_t)limits->address_space;
+
+        if (setrlimit(RLIMIT_AS, &limit) != 0)
+          failed = "as";
+      }
+
+      if (failed == NULL && limits->processes != ARCUS_LIMIT_UNSET) {
+        #if defined(RLIMIT_NPROC)
+          limit.rlim_cur = limit.rlim_max = (rlim_t)limits->processes;
+
+          if (setrlimit(RLIMIT_NPROC, &limit) != 0)
+            failed = "nproc";
+        #else
+          errno = ENOSYS;
+          failed = "nproc";
+        #endif
+      }
+
+      if (failed == NULL && limits->cpu_seconds != ARCUS_LIMIT_UNSET) {
+        // SIGXCPU at the soft limit, SIGKILL a second later if it's ignored
+        limit.rlim_cur = (rlim_t)limits->cpu_seconds;
+        limit.rlim_max = (rlim_t)limits->cpu_seconds + 1;
+
+        if (setrlimit(RLIMIT_CPU, &limit) != 0)
+          failed = "cpu";
+      }
+
+      if (failed != NULL) {
+        fprintf(stderr, "< FAILED TO APPLY LIMIT %s : %s >\n", failed, strerror(errno));
+        _exit(126);
+      }
+    }
+
+    /**
+     * @author https://github.com/SigmaEG/Arcus
+     * @brief Reports the budget of a Package about to run and creates its cgroup when it has `cpu.max`/`memory.max`
+     * 
+     * @param pkg_idx > Index of the Package in `packages`
+     * @param usage_before > Receives the resource usage of reaped children so far
+     * 
+     * @return `void`
+     * @note The cgroup (`package_cgroup`) is joined by the body in `apply_limits(...)` and removed by `end_package_limits(...)`
+    */
+    static
+    void
+    begin_package_limits(
+      const int32_t pkg_idx,
+      struct rusage* usage_before
+    ) {
+      package_cgroup[0] = '\0';
+
+      if (package_limits == NULL || !package_limits[pkg_idx].active)
+        return;
+
+      const arcus_limits_t* limits = &package_limits[pkg_idx];
+      char description[256];
+
+      describe_limits(limits, description, sizeof(description));
+      printf("%s< LIMITS : %s%s%s >\n", KBLU, KMAG, description, KBLU);
+
+      getrusage(RUSAGE_CHILDREN, usage_before);
+
+      if ((limits->cpu_max_percent == ARCUS_LIMIT_UNSET && limits->memory_max == ARCUS_LIMIT_UNSET) || !cgroups_ready())
+        return;
+
+      char value[64];
+      bool created;
+
+      snprintf(package_cgroup, sizeof(package_cgroup), "%s/%ld-%03d", cgroup_parent, (long)getpid(), pkg_idx + 1);
+      created = mkdir(package_cgroup, 0755) == 0;
+
+      if (created && limits->cpu_max_percent != ARCUS_LIMIT_UNSET) {
+        snprintf(value, sizeof(value), "%lld 100000", (long long)limits->cpu_max_percent * 1000);
+        created = write_cgroup_file(package_cgroup, "cpu.max", value);
+      }
+
+      if (created && limits->memory_max != ARCUS_LIMIT_UNSET) {
+        snprintf(value, sizeof(value), "%lld", (long long)limits->memory_max);
+        created = write_cgroup_file(package_cgroup, "memory.max", value);
+      }
+
+      if (!created) {
+        fprintf(stderr, "%s< FAILED TO CREATE CGROUP, cpu.max AND memory.max ARE NOT ENFORCED : %s >\n", KYEL, package_cgroup);
+        rmdir(package_cgroup);
+        package_cgroup[0] = '\0';
+      }
+    }
+
+    /**
+     * @author https://github.com/SigmaEG/Arcus
+     * @brief Reports the resources a limited Package used and removes its cgroup
+     * 
+     * @param pkg_idx > Index of the Package in `packages`
+     * @param status > Wait status of the body
+     * @param usage_before > Resource usage of reaped children before the body ran
+     * 
+     * @return `const char*` - > `CPU LIMIT` or `MEMORY LIMIT` when the body was killed by its budget, else NULL
+     * @note A SIGKILL only counts as `CPU LIMIT` if the CPU time used reached `cpu` and Arcus wasn't cancelling, so the SIGKILL of a cancellation isn't mistaken for one
+    */
+    static
+    const char*
+    end_package_limits(
+      const int32_t pkg_idx,
+      const int32_t status,
+      const struct rusage* usage_before
+    ) {
+      if (package_limits == NULL || !package_limits[pkg_idx].active)
+        return NULL;
+
+      const arcus_limits_t* limits = &package_limits[pkg_idx];
+      const char* reason = NULL;
+      struct rusage usage_after;
+      int64_t cpu_usec = 0;
+      int64_t memory_peak = -1;
+      int64_t oom_kills = 0;
+      char usage[128];
+
+      getrusage(RUSAGE_CHILDREN, &usage_after);
+      cpu_usec =
+        ((int64_t)usage_after.ru_utime.tv_sec - usage_before->ru_utime.tv_sec + usage_after.ru_stime.tv_sec - usage_before->ru_stime.tv_sec) * 1000000 +
+        (usage_after.ru_utime.tv_usec - usage_before->ru_utime.tv_usec) + (usage_after.ru_stime.tv_usec - usage_before->ru_stime.tv_usec);
+
+      if (package_cgroup[0] != '\0') {
+        read_cgroup_value(package_cgroup, "cpu.stat", "usage_usec", &cpu_usec);
+        read_cgroup_value(package_cgroup, "memory.peak", NULL, &memory_peak);
+        read_cgroup_value(package_cgroup, "memory.events", "oom_kill", &oom_kills);
+
+        if (rmdir(package_cgroup) != 0)
+          fprintf(stderr, "%s< CGROUP STILL HAS PROCESSES, LEFT IN PLACE : %s >\n", KYEL, package_cgroup);
+
+        package_cgroup[0] = '\0';
+      }
+
+      snprintf(usage, sizeof(usage), "%.2fs CPU", (double)cpu_usec / 1000000.0);
+
+      if (memory_peak >= 0) {
+        char size[32];
+
+        format_size(memory_peak, size, sizeof(size));
+        snprintf(usage + strlen(usage), sizeof(usage) - strlen(usage), ", %s peak memory", size);
+      }
+
+      printf("%s< USAGE : %s%s%s >\n", KBLU, KMAG, usage, KBLU);
+
+      // SIGXCPU only comes from RLIMIT_CPU, a SIGKILL (its hard limit) only counts once the body's own CPU time shows the limit was reached
+      bool cpu_signal = (WIFSIGNALED(status) && WTERMSIG(status) == SIGXCPU) || (WIFEXITED(status) && WEXITSTATUS(status) == 128 + SIGXCPU);
+      bool cpu_killed = WIFSIGNALED(status) && WTERMSIG(status) == SIGKILL && cancel_signal == 0 && cpu_usec >= limits->cpu_seconds * 1000000;
+
+      if (oom_kills > 0)
+        reason = "MEMORY LIMIT";
+      else if (limits->cpu_seconds != ARCUS_LIMIT_UNSET && (cpu_signal || cpu_killed))
+        reason = "CPU LIMIT";
+
+      return reason;
+    }
+
+    /**
+     * @author https://github.com/SigmaEG/Arcus
+     * @brief Picks the directory scratch workspaces are created in
+     * 
+     * @return `const char*` - > `$ARCUS_SCRATCH_DIR` if set, else the first of `/tmp` and `/dev/shm` that is a tmpfs with room for {--scratch-size MB}, else `/var/tmp`
+    */
+    static
+    const char*
+    scratch_base(void) {
+      const char* base = getenv("ARCUS_SCRATCH_DIR");
+
+      if (base != NULL && base[0] != '\0')
+        return base;
+
+      #if defined(__linux__)
+        const char* candidates[] = { "/tmp", "/dev/shm" };
+
+        for (size_t candidate_idx = 0; candidate_idx < sizeof(candidates) / sizeof(candidates[0]); ++candidate_idx) {
+          struct statfs info;
+
+          // TMPFS_MAGIC
+          if (statfs(candidates[candidate_idx], &info) == 0 && info.f_type == 0x01021994 && (int64_t)info.f_bavail * info.f_bsize >= scratch_max_bytes && access(candidates[candidate_idx], W_OK) == 0)
+            return candidates[candidate_idx];
+        }
+      #endif
+
+      return "/var/tmp";
+    }
+
+    /**
+     * @author https://github.com/SigmaEG/Arcus
+     * @brief Creates the scratch workspace of a Package about to run, when {--scratch} was specified
+     * 
+     * @param pkg_idx > Index of the Package in `packages`
+     * @param number > Number of the Package in this run, used in the directory name
+     * 
+     * @return `void`
+     * @note The workspace (`package_scratch`) is entered by the body in `spawn_package(...)` and torn down by `end_package_scratch(...)`. When Arcus runs as root it gets a tmpfs of its own capped at {--scratch-size MB}.
+    */
+    static
+    void
+    begin_package_scratch(
+      const int32_t pkg_idx,
+      const int32_t number
+    ) {
+      package_scratch[0] = '\0';
+      scratch_mounted = false;
+
+      if (scratch_max_bytes == 0)
+        return;
+
+      char name[128];
+
+      snprintf(name, sizeof(name), "%s", packages[pkg_idx][0]);
+      sanitize_file_name(name);
+      snprintf(package_scratch, sizeof(package_scratch), "%s/" ARCUS_SCRATCH_PREFIX "-%ld-%03d-%s.XXXXXX", scratch_base(), (long)getpid(), number, name);
+
+      if (mkdtemp(package_scratch) == NULL) {
+        fprintf(stderr, "%s< FAILED TO CREATE SCRATCH DIRECTORY : %s%s%s (%s) >\n", KRED, KMAG, package_scratch, KRED, strerror(errno));
+        package_scratch[0] = '\0';
+
+        return;
+      }
+
+      #if defined(__linux__)
+        if (geteuid() == 0) {
+          char options[64];
+
+          snprintf(options, sizeof(options), "size=%lldk,mode=0700", (long long)(scratch_max_bytes / 1024));
+          scratch_mounted = mount(ARCUS_SCRATCH_PREFIX, package_scratch, "tmpfs", MS_NOSUID | MS_NODEV, options) == 0;
+        }
+      #endif
+
+      printf("%s< SCRATCH DIRECTORY : %s%s%s >\n", KBLU, KMAG, package_scratch, KBLU);
+    }
+
+    /**
+     * @author https://github.com/SigmaEG/Arcus
+     * @brief Tears down the scratch workspace of a Package that finished, in the background
+     * 
+     * @param status > Wait status of the body
+     * 
+     * @return `void`
+     * @note With {--keep-scratch} the workspace of a Package that didn't succeed is left in place (and mounted) for debugging
+    */
+    static
+    void
+    end_package_scratch(const int32_t status) {
+      if (package_scratch[0] == '\0')
+        return;
+
+      if (status != 0 && keep_scratch) {
+        fprintf(stderr, "%s< KEPT SCRATCH DIRECTORY : %s%s%s >\n", KYEL, KMAG, package_scratch, KYEL);
+        package_scratch[0] = '\0';
+
+        return;
+      }
+
+      #if defined(__linux__)
+        // A lazy unmount frees the tmpfs as soon as nothing uses it, leaving an empty directory behind
+        if (scratch_mounted)
+          umount2(package_scratch, MNT_DETACH);
+      #endif
+
+      fflush(stdout);
+      fflush(stderr);
+
+      pid_t pid = fork();
+
+      // The remover is orphaned right away, so neither waiting on it nor a Ctrl-C holds up the next Package
+      if (pid == 0) {
+        if (fork() == 0) {
+          setsid();
+          remove_tree(package_scratch);
+        }
+
+        _exit(0);
+      }
+
+      if (pid > 0)
+        while (waitpid(pid, NULL, 0) < 0 && errno == EINTR);
+      else
+        remove_tree(package_scratch);
+
+      package_scratch[0] = '\0';
+    }
+
+    /**
+     * @author https://github.com/SigmaEG/Arcus
+     * @brief Signal handler forwarding SIGINT/SIGTERM to every active process group, and SIGKILL once the grace period (SIGALRM) expires
+     * 
+     * @param signal_num > Signal received
+     * @param info > Sender of the signal
+     * @param context > Unused
+     * 
+     * @return `void`
+     * @note A SIGINT relayed by the leader of a Package's group (see `relay_interrupt(...)`) isn't sent back to that group, the terminal already delivered it there
+    */
+    static
+    void
+    forward_cancel(
+      int32_t signal_num,
+      siginfo_t* info,
+      void* context
+    ) {
+      int32_t saved_errno = errno;
+      int32_t forwarded = signal_num == SIGALRM ? SIGKILL : signal_num;
+      pid_t relayed_by = signal_num == SIGINT && info != NULL && info->si_code == SI_USER ? info->si_pid : 0;
+
+      (void)context;
+
+      if (signal_num != SIGALRM && cancel_signal == 0) {
+        cancel_signal = signal_num;
+        alarm((uint32_t)cancel_grace);
+      }
+
+      for (int32_t group_idx = 0; active_groups != NULL && group_idx < n_active_groups; ++group_idx) {
+        if (active_groups[group_idx] > 0 && active_groups[group_idx] != relayed_by)
+          kill(-active_groups[group_idx], forwarded);
+      }
+
+      errno = saved_errno;
+    }
+
+    /**
+     * @author https://github.com/SigmaEG/Arcus
+     * @brief SIGINT handler of the process leading a Package's group, relaying a Ctrl-C aimed at the Package to Arcus
+     * 
+     * @param signal_num > Signal received
+     * 
+     * @return `void`
+    */
+    static
+    void
+    relay_interrupt(int32_t signal_num) {
+      int32_t saved_errno = errno;
+
+      (void)signal_num;
+
+      if (interrupt_target > 0)
+        kill(interrupt_target, SIGINT);
+
+      errno = saved_errno;
+    }
+
+    /**
+     * @author https://github.com/SigmaEG/Arcus
+     * @brief Installs `forward_cancel(...)` for SIGINT, SIGTERM and SIGALRM, without `SA_RESTART` so blocking waits return early
+     * 
+     * @return `void`
+    */
+    static
+    void
+    install_cancel_handlers(void) {
+      struct sigaction action;
+
+      memset(&action, 0, sizeof(action));
+      action.sa_sigaction = forward_cancel;
+      action.sa_flags = SA_SIGINFO;
+      sigemptyset(&action.sa_mask);
+
+      sigaction(SIGINT, &action, NULL);
+      sigaction(SIGTERM, &action, NULL);
+      sigaction(SIGALRM, &action, NULL);
+    }
+
+    /**
+     * @author https://github.com/SigmaEG/Arcus
+     * @brief Starts a Package body under `/bin/sh -c` in its own process group, handing it the terminal whilst Arcus owns it
+     * 
+     * @param pkg_idx > Index of the Package in `packages`, its budget is applied before the body runs (-1 for commands that aren't a Package)
+     * @param body > Commands to run
+     * @param out_fd > Descriptor to redirect stdout and stderr to, or -1 to inherit them
+     * @param group > Slot registered in `active_groups`, receives the process group ID
+     * @param foreground_out > Whether the terminal was handed to the body, to be passed to `wait_package(...)`
+     * 
+     * @return `pid_t` - > Process (and process group) ID of the body, -1 if it couldn't be started
+     * @note A body handed the terminal runs under a small Arcus process leading its group, which sees a Ctrl-C even if the body traps it and relays it to Arcus, so the run stops
+    */
+    static
+    pid_t
+    spawn_package(
+      const int32_t pkg_idx,
+      const char* body,
+      const int32_t out_fd,
+      pid_t* group,
+      bool* foreground_out
+    ) {
+      bool foreground = isatty(STDIN_FILENO) && tcgetpgrp(STDIN_FILENO) == getpgrp();
+      pid_t installer = getpid();
+
+      fflush(stdout);
+      fflush(stderr);
+
+      pid_t pid = fork();
+
+      if (pid == 0) {
+        setpgid(0, 0);
+
+        if (foreground) {
+          signal(SIGTTOU, SIG_IGN);
+          tcsetpgrp(STDIN_FILENO, getpid());
+          signal(SIGTTOU, SIG_DFL);
+        }
+
+        if (out_fd >= 0) {
+          dup2(out_fd, STDOUT_FILENO);
+          dup2(out_fd, STDERR_FILENO);
+          close(out_fd);
+        }
+
+        apply_limits(pkg_idx);
+
+        if (pkg_idx >= 0 && scratch_max_bytes > 0) {
+          char cwd[ARCUS_PATH_MAX];
+
+          if (getcwd(cwd, sizeof(cwd)) != NULL)
+            setenv("ARCUS_CWD", cwd, 1);
+
+          // Like a budget, a workspace that can't be entered fails the Package rather than building in the working directory
+          if (package_scratch[0] == '\0' || chdir(package_scratch) != 0) {
+            fprintf(stderr, "< FAILED TO ENTER SCRATCH DIRECTORY : %s >\n", package_scratch);
+            _exit(126);
+          }
+        }
+
+        // Ctrl-C only reaches the foreground group, which Arcus left, so this process stays in it and reports back
+        pid_t body_pid = foreground ? fork() : 0;
+
+        if (body_pid > 0) {
+          struct sigaction action;
+          int32_t status = 0;
+
+          memset(&action, 0, sizeof(action));
+          action.sa_handler = relay_interrupt;
+          sigemptyset(&action.sa_mask);
+          interrupt_target = installer;
+          sigaction(SIGINT, &action, NULL);
+          signal(SIGTERM, SIG_DFL);
+          signal(SIGALRM, SIG_DFL);
+
+          while (waitpid(body_pid, &status, 0) < 0 && errno == EINTR);
+
+          // The body's wait status is passed on unchanged, signals included
+          if (WIFSIGNALED(status)) {
+            signal(WTERMSIG(status), SIG_DFL);
+            raise(WTERMSIG(status));
+          }
+
+          _exit(WIFEXITED(status) ? WEXITSTATUS(status) : 1);
+        }
+
+        execl("/bin/sh", "sh", "-c", body, (char*)NULL);
+        _exit(127);
+      }
+
+      *foreground_out = false;
+
+      if (pid < 0)
+        return -1;
+
+      // Both sides set the group, whichever runs first, so a signal can never miss the body
+      setpgid(pid, pid);
+      *group = pid;
+
+      if (foreground)
+        *foreground_out = tcsetpgrp(STDIN_FILENO, pid) == 0;
+
+      if (cancel_signal != 0)
+        kill(-pid, cancel_signal);
+
+      return pid;
+    }
+
+    /**
+     * @author https://github.com/SigmaEG/Arcus
+     * @brief Waits for a Package started by `spawn_package(...)` and takes the terminal back
+     * 
+     * @param pid > Process (and process group) ID of the body
+     * @param group > Slot registered in `active_groups`, cleared once the group is gone
+     * @param foreground > Whether the terminal was handed to the body
+     * 
+     * @return `int32_t` - > Wait status of the body, as returned by `system(...)`
+     * @note When cancelling, processes the body left behind in its group get the rest of the grace period before being killed
+    */
+    static
+    int32_t
+    wait_package(
+      const pid_t pid,
+      pid_t* group,
+      const bool foreground
+    ) {
+      int32_t status = -1;
+
+      while (waitpid(pid, &status, 0) < 0 && errno == EINTR);
+
+      if (cancel_signal != 0) {
+        struct timespec tick = { 0, 100000000 };
+
+        for (int32_t tick_idx = 0; kill(-pid, 0) == 0 && tick_idx < (cancel_grace + 1) * 10; ++tick_idx)
+          nanosleep(&tick, NULL);
+
+        kill(-pid, SIGKILL);
+      }
+
+      *group = 0;
+
+      if (foreground) {
+        struct sigaction ignore_action;
+        struct sigaction old_ttou;
+
+        memset(&ignore_action, 0, sizeof(ignore_action));
+        ignore_action.sa_handler = SIG_IGN;
+        sigemptyset(&ignore_action.sa_mask);
+
+        sigaction(SIGTTOU, &ignore_action, &old_ttou);
+        tcsetpgrp(STDIN_FILENO, getpgrp());
+        sigaction(SIGTTOU, &old_ttou, NULL);
+      }
+
+      return status;
+    }
+
+    /**
+     * @author https://github.com/SigmaEG/Arcus
+     * @brief Runs a Package body like `system(...)`, capturing its stdout and stderr into `log_run_dir/<NNN>-<package>.log`
+     * 
+     * @param pkg_idx > Index of the Package in `packages`
+     * @param log_number > Position of the Package in the run, used as the `<NNN>` of its log
+     * @param pkg_name > Name (header) of the Package
+     * @param body > Commands to run
+     * @param group > Slot registered in `active_groups`, see `spawn_package(...)`
+     * 
+     * @return `int32_t` - > Wait status of the body, as returned by `system(...)`
+    */
+    static
+    int32_t
+    run_captured(
+      const int32_t pkg_idx,
+      const int32_t log_number,
+      const char* pkg_name,
+      const char* body,
+      pid_t* group
+    ) {
+      char log_path[ARCUS_PATH_MAX + 32];
+      size_t run_dir_len = strlen(log_run_dir);
+
+      snprintf(log_path, sizeof(log_path), "%s/%03d-%s.log", log_run_dir, log_number, pkg_name);
+      sanitize_file_name(log_path + run_dir_len + 1);
+
+      int32_t log_fd = open(log_path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+      int32_t fds[2];
+      bool foreground = false;
+
+      if (log_fd < 0 || pipe(fds) != 0) {
+        fprintf(stderr, "%s< FAILED TO OPEN PACKAGE LOG : %s >\n", KRED, log_path);
+
+        if (log_fd >= 0)
+          close(log_fd);
+
+        pid_t pid = spawn_package(pkg_idx, body, -1, group, &foreground);
+
+        return pid < 0 ? -1 : wait_package(pid, group, foreground);
+      }
+
+      fcntl(log_fd, F_SETFD, FD_CLOEXEC);
+      fcntl(fds[0], F_SETFD, FD_CLOEXEC);
+
+      pid_t pid = spawn_package(pkg_idx, body, fds[1], group, &foreground);
+
+      close(fds[1]);
+
+      int32_t status = -1;
+
+      if (pid > 0) {
+        // Relaying ends once the body closes its output, so the time spent in it counts as waiting on the body
+        int64_t start_ns = stats.enabled ? stats_now_ns() : 0;
+
+        relay_output(fds[0], log_fd, STDOUT_FILENO);
+
+        if (stats.enabled)
+          stats.child_wait_ns += stats_now_ns() - start_ns;
+
+        status = wait_package(pid, group, foreground);
+      }
+
+      close(fds[0]);
+      close(log_fd);
+
+      return status;
+    }
+
+    /**
+     * @author https://github.com/SigmaEG/Arcus
+     * @brief Finds the end of the shell command starting at `cursor`
+     * 
+     * @param cursor > Start of the command inside a Package body
+     * 
+     * @return `const char*` - > The next `;`, `&`, `|`, newline or null-terminator
+    */
+    static
+    const char*
+    command_end(const char* cursor) {
+      while (*cursor != '\0' && *cursor != ';' && *cursor != '&' && *cursor != '|' && *cursor != '\n')
+        ++cursor;
+
+      return cursor;
+    }
+
+    /**
+     * @author https://github.com/SigmaEG/Arcus
+     * @brief Extracts the repository URL of the first `git clone` in a Package body
+     * 
+     * @param body > Commands of the Package
+     * 
+     * @return `char*` - > The URL, to be `free(...)`'d by the caller, or NULL if there is none
+    */
+    static
+    char*
+    git_clone_url(const char* body) {
+      const char* cursor = strstr(body, "git clone ");
+
+      if (cursor == NULL)
+        return NULL;
+
+      cursor += strlen("git clone ");
+
+      const char* end = command_end(cursor);
+
+      while (cursor < end) {
+        while (cursor < end && *cursor == ' ')
+          ++cursor;
+
+        const char* token_end = cursor;
+
+        while (token_end < end && *token_end != ' ')
+          ++token_end;
+
+        size_t token_len = (size_t)(token_end - cursor);
+
+        if (token_len > 0 && *cursor != '-' && memchr(cursor, '\'', token_len) == NULL) {
+          bool is_url = (token_len > 4 && strncmp(cursor, "git@", 4) == 0);
+
+          for (size_t idx = 0; idx + 3 <= token_len && !is_url; ++idx)
+            is_url = strncmp(cursor + idx, "://", 3) == 0;
+
+          if (is_url) {
+            char* url = (char*)calloc(token_len + 1, sizeof(char));
+
+            if (url != NULL)
+              memcpy(url, cursor, token_len);
+
+            return url;
+          }
+        }
+
+        cursor = token_end;
+      }
+
+      return NULL;
+    }
+
+    /**
+     * @author https://github.com/SigmaEG/Arcus
+     * @brief Builds the absolute path of the bare mirror caching a git repository
+     * 
+     * @param url > Repository URL
+     * @param path_out > Receives `<cwd>/ARCUS_CACHE_DIR/git/<url>(.git)`
+     * @param path_size > Size of `path_out`
+     * 
+     * @return `bool` - > Whether the path could be built
+    */
+    static
+    bool
+    git_mirror_path(
+      const char* url,
+      char* path_out,
+      const size_t path_size
+    ) {
+      char cwd[ARCUS_PATH_MAX];
+      char name[256];
+
+      if (getcwd(cwd, sizeof(cwd)) == NULL || strchr(cwd, '\'') != NULL)
+        return false;
+
+      snprintf(name, sizeof(name), "%s", url);
+      sanitize_file_name(name);
+
+      size_t name_len = strlen(name);
+      const char* suffix = name_len > 4 && strcmp(name + name_len - 4, ".git") == 0 ? "" : ".git";
+
+      return snprintf(path_out, path_size, "%s/" ARCUS_CACHE_DIR "/git/%s%s", cwd, name, suffix) < (int32_t)path_size;
+    }
+
+    /**
+     * @author https://github.com/SigmaEG/Arcus
+     * @brief Builds the command that creates or incrementally fetches the bare mirror of a git repository
+     * 
+     * @param url > Repository URL
+     * @param mirror > Path of the mirror, as built by `git_mirror_path(...)`
+     * 
+     * @return `char*` - > The command, to be `free(...)`'d by the caller
+    */
+    static
+    char*
+    git_mirror_command(
+      const char* url,
+      const char* mirror
+    ) {
+      const char* format =
+        "mkdir -p '%.*s' && if [ -d '%s' ]; then git --git-dir='%s' fetch --quiet --prune; "
+        "else git clone --quiet --mirror '%s' '%s'; fi";
+      int32_t dir_len = (int32_t)(strrchr(mirror, '/') - mirror);
+      size_t command_len = strlen(format) + 4 * strlen(mirror) + strlen(url) + 1;
+      char* command = (char*)calloc(command_len, sizeof(char));
+
+      if (command != NULL)
+        snprintf(command, command_len, format, dir_len, mirror, mirror, mirror, url, mirror);
+
+      return command;
+    }
+
+    /**
+     * @author https://github.com/SigmaEG/Arcus
+     * @brief Takes the lock guarding a bare mirror, creating `ARCUS_CACHE_DIR/git` if needed
+     * 
+     * @param mirror > Path of the mirror, as built by `git_mirror_path(...)`
+     * @param operation > `LOCK_EX` to create or fetch the mirror, `LOCK_SH` to clone from it
+     * 
+     * @return `int32_t` - > Close-on-exec descriptor holding the lock until it is `close(...)`'d, or -1 on failure
+     * @note Blocks whilst another Arcus process (e.g another root, a prefetch or a second installation) holds a conflicting lock, unless cancelled
+    */
+    static
+    int32_t
+    lock_git_mirror(
+      const char* mirror,
+      const int32_t operation
+    ) {
+      char lock_path[ARCUS_PATH_MAX + 8];
+
+      mkdir(ARCUS_CACHE_DIR, 0755);
+      mkdir(ARCUS_CACHE_DIR "/git", 0755);
+      snprintf(lock_path, sizeof(lock_path), "%s.lock", mirror);
+
+      int32_t fd = open(lock_path, O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+
+      if (fd < 0)
+        return -1;
+
+      while (flock(fd, operation) != 0) {
+        if (errno != EINTR || cancel_signal != 0) {
+          close(fd);
+
+          return -1;
+        }
+      }
+
+      return fd;
+    }
+
+    /**
+     * @author https://github.com/SigmaEG/Arcus
+     * @brief Rewrites the first `git clone` of a Package body to borrow objects from a bare mirror
+     * 
+     * @param body > Commands of the Package
+     * @param mirror > Path of the mirror, as built by `git_mirror_path(...)`
+     * 
+     * @return `char*` - > The body with `git clone --reference-if-able '<mirror>' --dissociate ...`, to be `free(...)`'d by the caller, or NULL if it has no `git clone`
+     * @note `--dissociate` copies the borrowed objects once the clone is done, so the clone keeps working if `ARCUS_CACHE_DIR` is removed
+    */
+    static
+    char*
+    git_reference_body(
+      const char* body,
+      const char* mirror
+    ) {
+      const char* clone = strstr(body, "git clone ");
+
+      if (clone == NULL)
+        return NULL;
+
+      int32_t prefix_len = (int32_t)(clone - body) + (int32_t)strlen("git clone ");
+      size_t body_len = strlen(body) + strlen(mirror) + 48;
+      char* cached = (char*)calloc(body_len, sizeof(char));
+
+      if (cached != NULL)
+        snprintf(cached, body_len, "%.*s--reference-if-able '%s' --dissociate %s", prefix_len, body, mirror, body + prefix_len);
+
+      return cached;
+    }
+
+    /**
+     * @author https://github.com/SigmaEG/Arcus
+     * @brief Brings the mirror of a `git clone` Package up to date and rewrites its clone to use it, unless {--no-git-cache} was specified
+     * 
+     * @param body > Commands of the Package
+     * @param fresh > Whether a prefetch already fetched the mirror
+     * @param group > Slot registered in `active_groups`, see `spawn_package(...)`
+     * @param body_out > Receives the body to run instead, to be `free(...)`'d by the caller, or NULL to run `body` unchanged
+     * 
+     * @return `int32_t` - > Descriptor holding a shared lock on the mirror, to be `close(...)`'d once the body finished, or -1 if `body_out` is NULL
+     * @note If the mirror can't be fetched (e.g offline with no mirror yet) the body runs unchanged
+    */
+    static
+    int32_t
+    begin_git_cache(
+      const char* body,
+      const bool fresh,
+      pid_t* group,
+      char** body_out
+    ) {
+      char mirror[ARCUS_PATH_MAX];
+      char* url = NULL;
+
+      *body_out = NULL;
+
+      if (no_git_cache || package_manager(body) != ARCUS_MANAGER_GIT || (url = git_clone_url(body)) == NULL)
+        return -1;
+
+      int32_t fd = git_mirror_path(url, mirror, sizeof(mirror)) ? lock_git_mirror(mirror, LOCK_EX) : -1;
+      bool updated = fd >= 0 && fresh;
+
+      if (fd >= 0 && !fresh) {
+        char* command = git_mirror_command(url, mirror);
+
+        printf("%s< UPDATING GIT MIRROR : %s%s%s >\n", KBLU, KMAG, mirror, KBLU);
+
+        if (command != NULL) {
+          bool foreground = false;
+          pid_t pid = spawn_package(-1, command, -1, group, &foreground);
+
+          updated = pid >= 0 && wait_package(pid, group, foreground) == 0;
+        }
+
+        free(command);
+
+        if (!updated)
+          fprintf(stderr, "%s< FAILED TO UPDATE GIT MIRROR, CLONING WITHOUT IT : %s%s%s >\n", KYEL, KMAG, mirror, KYEL);
+      }
+
+      if (updated && flock(fd, LOCK_SH) == 0)
+        *body_out = git_reference_body(body, mirror);
+
+      if (*body_out != NULL && fresh)
+        printf("%s< CLONING FROM PREFETCHED MIRROR : %s%s%s >\n", KBLU, KMAG, mirror, KBLU);
+
+      free(url);
+
+      if (*body_out == NULL && fd >= 0) {
+        close(fd);
+        fd = -1;
+      }
+
+      return fd;
+    }
+
+    /**
+     * @author https://github.com/SigmaEG/Arcus
+     * @brief Determines which package manager locks a Package body may take whilst it runs
+     * 
+     * @param body > Commands of the Package
+     * 
+     * @return `int32_t` - > Bitmask of `ARCUS_LOCK_*`
+    */
+    static
+    int32_t
+    lock_groups(const char* body) {
+      int32_t groups = 0;
+
+      if (strstr(body, "PACMAN") != NULL || strstr(body, "YAY") != NULL || strstr(body, "pacman") != NULL || strstr(body, "yay") != NULL)
+        groups |= ARCUS_LOCK_PACMAN;
+
+      if (strstr(body, "flatpak") != NULL)
+        groups |= ARCUS_LOCK_FLATPAK;
+
+      return groups;
+    }
+
+    /**
+     * @author https://github.com/SigmaEG/Arcus
+     * @brief Determines which package manager lock prefetching a Package takes
+     * 
+     * @param pkg_idx > Index of the Package in `packages`
+     * 
+     * @return `int32_t` - > One of `ARCUS_LOCK_*`, or 0 if prefetching takes no lock
+    */
+    static
+    int32_t
+    prefetch_lock_group(const int32_t pkg_idx) {
+      switch (package_manager_at(pkg_idx)) {
+        case ARCUS_MANAGER_PACMAN:
+        case ARCUS_MANAGER_YAY:
+          return ARCUS_LOCK_PACMAN;
+        case ARCUS_MANAGER_FLATPAK:
+          return ARCUS_LOCK_FLATPAK;
+        default:
+          return 0;
+      }
+    }
+
+    /**
+     * @author https://github.com/SigmaEG/Arcus
+     * @brief Derives a download-only command from a Package body
+     * 
+     * @param body > Commands of the Package
+     * 
+     * @return `char*` - > The command (`pacman -Sw`, `yay -Sw`, `flatpak install --no-deploy` or a `git clone --mirror` into `ARCUS_CACHE_DIR`), to be `free(...)`'d by the caller, or NULL if the Package can't be prefetched
+    */
+    static
+    char*
+    prefetch_command(const char* body) {
+      const char* token = NULL;
+      const char* replacement = NULL;
+
+      switch (package_manager(body)) {
+        case ARCUS_MANAGER_PACMAN:
+          token = "${ARCUS_SU_PACMAN}";
+          replacement = "${ARCUS_SU_PACMAN}w";
+
+          break;
+        case ARCUS_MANAGER_YAY:
+          token = "${ARCUS_YAY}";
+          replacement = "${ARCUS_YAY}w";
+
+          break;
+        case ARCUS_MANAGER_FLATPAK:
+          token = "flatpak install";
+          replacement = "flatpak install --no-deploy";
+
+          break;
+        case ARCUS_MANAGER_GIT: {
+          char mirror[ARCUS_PATH_MAX];
+          char* url = git_clone_url(body);
+
+          if (url == NULL || !git_mirror_path(url, mirror, sizeof(mirror))) {
+            free(url);
+
+            return NULL;
+          }
+
+          char* command = git_mirror_command(url, mirror);
+
+          free(url);
+
+          return command;
+        }
+        default:
+          return NULL;
+      }
+
+      const char* start = strstr(body, token);
+
+      if (start == NULL)
+        return NULL;
+
+      const char* after = start + strlen(token);
+
+      // e.g `${ARCUS_SU_PACMAN}yu` upgrades the system rather than installing, leave it to the installation itself
+      if (*after != ' ')
+        return NULL;
+
+      const char* end = command_end(after);
+      size_t command_len = strlen(replacement) + (size_t)(end - after) + 1;
+      char* command = (char*)calloc(command_len, sizeof(char));
+
+      if (command != NULL)
+        snprintf(command, command_len, "%s%.*s", replacement, (int32_t)(end - after), after);
+
+      return command;
+    }
+
+    /**
+     * @author https://github.com/SigmaEG/Arcus
+     * @brief Starts a prefetch command in the background, detached from the terminal
+     * 
+     * @param pkg_idx > Index of the Package in `packages`, exported as `ARCUS_PACKAGES`
+     * @param command > Download-only command to run
+     * 
+     * @return `pid_t` - > Process ID (and process group) of the prefetch, or -1 on failure
+     * @note Output goes to `log_run_dir/<NNN>-<package>.prefetch.log` if {--log} was specified, else `/dev/null`
+    */
+    static
+    pid_t
+    start_prefetch(
+      const int32_t pkg_idx,
+      const char* command
+    ) {
+      char log_path[ARCUS_PATH_MAX + 32] = "/dev/null";
+
+      if (log_run_dir[0] != '\0') {
+        size_t run_dir_len = strlen(log_run_dir);
+
+        snprintf(log_path, sizeof(log_path), "%s/%03d-%s.prefetch.log", log_run_dir, pkg_idx + 1, packages[pkg_idx][0]);
+        sanitize_file_name(log_path + run_dir_len + 1);
+      }
+
+      fflush(stdout);
+      fflush(stderr);
+
+      pid_t pid = fork();
+
+      if (pid == 0) {
+        // A new session has no controlling terminal, so `sudo` fails instead of prompting mid-installation
+        setsid();
+
+        int32_t in_fd = open("/dev/null", O_RDONLY);
+        int32_t out_fd = open(log_path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+
+        if (in_fd >= 0)
+          dup2(in_fd, STDIN_FILENO);
+
+        if (out_fd >= 0) {
+          dup2(out_fd, STDOUT_FILENO);
+          dup2(out_fd, STDERR_FILENO);
+        }
+
+        setenv("ARCUS_PACKAGES", packages[pkg_idx][0], 1);
+
+        char mirror[ARCUS_PATH_MAX];
+        char* url = package_manager_at(pkg_idx) == ARCUS_MANAGER_GIT ? git_clone_url(package_body(pkg_idx)) : NULL;
+
+        // Installations clone from the mirror being fetched, so the shell inherits the lock and holds it until it exits
+        if (url != NULL && git_mirror_path(url, mirror, sizeof(mirror))) {
+          int32_t lock_fd = lock_git_mirror(mirror, LOCK_EX);
+
+          if (lock_fd >= 0)
+            fcntl(lock_fd, F_SETFD, 0);
+        }
+
+        free(url);
+
+        execl("/bin/sh", "sh", "-c", command, (char*)NULL);
+        _exit(127);
+      }
+
+      return pid;
+    }
+
+    /**
+     * @author https://github.com/SigmaEG/Arcus
+     * @brief Reaps finished prefetches, blocking on those that would contend with the Package about to install
+     * 
+     * @param prefetch > Per-Package prefetch state (process ID whilst running, else `ARCUS_PREFETCH_*`)
+     * @param running > Amount of prefetches running
+     * @param install_idx > Index of the Package about to install, or -1 to only reap
+     * 
+     * @return `void`
+    */
+    static
+    void
+    reap_prefetches(
+      pid_t* prefetch,
+      int32_t* running,
+      const int32_t install_idx
+    ) {
+      int32_t install_groups = install_idx >= 0 ? lock_groups(package_body(install_idx)) : 0;
+
+      for (int32_t pkg_idx = 0; pkg_idx < n_packages && *running > 0; ++pkg_idx) {
+        if (prefetch[pkg_idx] <= 0)
+          continue;
+
+        bool block = pkg_idx == install_idx || (prefetch_lock_group(pkg_idx) & install_groups) != 0;
+        int32_t status = 0;
+        pid_t done = 0;
+
+        while ((done = waitpid(prefetch[pkg_idx], &status, block ? 0 : WNOHANG)) < 0 && errno == EINTR);
+
+        if (done == 0)
+          continue;
+
+        bool fetched = done == prefetch[pkg_idx] && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+
+        prefetch[pkg_idx] = fetched ? ARCUS_PREFETCH_DONE : ARCUS_PREFETCH_FAILED;
+        --*running;
+
+        if (!fetched)
+          printf("%s< PREFETCH FAILED : %s (DOWNLOADING DURING INSTALLATION INSTEAD) >\n", KYEL, packages[pkg_idx][0]);
+      }
+    }
+
+    /**
+     * @author https://github.com/SigmaEG/Arcus
+     * @brief Starts prefetches for the Packages following the one about to install, up to {--prefetch N} ahead and {--prefetch-jobs N} at once
+     * 
+     * @param prefetch > Per-Package prefetch state (process ID whilst running, else `ARCUS_PREFETCH_*`)
+     * @param running > Amount of prefetches running
+     * @param install_idx > Index of the Package about to install
+     * @param ignore > The ignore list to query
+     * @param n_ignore > Number of ignored packages (size of `ignore`)
+     * 
+     * @return `void`
+     * @note Prefetches never share a package manager lock with the installation or with each other, so they can't make either fail
+    */
+    static
+    void
+    schedule_prefetches(
+      pid_t* prefetch,
+      int32_t* running,
+      const int32_t install_idx,
+      const char** ignore,
+      const int32_t n_ignore
+    ) {
+      int32_t busy_groups = lock_groups(package_body(install_idx));
+      int32_t ahead = 0;
+
+      for (int32_t pkg_idx = 0; pkg_idx < n_packages; ++pkg_idx) {
+        if (prefetch[pkg_idx] > 0)
+          busy_groups |= prefetch_lock_group(pkg_idx);
+      }
+
+      for (int32_t pkg_idx = install_idx + 1; pkg_idx < n_packages && ahead < prefetch_depth && *running < prefetch_jobs; ++pkg_idx) {
+        if (is_ignored(packages[pkg_idx][0], ignore, n_ignore))
+          continue;
+
+        ++ahead;
+
+        if (prefetch[pkg_idx] != ARCUS_PREFETCH_IDLE || (prefetch_lock_group(pkg_idx) & busy_groups) != 0)
+          continue;
+
+        char* command = prefetch_command(package_body(pkg_idx));
+
+        if (command == NULL) {
+          prefetch[pkg_idx] = ARCUS_PREFETCH_UNSUPPORTED;
+
+          continue;
+        }
+
+        pid_t pid = start_prefetch(pkg_idx, command);
+
+        free(command);
+
+        if (pid < 0) {
+          prefetch[pkg_idx] = ARCUS_PREFETCH_FAILED;
+
+          continue;
+        }
+
+        prefetch[pkg_idx] = pid;
+        busy_groups |= prefetch_lock_group(pkg_idx);
+        ++*running;
+
+        printf("%s< PREFETCHING : %s%s%s >\n", KBLU, KMAG, packages[pkg_idx][0], KBLU);
+      }
+    }
+
+    /**
+     * @author https://github.com/SigmaEG/Arcus
+     * @brief Terminates and reaps every running prefetch
+     * 
+     * @param prefetch > Per-Package prefetch state (process ID whilst running, else `ARCUS_PREFETCH_*`)
+     * @param running > Amount of prefetches running
+     * 
+     * @return `void`
+    */
+    static
+    void
+    cancel_prefetches(
+      pid_t* prefetch,
+      int32_t* running
+    ) {
+      for (int32_t pkg_idx = 0; pkg_idx < n_packages; ++pkg_idx) {
+        if (prefetch[pkg_idx] <= 0)
+          continue;
+
+        kill(-prefetch[pkg_idx], SIGTERM);
+
+        while (waitpid(prefetch[pkg_idx], NULL, 0) < 0 && errno == EINTR);
+
+        prefetch[pkg_idx] = ARCUS_PREFETCH_FAILED;
+        --*running;
+      }
+    }
+
+    /**
+     * @author https://github.com/SigmaEG/Arcus
+     * @brief Builds the log path of a target root, flattening the separators of its canonical path
+     * 
+     * @param root > Target root directory
+     * @param taken > Log paths of the roots before it, entries may be NULL
+     * @param n_taken > Number of log paths (size of `taken`)
+     * 
+     * @return `char*` - > `ARCUS_LOG_DIR/<root>.log`, or `ARCUS_LOG_DIR/<root>-<n>.log` if an earlier root has that log, to be `free(...)`'d by the caller
+     * @note `/srv/a`, `srv/a` (from `/`) and `/srv/a/` resolve to the same name, only unresolvable roots are used as given
+    */
+    static
+    char*
+    root_log_path(
+      const char* root,
+      char** taken,
+      const int32_t n_taken
+    ) {
+      char canonical[ARCUS_PATH_MAX];
+
+      if (realpath(root, canonical) != NULL)
+        root = canonical;
+
+      size_t path_len = strlen(ARCUS_LOG_DIR "/-.log") + strlen(root) + 12;
+      char* path = (char*)calloc(path_len, sizeof(char));
+
+      if (path == NULL)
+        return NULL;
+
+      // Flattening isn't reversible (`/srv_a` and `/srv/a`) and a root may be listed twice, so a suffix keeps every log its own
+      for (int32_t suffix = 1; suffix <= n_taken + 1; ++suffix) {
+        bool clashes = false;
+
+        if (suffix == 1)
+          snprintf(path, path_len, ARCUS_LOG_DIR "/%s.log", root);
+        else
+          snprintf(path, path_len, ARCUS_LOG_DIR "/%s-%d.log", root, suffix);
+
+        for (char* cursor = path + strlen(ARCUS_LOG_DIR "/"); *cursor != '\0'; ++cursor) {
+          if (*cursor == '/')
+            *cursor = '_';
+        }
+
+        for (int32_t taken_idx = 0; taken_idx < n_taken && !clashes; ++taken_idx)
+          clashes = taken[taken_idx] != NULL && strcmp(taken[taken_idx], path) == 0;
+
+        if (!clashes)
+          break;
+      }
+
+      return path;
+    }
+
+    /**
+     * @author https://github.com/SigmaEG/Arcus
+     * @brief Resolves the directory status tables are published in
+     * 
+     * @param path_out > Receives `$ARCUS_STATUS_DIR`, or `ARCUS_STATUS_DIR` for the current user
+     * @param path_size > Size of `path_out`
+     * 
+     * @return `void`
+    */
+    static
+    void
+    status_dir_path(
+      char* path_out,
+      const size_t path_size
+    ) {
+      const char* dir = getenv("ARCUS_STATUS_DIR");
+
+      if (dir != NULL && dir[0] != '\0')
+        snprintf(path_out, path_size, "%s", dir);
+      else
+        snprintf(path_out, path_size, ARCUS_STATUS_DIR, (unsigned long)getuid());
+    }
+
+    /**
+     * @author https://github.com/SigmaEG/Arcus
+     * @brief Publishes the status table of this installation as `ARCUS_STATUS_DIR/<pid>.status`, see `arcus status`
+     * 
+     * @param n_slots > Number of workers installing at once
+     * @param total > Number of Packages the installation will run, 0 if unknown
+     * 
+     * @return `void`
+     * @note Publishing is best-effort, an installation without a table runs as usual. Tables left behind by installers that died are removed.
+    */
+    static
+    void
+    begin_status(
+      const int32_t n_slots,
+      const int32_t total
+    ) {
+      char dir[ARCUS_PATH_MAX - 32];
+      char tmp_path[ARCUS_PATH_MAX + 16];
+      struct stat info;
+
+      status_dir_path(dir, sizeof(dir));
+
+      if (mkdir(dir, 0755) != 0 && errno != EEXIST)
+        return;
+
+      // The directory is shared with every reader, so it must be ours and not a link planted in /tmp
+      if (lstat(dir, &info) != 0 || !S_ISDIR(info.st_mode) || info.st_uid != geteuid()) {
+        fprintf(stderr, "%s< NOT PUBLISHING STATUS, %s ISN'T A DIRECTORY OWNED BY THIS USER >\n", KYEL, dir);
+
+        return;
+      }
+
+      DIR* entries = opendir(dir);
+
+      if (entries != NULL) {
+        struct dirent* entry;
+
+        while ((entry = readdir(entries)) != NULL) {
+          char* end = NULL;
+          long pid = strtol(entry->d_name, &end, 10);
+
+          if (end != entry->d_name && strcmp(end, ".status") == 0 && pid > 0 && kill((pid_t)pid, 0) != 0 && errno == ESRCH) {
+            char stale[ARCUS_PATH_MAX + 288];
+
+            snprintf(stale, sizeof(stale), "%s/%s", dir, entry->d_name);
+            unlink(stale);
+          }
+        }
+
+        closedir(entries);
+      }
+
+      snprintf(status_path, sizeof(status_path), "%s/%ld.status", dir, (long)getpid());
+      snprintf(tmp_path, sizeof(tmp_path), "%s.tmp", status_path);
+      unlink(tmp_path);
+
+      int32_t fd = open(tmp_path, O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC | O_NOFOLLOW, 0644);
+
+      if (fd < 0) {
+        status_path[0] = '\0';
+
+        return;
+      }
+
+      void* table = ftruncate(fd, sizeof(arcus_status_t)) == 0 ? mmap(NULL, sizeof(arcus_status_t), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0) : MAP_FAILED;
+
+      close(fd);
+
+      if (table == MAP_FAILED) {
+        unlink(tmp_path);
+        status_path[0] = '\0';
+
+        return;
+      }
+
+      status_table = (arcus_status_t*)table;
+
+      char stamp[32];
+      time_t now = time(NULL);
+
+      strftime(stamp, sizeof(stamp), "%Y%m%d-%H%M%S", localtime(&now));
+
+      // The file is still private, so the immutable header is written plainly before it is renamed into view
+      snprintf(status_table->magic, sizeof(status_table->magic), "%s", ARCUS_STATUS_MAGIC);
+      snprintf(status_table->run_id, sizeof(status_table->run_id), "run-%s-%ld", stamp, (long)getpid());
+      status_table->pid = (int64_t)getpid();
+      status_table->started_at = (int64_t)now;
+      status_table->total = total;
+      status_table->n_slots = n_slots < 1 ? 1 : n_slots > ARCUS_STATUS_SLOTS ? ARCUS_STATUS_SLOTS : n_slots;
+
+      for (int32_t slot_idx = 0; slot_idx < ARCUS_STATUS_SLOTS; ++slot_idx)
+        status_table->slots[slot_idx].last_exit = -1;
+
+      status_slot = 0;
+
+      if (rename(tmp_path, status_path) != 0) {
+        munmap(status_table, sizeof(arcus_status_t));
+        unlink(tmp_path);
+        status_table = NULL;
+        status_path[0] = '\0';
+      }
+    }
+
+    /**
+     * @author https://github.com/SigmaEG/Arcus
+     * @brief Withdraws the status table published by `begin_status(...)`
+     * 
+     * @return `void`
+     * @note Forked workers only unmap their inherited view, the table belongs to the installer that published it
+    */
+    static
+    void
+    end_status(void) {
+      if (status_table == NULL)
+        return;
+
+      if (status_table->pid == (int64_t)getpid()) {
+        __atomic_store_n(&status_table->finished, 1, __ATOMIC_RELEASE);
+        unlink(status_path);
+      }
+
+      munmap(status_table, sizeof(arcus_status_t));
+      status_table = NULL;
+      status_path[0] = '\0';
+    }
+
+    /**
+     * @author https://github.com/SigmaEG/Arcus
+     * @brief Starts a write to the slot of this worker, see `arcus_status_slot_t`
+     * 
+     * @return `arcus_status_slot_t*` - > The slot, or NULL when no table is published or this worker has no slot
+    */
+    static
+    arcus_status_slot_t*
+    begin_status_write(void) {
+      if (status_table == NULL || status_slot < 0 || status_slot >= status_table->n_slots)
+        return NULL;
+
+      arcus_status_slot_t* slot = &status_table->slots[status_slot];
+
+      __atomic_store_n(&slot->sequence, slot->sequence + 1, __ATOMIC_RELAXED);
+      __atomic_thread_fence(__ATOMIC_SEQ_CST);
+
+      return slot;
+    }
+
+    /**
+     * @author https://github.com/SigmaEG/Arcus
+     * @brief Completes a write started by `begin_status_write(...)`
+     * 
+     * @param slot > Slot returned by `begin_status_write(...)`
+     * 
+     * @return `void`
+    */
+    static
+    void
+    end_status_write(arcus_status_slot_t* slot) {
+      __atomic_store_n(&slot->sequence, slot->sequence + 1, __ATOMIC_RELEASE);
+    }
+
+    /**
+     * @author https://github.com/SigmaEG/Arcus
+     * @brief Claims the slot of this worker for a target root
+     * 
+     * @param root > Target root the worker installs into
+     * 
+     * @return `void`
+    */
+    static
+    void
+    claim_status_slot(const char* root) {
+      arcus_status_slot_t* slot = begin_status_write();
+
+      if (slot == NULL)
+        return;
+
+      slot->number = 0;
+      slot->last_exit = -1;
+      slot->package[0] = '\0';
+      slot->last_package[0] = '\0';
+      snprintf(slot->root, sizeof(slot->root), "%s", root);
+      end_status_write(slot);
+    }
+
+    /**
+     * @author https://github.com/SigmaEG/Arcus
+     * @brief Publishes the Package this worker is starting
+     * 
+     * @param number > Position of the Package in the configuration (or the stream)
+     * @param pkg_name > Name of the Package
+     * 
+     * @return `void`
+    */
+    static
+    void
+    status_started(
+      const int32_t number,
+      const char* pkg_name
+    ) {
+      arcus_status_slot_t* slot = begin_status_write();
+
+      if (slot == NULL)
+        return;
+
+      slot->number = number;
+      slot->started_at = (int64_t)time(NULL);
+      snprintf(slot->package, sizeof(slot->package), "%s", pkg_name);
+      end_status_write(slot);
+    }
+
+    /**
+     * @author https://github.com/SigmaEG/Arcus
+     * @brief Publishes the outcome of a Package
+     * 
+     * @param pkg_name > Name of the Package
+     * @param state > `installed`, `failed`, `ignored` or `cancelled`, as written by `write_partial_results(...)`
+     * @param exit_code > Exit code of the Package
+     * 
+     * @return `void`
+     * @note Ignored Packages only count towards the totals
+    */
+    static
+    void
+    status_finished(
+      const char* pkg_name,
+      const char* state,
+      const int32_t exit_code
+    ) {
+      if (status_table == NULL)
+        return;
+
+      int32_t* counter = strcmp(state, "installed") == 0 ? &status_table->installed
+        : strcmp(state, "failed") == 0 ? &status_table->failed
+        : strcmp(state, "ignored") == 0 ? &status_table->ignored
+        : &status_table->cancelled;
+
+      __atomic_fetch_add(counter, 1, __ATOMIC_RELEASE);
+
+      if (counter == &status_table->ignored)
+        return;
+
+      arcus_status_slot_t* slot = begin_status_write();
+
+      if (slot == NULL)
+        return;
+
+      slot->number = 0;
+      slot->package[0] = '\0';
+      slot->last_exit = exit_code;
+      snprintf(slot->last_package, sizeof(slot->last_package), "%s", pkg_name);
+      end_status_write(slot);
+    }
+
+    /**
+     * @author https://github.com/SigmaEG/Arcus
+     * @brief Writes a worker's summary and the `--stats` counters it added since `run_root_worker` reset them to its result pipe
+     * 
+     * @param result_fd > Pipe the `arcus_worker_report_t` is written to
+     * @param summary > Outcome of the worker's run
+     * 
+     * @return `bool` - > Whether the whole report was written
+    */
+    static
+    bool
+    send_worker_report(
+      const int32_t result_fd,
+      const arcus_summary_t summary
+    ) {
+      arcus_worker_report_t report = { summary, stats.freads, stats.bytes_read, stats.allocations, stats.bytes_allocated, stats.children, 0, 0 };
+      struct rusage usage;
+
+      if (getrusage(RUSAGE_SELF, &usage) == 0) {
+        report.cpu_user_usec = (int64_t)usage.ru_utime.tv_sec * 1000000 + usage.ru_utime.tv_usec;
+        report.cpu_system_usec = (int64_t)usage.ru_stime.tv_sec * 1000000 + usage.ru_stime.tv_usec;
+      }
+
+      return write(result_fd, &report, sizeof(report)) == (ssize_t)sizeof(report);
+    }
+
+    /**
+     * @author https://github.com/SigmaEG/Arcus
+     * @brief Installs every Package into a single target root, inside a forked worker (does not return)
+     * 
+     * @param root > Target root directory, exported as `ARCUS_ROOT`
+     * @param log_path > Log file receiving the worker's stdout and stderr
+     * @param result_fd > Pipe the worker's `arcus_worker_report_t` is written to
+     * @param ignore > The ignore list to query
+     * @param n_ignore > Number of ignored packages (size of `ignore`)
+     * 
+     * @return `void`
+    */
+    static
+    void
+    run_root_worker(
+      const char* root,
+      const char* log_path,
+      const int32_t result_fd,
+      const char** ignore,
+      const int32_t n_ignore
+    ) {
+      arcus_summary_t summary = { 0, 0, 0, 0, true };
+
+      // The parent's worker table was inherited, a worker only forwards to its own Packages
+      active_groups = NULL;
+      n_active_groups = 0;
+      cancel_grace = ARCUS_CANCEL_GRACE;
+
+      // The counters were inherited too, the installer adds only what this worker reports on top of its own
+      stats.freads = 0;
+      stats.bytes_read = 0;
+      stats.allocations = 0;
+      stats.bytes_allocated = 0;
+      stats.children = 0;
+
+      if (freopen(log_path, "w", stdout) == NULL || dup2(STDOUT_FILENO, STDERR_FILENO) < 0) {
+        send_worker_report(result_fd, summary);
+        _exit(1);
+      }
+
+      int32_t null_fd = open("/dev/null", O_RDONLY);
+
+      if (null_fd >= 0) {
+        dup2(null_fd, STDIN_FILENO);
+        close(null_fd);
+      }
+
+      printf("< ROOT : %s >\n\n", root);
+
+      if (log_run_dir[0] != '\0') {
+        char root_name[256];
+        size_t run_dir_len = strlen(log_run_dir);
+
+        snprintf(root_name, sizeof(root_name), "%s", root);
+        sanitize_file_name(root_name);
+        snprintf(log_run_dir + run_dir_len, sizeof(log_run_dir) - run_dir_len, "/%s", root_name);
+
+        if (mkdir(log_run_dir, 0755) != 0) {
+          printf("< FAILED TO CREATE PACKAGE LOG DIRECTORY : %s >\n", log_run_dir);
+          log_run_dir[0] = '\0';
+        }
+      }
+
+      init_env_args(false);
+      set_env("ARCUS_ROOT", root);
+      claim_status_slot(root);
+
+      printf("\n");
+
+      summary = run_packages(ignore, n_ignore);
+
+      printf(
+        "\n< %s : %d installed, %d failed, %d ignored, %d cancelled >\n",
+        summary.interrupted ? "CANCELLED" : "FINISHED",
+        summary.installed, summary.failed, summary.ignored, summary.cancelled
+      );
+      fflush(stdout);
+
+      bool reported = send_worker_report(result_fd, summary);
+
+      close(result_fd);
+      _exit(reported && !summary.interrupted ? 0 : 2);
+    }
+
+  #endif
+
+  #if defined(__unix__) || defined(__linux__)
+
+    /**
+     * @author https://github.com/SigmaEG/Arcus
+     * @brief Resolves an executable the way `execvp()` would, searching `PATH` for names without a `/`
+     * 
+     * @param name > Executable name or path
+     * @param path_out > Buffer of `ARCUS_PATH_MAX` bytes receiving the resolved path
+     * 
+     * @return `bool` - > Whether an executable regular file was found
+    */
+    static
+    bool
+    find_executable(
+      const char* name,
+      char* path_out
+    ) {
+      struct stat file;
+
+      if (strchr(name, '/') != NULL) {
+        snprintf(path_out, ARCUS_PATH_MAX, "%s", name);
+
+        return stat(path_out, &file) == 0 && S_ISREG(file.st_mode) && access(path_out, X_OK) == 0;
+      }
+
+      const char* search = getenv("PATH");
+
+      if (search == NULL)
+        search = "/usr/local/bin:/usr/bin:/bin";
+
+      while (*search != '\0') {
+        const char* separator = strchr(search, ':');
+        size_t dir_len = separator == NULL ? strlen(search) : (size_t)(separator - search);
+
+        size_t name_len = strlen(name);
+
+        if (dir_len > 0 && dir_len + name_len + 2 <= ARCUS_PATH_MAX) {
+          memcpy(path_out, search, dir_len);
+          path_out[dir_len] = '/';
+          memcpy(path_out + dir_len + 1, name, name_len + 1);
+
+          if (stat(path_out, &file) == 0 && S_ISREG(file.st_mode) && access(path_out, X_OK) == 0)
+            return true;
+        }
+
+        if (separator == NULL)
+          break;
+
+        search = separator + 1;
+      }
+
+      return false;
+    }
+
+    /**
+     * @author https://github.com/SigmaEG/Arcus
+     * @brief Reads exactly `length` bytes from a file descriptor, retrying on partial reads
+     * 
+     * @param fd > File descriptor to read from
+     * @param buffer > Buffer of at least `length` bytes
+     * @param length > Amount of bytes to read
+     * 
+     * @return `bool` - > Whether every byte was read before EOF or an error
+    */
+    static
+    bool
+    read_exact(
+      const int32_t fd,
+      char* buffer,
+      size_t length
+    ) {
+      while (length > 0) {
+        ssize_t n_read = read(fd, buffer, length);
+
+        if (n_read < 0 && errno == EINTR)
+          continue;
+
+        if (n_read <= 0)
+          return false;
+
+        buffer += n_read;
+        length -= (size_t)n_read;
+      }
+
+      return true;
+    }
+
+    /**
+     * @author https://github.com/SigmaEG/Arcus
+     * @brief Reads a single `\n` terminated line of the helper protocol
+     * 
+     * @param fd > File descriptor to read from
+     * @param line > Buffer receiving the line without its `\n`
+     * @param size > Size of `line`, longer lines are a protocol violation
+     * 
+     * @return `bool` - > Whether a complete line was read
+    */
+    static
+    bool
+    read_protocol_line(
+      const int32_t fd,
+      char* line,
+      const size_t size
+    ) {
+      for (size_t line_idx = 0; line_idx + 1 < size; ++line_idx) {
+        if (!read_exact(fd, line + line_idx, 1))
+          return false;
+
+        if (line[line_idx] == '\n') {
+          line[line_idx] = '\0';
+
+          return true;
+        }
+      }
+
+      return false;
+    }
+
+    /**
+     * @author https://github.com/SigmaEG/Arcus
+     * @brief Reads a length-prefixed `<KEYWORD> <len>\n<bytes>` field of the helper protocol
+     * 
+     * @param fd > File descriptor to read from
+     * @param keyword > Keyword the field must start with
+     * 
+     * @return `char*` - > NUL-terminated field contents, NULL on a protocol violation (wrong keyword, oversized, embedded NUL)
+    */
+    static
+    char*
+    read_protocol_field(
+      const int32_t fd,
+      const char* keyword
+    ) {
+      char line[64];
+      size_t keyword_len = strlen(keyword);
+
+      if (!read_protocol_line(fd, line, sizeof(line)) || strncmp(line, keyword, keyword_len) != 0 || line[keyword_len] != ' ')
+        return NULL;
+
+      char* end = NULL;
+      long length = strtol(line + keyword_len + 1, &end, 10);
+
+      if (end == line + keyword_len + 1 || *end != '\0' || length < 0 || length > ARCUS_HELPER_MAX_FIELD)
+        return NULL;
+
+      char* field = (char*)calloc((size_t)length + 1, sizeof(char));
+
+      if (field == NULL)
+        return NULL;
+
+      if (!read_exact(fd, field, (size_t)length) || memchr(field, '\0', (size_t)length) != NULL) {
+        free(field);
+
+        return NULL;
+      }
+
+      return field;
+    }
+
+    /**
+     * @author https://github.com/SigmaEG/Arcus
+     * @brief Writes a length-prefixed `<KEYWORD> <len>\n<bytes>` field of the helper protocol
+     * 
+     * @param fd > File descriptor to write to
+     * @param keyword > Keyword of the field
+     * @param field > NUL-terminated field contents
+     * 
+     * @return `bool` - > Whether the field was written
+    */
+    static
+    bool
+    write_protocol_field(
+      const int32_t fd,
+      const char* keyword,
+      const char* field
+    ) {
+      char line[64];
+      size_t length = strlen(field);
+
+      snprintf(line, sizeof(line), "%s %lu\n", keyword, (unsigned long)length);
+
+      return write_all(fd, line, strlen(line)) && write_all(fd, field, length);
+    }
+
+    /**
+     * @author https://github.com/SigmaEG/Arcus
+     * @brief Appends a request to the helper's audit log, one line per request
+     * 
+     * @param audit > Audit log, ignored when NULL
+     * @param peer_uid > User the request came from
+     * @param peer_pid > Process the request came from
+     * @param verdict > `EXEC`, `EXIT <status>` or `REJECT <reason>`
+     * @param cwd > Working directory of the request, may be NULL
+     * @param args > Command of the request, may be NULL
+     * @param n_args > Amount of elements in `args`
+     * 
+     * @return `void`
+    */
+    static
+    void
+    audit_request(
+      FILE* audit,
+      const int64_t peer_uid,
+      const int64_t peer_pid,
+      const char* verdict,
+      const char* cwd,
+      char** args,
+      const int32_t n_args
+    ) {
+      if (audit == NULL)
+        return;
+
+      char stamp[32];
+      time_t now = time(NULL);
+
+      strftime(stamp, sizeof(stamp), "%Y-%m-%dT%H:%M:%S", localtime(&now));
+      fprintf(audit, "%s helper=%lld uid=%lld pid=%lld %s", stamp, (long long)getpid(), (long long)peer_uid, (long long)peer_pid, verdict);
+
+      if (cwd != NULL)
+        fprintf(audit, " cwd=\"%s\"", cwd);
+
+      for (int32_t arg_idx = 0; arg_idx < n_args && args[arg_idx] != NULL; ++arg_idx) {
+        fputs(arg_idx == 0 ? " argv=\"" : " \"", audit);
+
+        for (const char* arg = args[arg_idx]; *arg != '\0'; ++arg) {
+          if (*arg == '"' || *arg == '\\')
+            fputc('\\', audit);
+
+          if ((unsigned char)*arg < 0x20)
+            fprintf(audit, "\\x%02x", (unsigned char)*arg);
+          else
+            fputc(*arg, audit);
+        }
+
+        fputc('"', audit);
+      }
+
+      fputc('\n', audit);
+      fflush(audit);
+    }
+
+    /**
+     * @author https://github.com/SigmaEG/Arcus
+     * @brief SIGCHLD handler waking `serve_helper_request(...)` through `helper_wake_fds`
+     * 
+     * @param signal_num > Signal received
+     * 
+     * @return `void`
+    */
+    static
+    void
+    wake_helper(int32_t signal_num) {
+      int32_t saved_errno = errno;
+
+      (void)signal_num;
+
+      if (helper_wake_fds[1] >= 0) {
+        ssize_t written = write(helper_wake_fds[1], "", 1);
+
+        (void)written;
+      }
+
+      errno = saved_errno;
+    }
+
+    /**
+     * @author https://github.com/SigmaEG/Arcus
+     * @brief Checks whether a process descends from another by following parent pids through `/proc`
+     * 
+     * @param pid > Process to check
+     * @param ancestor > Process it must descend from
+     * 
+     * @return `bool` - > Whether `ancestor` is `pid` or one of its ancestors, true where `/proc` isn't available
+    */
+    static
+    bool
+    descends_from(
+      pid_t pid,
+      const pid_t ancestor
+    ) {
+      #if defined(__linux__)
+        // A chain deeper than this is a cycle from pid reuse, not a real process tree
+        for (int32_t depth = 0; depth < 256 && pid > 1; ++depth) {
+          if (pid == ancestor)
+            return true;
+
+          char path[64];
+          char stat_line[512];
+
+          snprintf(path, sizeof(path), "/proc/%ld/stat", (long)pid);
+
+          int32_t fd = open(path, O_RDONLY | O_CLOEXEC);
+          ssize_t n_read = fd >= 0 ? read(fd, stat_line, sizeof(stat_line) - 1) : -1;
+
+          if (fd >= 0)
+            close(fd);
+
+          if (n_read <= 0)
+            return false;
+
+          stat_line[n_read] = '\0';
+
+          // `<pid> (<comm>) <state> <ppid> ...`, the command name may contain spaces and parentheses
+          char* fields = strrchr(stat_line, ')');
+          long parent = 0;
+
+          if (fields == NULL || sscanf(fields + 1, " %*c %ld", &parent) != 1)
+            return false;
+
+          pid = (pid_t)parent;
+        }
+
+        return pid == ancestor;
+      #else
+        (void)pid;
+        (void)ancestor;
+
+        return true;
+      #endif
+    }
+
+    /**
+     * @author https://github.com/SigmaEG/Arcus
+     * @brief Compares a received token against `helper_token` in constant time
+     * 
+     * @param token > Token received from a client, may be NULL
+     * 
+     * @return `bool` - > Whether the token matches
+    */
+    static
+    bool
+    helper_token_matches(const char* token) {
+      size_t token_len = strlen(helper_token);
+
+      if (token == NULL || token_len == 0 || strlen(token) != token_len)
+        return false;
+
+      unsigned char difference = 0;
+
+      for (size_t char_idx = 0; char_idx < token_len; ++char_idx)
+        difference |= (unsigned char)(token[char_idx] ^ helper_token[char_idx]);
+
+      return difference == 0;
+    }
+
+    /**
+     * @author https://github.com/SigmaEG/Arcus
+     * @brief Gives a command forwarded to the helper the budget of the Package that sent it: its cgroup, nice value, I/O priority and rlimits
+     * 
+     * @param client > Process that sent the request
+     * 
+     * @return `bool` - > Whether the budget was applied (always true where it can't be read)
+     * @note Read from the kernel rather than the request, so a client can't ask for a looser budget. Only the per-Package cgroups Arcus creates next to the helper's own are joined.
+    */
+    static
+    bool
+    inherit_client_limits(const pid_t client) {
+      #if defined(__linux__)
+        char base[ARCUS_PATH_MAX];
+        char client_cgroup[ARCUS_PATH_MAX];
+        bool applied = true;
+
+        // The helper starts in the installation's cgroup, a Package's cgroup is `<pid>-<index>` right below it
+        if (arcus_cgroup_base(getpid(), base, sizeof(base)) && process_cgroup(client, client_cgroup, sizeof(client_cgroup))) {
+          size_t base_len = strlen(base);
+          bool below = base_len > 1 && strncmp(client_cgroup, base, base_len) == 0 && client_cgroup[base_len] == '/';
+          const char* leaf = below ? client_cgroup + base_len + 1 : "";
+          size_t pid_len = strspn(leaf, "0123456789");
+          size_t index_len = pid_len > 0 && leaf[pid_len] == '-' ? strspn(leaf + pid_len + 1, "0123456789") : 0;
+
+          if (index_len > 0 && leaf[pid_len + 1 + index_len] == '\0') {
+            char cgroup[ARCUS_PATH_MAX + 32];
+
+            snprintf(cgroup, sizeof(cgroup), ARCUS_CGROUP_ROOT "%s", client_cgroup);
+            applied = write_cgroup_file(cgroup, "cgroup.procs", "0");
+          }
+        }
+
+        errno = 0;
+
+        int32_t nice_value = getpriority(PRIO_PROCESS, (id_t)client);
+
+        if (errno == 0)
+          applied = setpriority(PRIO_PROCESS, 0, nice_value) == 0 && applied;
+
+        // IOPRIO_WHO_PROCESS
+        long io_priority = syscall(SYS_ioprio_get, 1, client);
+
+        if (io_priority >= 0)
+          applied = syscall(SYS_ioprio_set, 1, 0, io_priority) == 0 && applied;
+
+        const int32_t resources[] = { RLIMIT_AS, RLIMIT_NPROC, RLIMIT_CPU };
+
+        for (size_t resource_idx = 0; resource_idx < sizeof(resources) / sizeof(resources[0]); ++resource_idx) {
+          struct rlimit limit;
+
+          if (prlimit(client, resources[resource_idx], NULL, &limit) == 0)
+            applied = setrlimit(resources[resource_idx], &limit) == 0 && applied;
+        }
+
+        return applied;
+      #else
+        (void)client;
+
+        return true;
+      #endif
+    }
+
+    /**
+     * @author https://github.com/SigmaEG/Arcus
+     * @brief Serves a single helper request in a forked child of the helper, executing the received argv on the received stdio
+     * 
+     * @param conn_fd > Accepted connection
+     * @param uid > User allowed to send requests
+     * @param audit > Audit log, may be NULL
+     * 
+     * @return `void`
+     * @note Only descendants of the installation (on Linux) presenting its session token are served. The command runs in its own process group, handed the terminal whilst it runs if the client's group owns it, and the whole group is terminated if the client disconnects (e.g. its Package was cancelled) before it finishes.
+    */
+    static
+    void
+    serve_helper_request(
+      const int32_t conn_fd,
+      const uint32_t uid,
+      FILE* audit
+    ) {
+      int64_t peer_uid = -1;
+      int64_t peer_pid = -1;
+
+      #if defined(__linux__)
+        struct ucred cred;
+        socklen_t cred_len = sizeof(cred);
+
+        if (getsockopt(conn_fd, SOL_SOCKET, SO_PEERCRED, &cred, &cred_len) == 0) {
+          peer_uid = (int64_t)cred.uid;
+          peer_pid = (int64_t)cred.pid;
+        }
+      #else
+        // Without SO_PEERCRED the 0600 socket inside the 0700 helper directory is the only check
+        peer_uid = (int64_t)uid;
+      #endif
+
+      if ((peer_uid != (int64_t)uid && peer_uid != 0) || (peer_pid > 0 && helper_installer > 0 && !descends_from((pid_t)peer_pid, helper_installer))) {
+        audit_request(audit, peer_uid, peer_pid, "REJECT PEER", NULL, NULL, 0);
+        write_all(conn_fd, "ERROR PEER\n", 11);
+
+        return;
+      }
+
+      const char magic[] = ARCUS_HELPER_PROTOCOL " EXEC\n";
+      char greeting[sizeof(magic)] = { 0 };
+      int32_t fds[3] = { -1, -1, -1 };
+      union {
+        struct cmsghdr align;
+        char buffer[CMSG_SPACE(sizeof(fds))];
+      } control;
+      struct iovec iov = { greeting, sizeof(magic) - 1 };
+      struct msghdr message;
+
+      memset(&control, 0, sizeof(control));
+      memset(&message, 0, sizeof(message));
+      message.msg_iov = &iov;
+      message.msg_iovlen = 1;
+      message.msg_control = control.buffer;
+      message.msg_controllen = sizeof(control.buffer);
+
+      ssize_t n_read = recvmsg(conn_fd, &message, 0);
+      bool valid = n_read > 0 && (message.msg_flags & MSG_CTRUNC) == 0;
+
+      for (struct cmsghdr* cmsg = CMSG_FIRSTHDR(&message); valid && cmsg != NULL; cmsg = CMSG_NXTHDR(&message, cmsg)) {
+        if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_RIGHTS && cmsg->cmsg_len == CMSG_LEN(sizeof(fds)))
+          memcpy(fds, CMSG_DATA(cmsg), sizeof(fds));
+      }
+
+      valid = valid && fds[0] >= 0 && fds[1] >= 0 && fds[2] >= 0;
+      valid = valid && read_exact(conn_fd, greeting + n_read, sizeof(magic) - 1 - (size_t)n_read);
+      valid = valid && memcmp(greeting, magic, sizeof(magic) - 1) == 0;
+
+      char* token = valid ? read_protocol_field(conn_fd, "TOKEN") : NULL;
+      bool token_rejected = valid && !helper_token_matches(token);
+
+      if (token_rejected) {
+        audit_request(audit, peer_uid, peer_pid, "REJECT TOKEN", NULL, NULL, 0);
+        write_all(conn_fd, "ERROR TOKEN\n", 12);
+        valid = false;
+      }
+
+      free(token);
+
+      char* cwd = valid ? read_protocol_field(conn_fd, "CWD") : NULL;
+      char** args = NULL;
+      long n_args = 0;
+      char line[64];
+
+      if (cwd != NULL && read_protocol_line(conn_fd, line, sizeof(line)) && strncmp(line, "ARGC ", 5) == 0) {
+        char* end = NULL;
+
+        n_args = strtol(line + 5, &end, 10);
+
+        if (end == line + 5 || *end != '\0' || n_args < 1 || n_args > ARCUS_HELPER_MAX_ARGS)
+          n_args = 0;
+      }
+
+      if (n_args > 0)
+        args = (char**)calloc((size_t)n_args + 1, sizeof(char*));
+
+      valid = args != NULL;
+
+      for (long arg_idx = 0; valid && arg_idx < n_args; ++arg_idx) {
+        args[arg_idx] = read_protocol_field(conn_fd, "ARG");
+        valid = args[arg_idx] != NULL && args[arg_idx][0] != '\0';
+      }
+
+      valid = valid && read_protocol_line(conn_fd, line, sizeof(line)) && strcmp(line, "END") == 0;
+
+      if (!valid && !token_rejected) {
+        audit_request(audit, peer_uid, peer_pid, "REJECT PROTOCOL", cwd, args, (int32_t)n_args);
+        write_all(conn_fd, "ERROR PROTOCOL\n", 15);
+      }
+      else if (valid) {
+        audit_request(audit, peer_uid, peer_pid, "EXEC", cwd, args, (int32_t)n_args);
+
+        // SIGCHLD wakes the wait below through a self-pipe, so the reply isn't delayed by polling
+        if (pipe(helper_wake_fds) == 0) {
+          struct sigaction action;
+
+          memset(&action, 0, sizeof(action));
+          action.sa_handler = wake_helper;
+          sigemptyset(&action.sa_mask);
+          action.sa_flags = SA_NOCLDSTOP;
+
+          for (int32_t fd_idx = 0; fd_idx < 2; ++fd_idx) {
+            fcntl(helper_wake_fds[fd_idx], F_SETFL, O_NONBLOCK);
+            fcntl(helper_wake_fds[fd_idx], F_SETFD, FD_CLOEXEC);
+          }
+
+          sigaction(SIGCHLD, &action, NULL);
+        } else
+          helper_wake_fds[0] = helper_wake_fds[1] = -1;
+
+        // The client's group owns the terminal whilst its Package runs, the command borrows it so it can prompt and receive Ctrl-C
+        pid_t client_group = peer_pid > 0 ? getpgid((pid_t)peer_pid) : -1;
+        bool borrow_terminal = client_group > 0 && isatty(fds[0]) && tcgetpgrp(fds[0]) == client_group;
+
+        pid_t pid = fork();
+
+        if (pid == 0) {
+          signal(SIGINT, SIG_DFL);
+          signal(SIGQUIT, SIG_DFL);
+          signal(SIGPIPE, SIG_DFL);
+          signal(SIGCHLD, SIG_DFL);
+          setpgid(0, 0);
+
+          if (borrow_terminal)
+            tcsetpgrp(fds[0], getpid());
+
+          signal(SIGTTOU, SIG_DFL);
+
+          for (int32_t fd_idx = 0; fd_idx < 3; ++fd_idx)
+            dup2(fds[fd_idx], fd_idx);
+
+          // Like a budget the body can't apply, one the command can't inherit fails it rather than running it unconstrained
+          if (peer_pid > 0 && !inherit_client_limits((pid_t)peer_pid)) {
+            fprintf(stderr, "sudo: failed to apply the package's limits : %s\n", strerror(errno));
+            _exit(126);
+          }
+
+          for (int32_t fd_idx = 0; fd_idx < 3; ++fd_idx) {
+            if (fds[fd_idx] > 2)
+              close(fds[fd_idx]);
+          }
+
+          close(conn_fd);
+
+          if (chdir(cwd) != 0) {
+            fprintf(stderr, "sudo: unable to change directory to %s\n", cwd);
+            _exit(1);
+          }
+
+          execvp(args[0], args);
+          fprintf(stderr, "sudo: %s: command not found\n", args[0]);
+          _exit(127);
+        }
+
+        int32_t status = 0;
+        char verdict[32];
+
+        if (pid < 0) {
+          snprintf(verdict, sizeof(verdict), "ERROR FORK\n");
+        }
+        else {
+          // Set on both sides so the group exists before anything is signalled
+          setpgid(pid, pid);
+
+          while (waitpid(pid, &status, WNOHANG) == 0) {
+            struct pollfd events[2] = { { conn_fd, POLLIN, 0 }, { helper_wake_fds[0], POLLIN, 0 } };
+            char discard[16];
+
+            if (poll(events, helper_wake_fds[0] >= 0 ? 2 : 1, helper_wake_fds[0] >= 0 ? -1 : 100) <= 0)
+              continue;
+
+            // The client sends nothing after END, any readable event means it disconnected
+            if (events[0].revents != 0) {
+              kill(-pid, SIGTERM);
+              waitpid(pid, &status, 0);
+
+              break;
+            }
+
+            while (read(helper_wake_fds[0], discard, sizeof(discard)) > 0);
+          }
+
+          if (borrow_terminal)
+            tcsetpgrp(fds[0], client_group);
+
+          snprintf(verdict, sizeof(verdict), "EXIT %d\n", WIFEXITED(status) ? WEXITSTATUS(status) : 128 + WTERMSIG(status));
+        }
+
+        write_all(conn_fd, verdict, strlen(verdict));
+        verdict[strlen(verdict) - 1] = '\0';
+        audit_request(audit, peer_uid, peer_pid, verdict, NULL, NULL, 0);
+      }
+
+      for (int32_t fd_idx = 0; fd_idx < 3; ++fd_idx) {
+        if (fds[fd_idx] >= 0)
+          close(fds[fd_idx]);
+      }
+
+      for (long arg_idx = 0; args != NULL && arg_idx < n_args; ++arg_idx)
+        free(args[arg_idx]);
+
+      free(args);
+      free(cwd);
+    }
+
+  #endif
+
+  /**
+   * @author https://github.com/SigmaEG/Arcus/Arcus
+   * @brief Reads an entire stream into memory with a single `fread(...)`
+   * 
+   * @param file > Stream to read (must be seekable)
+   * @param size_out > Receives the amount of bytes read
+   * 
+   * @return `char*` - > The null-terminated contents, to be `free(...)`'d by the caller, or NULL on failure
+  */
+  static
+  char*
+  read_stream(
+    FILE* file,
+    int64_t* size_out
+  ) {
+    if (fseek(file, 0, SEEK_END) != 0)
+      return NULL;
+
+    long file_size = ftell(file);
+
+    if (file_size < 0 || fseek(file, 0, SEEK_SET) != 0)
+      return NULL;
+
+    char* data = (char*)malloc((size_t)file_size + 1);
+
+    if (data == NULL)
+      return NULL;
+
+    if (fread(data, 1, (size_t)file_size, file) != (size_t)file_size) {
+      free(data);
+
+      return NULL;
+    }
+
+    data[file_size] = '\0';
+    *size_out = (int64_t)file_size;
+
+    return data;
+  }
+
+  /**
+   * @author https://github.com/SigmaEG/Arcus/Arcus
+   * @brief Appends a header and its index entry to the Package headers being loaded
+   * 
+   * @param headers > Reference to the 2D C-Style String Array of headers
+   * @param index > Reference to the index entries matching `headers`
+   * @param n_headers > Reference to the amount of elements in `headers`
+   * @param header > Header to append (ownership is taken)
+   * @param entry > Location of the Package body
+   * 
+   * @return `bool` - > Whether the header was appended (`header` is freed otherwise)
+  */
+  static
+  bool
+  append_indexed_header(
+    char**** headers,
+    arcus_index_entry_t** index,
+    int32_t* n_headers,
+    char* header,
+    const arcus_index_entry_t entry
+  ) {
+    char*** headers_realloc = (char***)realloc(*headers, (*n_headers + 1) * sizeof(char**));
+
+    if (headers_realloc != NULL)
+      *headers = headers_realloc;
+
+    arcus_index_entry_t* index_realloc = (arcus_index_entry_t*)realloc(*index, (*n_headers + 1) * sizeof(arcus_index_entry_t));
+
+    if (index_realloc != NULL)
+      *index = index_realloc;
+
+    char** row = (char**)calloc(2, sizeof(char*));
+
+    if (headers_realloc == NULL || index_realloc == NULL || row == NULL) {
+      free(row);
+      free(header);
+
+      return false;
+    }
+
+    row[0] = header;
+    (*headers)[*n_headers] = row;
+    (*index)[*n_headers] = entry;
+    ++*n_headers;
+
+    return true;
+  }
+
+  /**
+   * @author https://github.com/SigmaEG/Arcus/Arcus
+   * @brief Scans the contents of `arcus.pkgs` for headers and body locations, following the same rules as `parse(...)`
+   * 
+   * @param data > Contents of `arcus.pkgs` (lines are null-terminated in place)
+   * @param data_len > Amount of bytes in `data`
+   * @param index_out > Receives the location of every body
+   * @param size_out > Receives the amount of elements in `return`
+   * 
+   * @return `char***` - > A 2D C-Style String Array of headers with NULL bodies
+  */
+  static
+  char***
+  scan_pkgs(
+    char* data,
+    const int64_t data_len,
+    arcus_index_entry_t** index_out,
+    int32_t* size_out
+  ) {
+    char*** headers = NULL;
+    arcus_index_entry_t* index = NULL;
+    int32_t n_headers = 0;
+
+    bool parsing_package = false;
+    char* header = NULL;
+    int64_t pos = 0;
+
+    while (pos < data_len) {
+      char* line = data + pos;
+      char* newline = (char*)memchr(line, '\n', (size_t)(data_len - pos));
+      int64_t line_len = newline != NULL ? newline - line : data_len - pos;
+      int64_t line_offset = pos;
+
+      pos += line_len + 1;
+
+      // `arcus_getline(...)` reports an empty line as the end of the file
+      if (line_len == 0)
+        break;
+
+      line[line_len] = '\0';
+
+      if (strcmp(line, "{") == 0 || strcmp(line, "},") == 0) {
+        parsing_package = true;
+
+        continue;
+      }
+
+      if (strcmp(line, "}") == 0)
+        break;
+
+      if (!parsing_package)
+        continue;
+
+      if (header == NULL) {
+        header = (char*)calloc((size_t)line_len + 1, sizeof(char));
+
+        if (header != NULL) {
+          memcpy(header, line, (size_t)line_len);
+          strip_header(&header);
+        }
+
+        continue;
+      }
+
+      arcus_index_entry_t entry = { line_offset, (int32_t)line_len, package_manager(line) };
+
+      append_indexed_header(&headers, &index, &n_headers, header, entry);
+      header = NULL;
+    }
+
+    free(header);
+
+    *index_out = index;
+    *size_out = n_headers;
+
+    return headers;
+  }
+
+  /**
+   * @author https://github.com/SigmaEG/Arcus/Arcus
+   * @brief Loads the Package headers and body locations from `arcus.pkgs.idx`
+   * 
+   * @param index_path > Path of the index
+   * @param signature > First line the index must have to match the current `arcus.pkgs`
+   * @param index_out > Receives the location of every body
+   * @param size_out > Receives the amount of elements in `return`
+   * 
+   * @return `char***` - > A 2D C-Style String Array of headers with NULL bodies, or NULL if the index is missing, stale or malformed
+  */
+  static
+  char***
+  read_index(
+    const char* index_path,
+    const char* signature,
+    arcus_index_entry_t** index_out,
+    int32_t* size_out
+  ) {
+    FILE* file = fopen(index_path, "rb");
+
+    if (file == NULL)
+      return NULL;
+
+    int64_t data_len = 0;
+    char* data = read_stream(file, &data_len);
+
+    fclose(file);
+
+    if (data == NULL)
+      return NULL;
+
+    size_t signature_len = strlen(signature);
+
+    if ((size_t)data_len < signature_len || strncmp(data, signature, signature_len) != 0) {
+      free(data);
+
+      return NULL;
+    }
+
+    char*** headers = NULL;
+    arcus_index_entry_t* index = NULL;
+    int32_t n_headers = 0;
+    bool malformed = false;
+    char* cursor = data + signature_len;
+
+    while (*cursor != '\0' && !malformed) {
+      char* newline = strchr(cursor, '\n');
+
+      if (newline == NULL) {
+        malformed = true;
+
+        break;
+      }
+
+      *newline = '\0';
+
+      char* field = NULL;
+      long long offset = strtoll(cursor, &field, 10);
+      long length = *field == '\t' ? strtol(field + 1, &field, 10) : -1;
+      long manager = *field == '\t' ? strtol(field + 1, &field, 10) : -1;
+
+      if (*field != '\t' || offset < 0 || length < 0 || manager < ARCUS_MANAGER_PACMAN || manager > ARCUS_MANAGER_SELF) {
+        malformed = true;
+
+        break;
+      }
+
+      size_t header_len = strlen(field + 1);
+      char* header = (char*)calloc(header_len + 1, sizeof(char));
+      arcus_index_entry_t entry = { (int64_t)offset, (int32_t)length, (arcus_manager_t)manager };
+
+      if (header == NULL) {
+        malformed = true;
+
+        break;
+      }
+
+      memcpy(header, field + 1, header_len);
+
+      if (!append_indexed_header(&headers, &index, &n_headers, header, entry))
+        malformed = true;
+
+      cursor = newline + 1;
+    }
+
+    free(data);
+
+    if (malformed || n_headers == 0) {
+      free_char_2d(headers, &n_headers);
+      free(index);
+
+      return NULL;
+    }
+
+    *index_out = index;
+    *size_out = n_headers;
+
+    return headers;
+  }
+
+  /**
+   * @author https://github.com/SigmaEG/Arcus/Arcus
+   * @brief Persists Package headers and body locations to `arcus.pkgs.idx`, atomically replacing any previous index
+   * 
+   * @param index_path > Path of the index
+   * @param signature > First line identifying the `arcus.pkgs` the index was built from
+   * @param headers > 2D C-Style String Array of headers
+   * @param index > Location of every body
+   * @param n_headers > Amount of elements in `headers`
+   * 
+   * @return `void`
+   * @note Failing to write the index (e.g a read-only `arcus_config`) is not an error, it's rebuilt next time instead
+  */
+  static
+  void
+  write_index(
+    const char* index_path,
+    const char* signature,
+    char*** headers,
+    const arcus_index_entry_t* index,
+    const int32_t n_headers
+  ) {
+    char tmp_path[ARCUS_PATH_MAX + 32];
+
+    snprintf(tmp_path, sizeof(tmp_path), "%s.tmp", index_path);
+
+    FILE* file = fopen(tmp_path, "wb");
+
+    if (file == NULL)
+      return;
+
+    bool written = fputs(signature, file) >= 0;
+
+    for (int32_t pkg_idx = 0; pkg_idx < n_headers && written; ++pkg_idx) {
+      written = fprintf(
+        file,
+        "%lld\t%d\t%d\t%s\n",
+        (long long)index[pkg_idx].offset,
+        index[pkg_idx].length,
+        (int32_t)index[pkg_idx].manager,
+        headers[pkg_idx][0]
+      ) > 0;
+    }
+
+    if (fclose(file) != 0 || !written || rename(tmp_path, index_path) != 0)
+      remove(tmp_path);
+  }
+
+  /**
+   * @author https://github.com/SigmaEG/Arcus
+   * @brief Determines whether a file uses the line-oriented `header<TAB>body` format, by its extension
+   * 
+   * @param path > Path of the file
+   * 
+   * @return `bool` - > Whether `path` ends with `ARCUS_LINES_EXT`
+  */
+  static
+  bool
+  is_lines_file(const char* path) {
+    size_t path_len = strlen(path);
+    size_t ext_len = strlen(ARCUS_LINES_EXT);
+
+    return path_len > ext_len && strcmp(path + path_len - ext_len, ARCUS_LINES_EXT) == 0;
+  }
+
+  /**
+   * @author https://github.com/SigmaEG/Arcus
+   * @brief Resolves an Arcus file inside `config_dir`, preferring neither format over the other
+   * 
+   * @param name > Name of the file in the brace format (e.g `arcus.pkgs`)
+   * @param path_out > Receives `name` or `name` + `ARCUS_LINES_EXT`, whichever exists (`name` if neither does)
+   * @param path_size > Size of `path_out`
+   * 
+   * @return `bool` - > False if both formats exist, as it's ambiguous which one is meant
+  */
+  static
+  bool
+  resolve_config_file(
+    const char* name,
+    char* path_out,
+    const size_t path_size
+  ) {
+    snprintf(path_out, path_size, "%s/%s", config_dir, name);
+
+    size_t name_end = strlen(path_out);
+
+    snprintf(path_out + name_end, path_size - name_end, "%s", ARCUS_LINES_EXT);
+
+    if (!pathexists(path_out)) {
+      path_out[name_end] = '\0';
+
+      return true;
+    }
+
+    path_out[name_end] = '\0';
+
+    if (pathexists(path_out)) {
+      fprintf(stderr, "%s< BOTH %s AND %s" ARCUS_LINES_EXT " EXIST, REMOVE ONE OF THEM >\n", KRED, path_out, path_out);
+
+      return false;
+    }
+
+    snprintf(path_out + name_end, path_size - name_end, "%s", ARCUS_LINES_EXT);
+
+    return true;
+  }
+
+  /**
+   * @author https://github.com/SigmaEG/Arcus
+   * @brief Unescapes `\\`, `\t`, `\n` and `\r` in place
+   * 
+   * @param field > Field to unescape (not null-terminated)
+   * @param field_len > Amount of bytes in `field`
+   * 
+   * @return `int64_t` - > Length of the unescaped field, or -1 on an invalid escape
+  */
+  static
+  int64_t
+  unescape_field(
+    char* field,
+    const int64_t field_len
+  ) {
+    char* escape = (char*)memchr(field, '\\', (size_t)field_len);
+
+    if (escape == NULL)
+      return field_len;
+
+    int64_t out_len = escape - field;
+
+    for (int64_t in_idx = out_len; in_idx < field_len; ++in_idx) {
+      char character = field[in_idx];
+
+      if (character == '\\') {
+        if (++in_idx == field_len)
+          return -1;
+
+        switch (field[in_idx]) {
+          case '\\':
+            character = '\\';
+            break;
+          case 't':
+            character = '\t';
+            break;
+          case 'n':
+            character = '\n';
+            break;
+          case 'r':
+            character = '\r';
+            break;
+          default:
+            return -1;
+        }
+      }
+
+      field[out_len++] = character;
+    }
+
+    return out_len;
+  }
+
+  /**
+   * @author https://github.com/SigmaEG/Arcus
+   * @brief Finds the next `header<TAB>body` entry of a line-oriented file, skipping blank lines
+   * 
+   * @param data > Contents of the file
+   * @param data_len > Amount of bytes in `data`
+   * @param pos > Reference to the current offset in `data`, advanced past the entry
+   * @param line_no > Reference to the current line number, advanced past the entry
+   * @param header_out > Receives the start of the (escaped) header
+   * @param header_len_out > Receives the length of the (escaped) header
+   * @param body_out > Receives the start of the (escaped) body
+   * @param body_len_out > Receives the length of the (escaped) body
+   * 
+   * @return `int32_t` - > 1 if an entry was found, 0 at the end of `data` and -1 if the line has no tab or an empty header
+   * @note A trailing `\r` is treated as part of a CRLF line ending, a literal one in a body is written as `\r`.
+  */
+  static
+  int32_t
+  next_line_entry(
+    char* data,
+    const int64_t data_len,
+    int64_t* pos,
+    int32_t* line_no,
+    char** header_out,
+    int64_t* header_len_out,
+    char** body_out,
+    int64_t* body_len_out
+  ) {
+    while (*pos < data_len) {
+      char* line = data + *pos;
+      char* newline = (char*)memchr(line, '\n', (size_t)(data_len - *pos));
+      int64_t line_len = newline != NULL ? newline - line : data_len - *pos;
+
+      *pos += line_len + 1;
+      ++*line_no;
+
+      if (line_len > 0 && line[line_len - 1] == '\r')
+        --line_len;
+
+      if (line_len == 0)
+        continue;
+
+      char* tab = (char*)memchr(line, '\t', (size_t)line_len);
+
+      if (tab == NULL || tab == line)
+        return -1;
+
+      *header_out = line;
+      *header_len_out = tab - line;
+      *body_out = tab + 1;
+      *body_len_out = line + line_len - (tab + 1);
+
+      return 1;
+    }
+
+    return 0;
+  }
+
+  /**
+   * @author https://github.com/SigmaEG/Arcus
+   * @brief Parses the contents of a line-oriented Arcus file in a single pass
+   * 
+   * @param data > Contents of the file (unescaped in place)
+   * @param data_len > Amount of bytes in `data`
+   * @param path > Path of the file, for error messages
+   * @param size_out > Receives the amount of elements in `return`
+   * 
+   * @return `char***` - > A 2D C-Style String Array containing Arcus data, or NULL on a malformed line
+  */
+  static
+  char***
+  parse_lines(
+    char* data,
+    const int64_t data_len,
+    const char* path,
+    int32_t* size_out
+  ) {
+    char*** parsed_data = NULL;
+    int32_t data_size = 0;
+    int32_t data_capacity = 0;
+    int64_t pos = 0;
+    int32_t line_no = 0;
+    int32_t found = 0;
+    char* header = NULL;
+    char* body = NULL;
+    int64_t header_len = 0;
+    int64_t body_len = 0;
+
+    while ((found = next_line_entry(data, data_len, &pos, &line_no, &header, &header_len, &body, &body_len)) == 1) {
+      header_len = unescape_field(header, header_len);
+      body_len = unescape_field(body, body_len);
+
+      if (header_len < 0 || body_len < 0) {
+        found = -1;
+
+        break;
+      }
+
+      if (data_size == data_capacity) {
+        int32_t new_capacity = data_capacity == 0 ? 64 : data_capacity * 2;
+        char*** re_alloc = (char***)realloc(parsed_data, new_capacity * sizeof(char**));
+
+        if (re_alloc == NULL)
+          break;
+
+        parsed_data = re_alloc;
+        data_capacity = new_capacity;
+      }
+
+      char** row = (char**)calloc(2, sizeof(char*));
+
+      if (row != NULL) {
+        row[0] = (char*)calloc((size_t)header_len + 1, sizeof(char));
+        row[1] = (char*)calloc((size_t)body_len + 1, sizeof(char));
+      }
+
+      if (row == NULL || row[0] == NULL || row[1] == NULL) {
+        if (row != NULL) {
+          free(row[0]);
+          free(row[1]);
+        }
+
+        free(row);
+
+        break;
+      }
+
+      memcpy(row[0], header, (size_t)header_len);
+      memcpy(row[1], body, (size_t)body_len);
+      parsed_data[data_size++] = row;
+    }
+
+    if (found == -1) {
+      fprintf(stderr, "%s< MALFORMED LINE %d IN %s >\n", KRED, line_no, path);
+      free_char_2d(parsed_data, &data_size);
+      parsed_data = NULL;
+    }
+
+    if (size_out != NULL)
+      *size_out = data_size;
+
+    return parsed_data;
+  }
+
+  /**
+   * @author https://github.com/SigmaEG/Arcus
+   * @brief Parses an Arcus file in whichever format its extension denotes
+   * 
+   * @param path > Path of the file
+   * @param size_out > Reference to an `int32_t` that will store the amount of elements in `return`
+   * 
+   * @return `char***` - > A 2D C-Style String Array containing Arcus data, or NULL on failure
+  */
+  static
+  char***
+  parse_file(
+    const char* path,
+    int32_t* size_out
+  ) {
+    int64_t start_ns = stats.enabled ? stats_now_ns() : 0;
+    int64_t bytes_before = stats.bytes_read;
+    char*** parsed_data = NULL;
+
+    if (!is_lines_file(path)) {
+      parsed_data = parse(fopen(path, "r"), size_out);
+    } else {
+      FILE* file = fopen(path, "rb");
+      int64_t data_len = 0;
+      char* data = file != NULL ? read_stream(file, &data_len) : NULL;
+
+      if (file != NULL)
+        fclose(file);
+
+      if (data != NULL)
+        parsed_data = parse_lines(data, data_len, path, size_out);
+
+      free(data);
+    }
+
+    record_parse(path, start_ns, bytes_before);
+
+    return parsed_data;
+  }
+
+  /**
+   * @author https://github.com/SigmaEG/Arcus
+   * @brief Scans the contents of `arcus.pkgs.tsv` for headers and body locations
+   * 
+   * @param data > Contents of `arcus.pkgs.tsv` (unescaped in place once located)
+   * @param data_len > Amount of bytes in `data`
+   * @param path > Path of the file, for error messages
+   * @param index_out > Receives the location of every (escaped) body
+   * @param size_out > Receives the amount of elements in `return`
+   * 
+   * @return `char***` - > A 2D C-Style String Array of headers with NULL bodies, or NULL on a malformed line
+  */
+  static
+  char***
+  scan_lines(
+    char* data,
+    const int64_t data_len,
+    const char* path,
+    arcus_index_entry_t** index_out,
+    int32_t* size_out
+  ) {
+    char*** headers = NULL;
+    arcus_index_entry_t* index = NULL;
+    int32_t n_headers = 0;
+    int64_t pos = 0;
+    int32_t line_no = 0;
+    int32_t found = 0;
+    char* header = NULL;
+    char* body = NULL;
+    int64_t header_len = 0;
+    int64_t body_len = 0;
+
+    while ((found = next_line_entry(data, data_len, &pos, &line_no, &header, &header_len, &body, &body_len)) == 1) {
+      arcus_index_entry_t entry = { body - data, (int32_t)body_len, ARCUS_MANAGER_SELF };
+
+      header_len = unescape_field(header, header_len);
+      body_len = unescape_field(body, body_len);
+
+      if (header_len < 0 || body_len < 0) {
+        found = -1;
+
+        break;
+      }
+
+      char* header_copy = (char*)calloc((size_t)header_len + 1, sizeof(char));
+
+      if (header_copy == NULL)
+        break;
+
+      memcpy(header_copy, header, (size_t)header_len);
+      body[body_len] = '\0';
+      entry.manager = package_manager(body);
+
+      append_indexed_header(&headers, &index, &n_headers, header_copy, entry);
+    }
+
+    if (found == -1) {
+      fprintf(stderr, "%s< MALFORMED LINE %d IN %s >\n", KRED, line_no, path);
+      free_char_2d(headers, &n_headers);
+      free(index);
+      headers = NULL;
+      index = NULL;
+    }
+
+    *index_out = index;
+    *size_out = n_headers;
+
+    return headers;
+  }
+
+  /**
+   * @author https://github.com/SigmaEG/Arcus
+   * @brief Writes a field of a line-oriented Arcus file, escaping `\`, tabs and line breaks
+   * 
+   * @param out > Stream to write to
+   * @param field > Field to write
+   * 
+   * @return `void`
+  */
+  static
+  void
+  write_escaped(
+    FILE* out,
+    const char* field
+  ) {
+    while (*field != '\0') {
+      size_t run = strcspn(field, "\\\t\n\r");
+
+      fwrite(field, 1, run, out);
+      field += run;
+
+      if (*field == '\0')
+        break;
+
+      fputc('\\', out);
+      fputc(*field == '\t' ? 't' : *field == '\n' ? 'n' : *field == '\r' ? 'r' : '\\', out);
+      ++field;
+    }
+  }
+
+  /**
+   * @author https://github.com/SigmaEG/Arcus
+   * @brief Determines whether an entry survives being written in the brace format and parsed back by `parse(...)`
+   * 
+   * @param header > Header of the entry
+   * @param body > Body of the entry
+   * 
+   * @return `bool` - > Whether stripping the written lines yields `header` and `body` unchanged
+  */
+  static
+  bool
+  brace_representable(
+    const char* header,
+    const char* body
+  ) {
+    if (strchr(header, '\n') != NULL || strchr(body, '\n') != NULL)
+      return false;
+
+    size_t header_size = strlen(header) + 6;
+    size_t body_size = strlen(body) + 5;
+    char* header_line = (char*)calloc(header_size, sizeof(char));
+    char* body_line = (char*)calloc(body_size, sizeof(char));
+    bool representable = false;
+
+    if (header_line != NULL && body_line != NULL) {
+      snprintf(header_line, header_size, "  \"%s\",", header);
+      snprintf(body_line, body_size, "  \"%s\"", body);
+      strip_header(&header_line);
+      strip_body(&body_line);
+
+      representable = strcmp(header_line, header) == 0 && strcmp(body_line, body) == 0;
+    }
+
+    free(header_line);
+    free(body_line);
+
+    return representable;
+  }
+
+  #if defined(__unix__) || defined(__linux__)
+    /**
+     * @author https://github.com/SigmaEG/Arcus
+     * @brief Resolves the Unix socket of `arcusd`
+     * 
+     * @param path_out > Receives `$ARCUS_DAEMON_SOCKET`, or `ARCUS_DAEMON_SOCKET` for `uid`
+     * @param path_size > Size of `path_out`
+     * @param uid > User whose `arcusd` to use, root's serves every user
+     * 
+     * @return `bool` - > Whether the path came from `$ARCUS_DAEMON_SOCKET`
+    */
+    static
+    bool
+    daemon_socket_path(
+      char* path_out,
+      const size_t path_size,
+      const uid_t uid
+    ) {
+      const char* socket_path = getenv("ARCUS_DAEMON_SOCKET");
+
+      if (socket_path != NULL && socket_path[0] != '\0') {
+        snprintf(path_out, path_size, "%s", socket_path);
+
+        return true;
+      }
+
+      snprintf(path_out, path_size, ARCUS_DAEMON_SOCKET, (unsigned long)uid);
+
+      return false;
+    }
+
+    /**
+     * @author https://github.com/SigmaEG/Arcus
+     * @brief Identifies the configuration files in `config_dir` by path, size and modification time
+     * 
+     * @param signature_out > Receives the signature
+     * @param signature_size > Size of `signature_out`
+     * 
+     * @return `void`
+    */
+    static
+    void
+    daemon_config_signature(
+      char* signature_out,
+      const size_t signature_size
+    ) {
+      const char* names[] = { "arcus.pkgs", "arcus.envs", "arcus.limits" };
+      size_t used = 0;
+
+      signature_out[0] = '\0';
+
+      for (size_t name_idx = 0; name_idx < sizeof(names) / sizeof(names[0]) && used < signature_size; ++name_idx) {
+        char path[ARCUS_PATH_MAX];
+        struct stat info;
+        long long size = -1;
+        long long mtime = 0;
+        long mtime_nsec = 0;
+
+        if (resolve_config_file(names[name_idx], path, sizeof(path)) && stat(path, &info) == 0) {
+          size = (long long)info.st_size;
+          mtime = (long long)info.st_mtime;
+
+          #if defined(__linux__)
+            mtime_nsec = info.st_mtim.tv_nsec;
+          #endif
+        }
+
+        int32_t written = snprintf(signature_out + used, signature_size - used, "%s %lld %lld %ld\n", path, size, mtime, mtime_nsec);
+
+        if (written < 0)
+          break;
+
+        used += (size_t)written;
+      }
+    }
+
+    /**
+     * @author https://github.com/SigmaEG/Arcus
+     * @brief (Re)loads the configuration `arcusd` installs from, exporting its environment variables to every body
+     * 
+     * @param daemon > State of the daemon, its batch results are reset
+     * 
+     * @return `bool` - > Whether the Package and Environment Variable databases (and resource limits) were parsed
+    */
+    static
+    bool
+    load_daemon_config(arcus_daemon_t* daemon) {
+      if (packages != NULL) {
+        init_env_args(true);
+        free_config();
+      }
+
+      load_config(false);
+
+      if (packages == NULL || env_args == NULL || !load_limits()) {
+        free_config();
+
+        return false;
+      }
+
+      int32_t* results = (int32_t*)realloc(daemon->results, (n_packages > 0 ? n_packages : 1) * sizeof(int32_t));
+
+      if (results == NULL) {
+        free_config();
+
+        return false;
+      }
+
+      daemon->results = results;
+
+      for (int32_t pkg_idx = 0; pkg_idx < n_packages; ++pkg_idx)
+        daemon->results[pkg_idx] = ARCUS_DAEMON_NOT_RUN;
+
+      init_env_args(false);
+      set_env("ARCUS_ROOT", "/");
+      daemon_config_signature(daemon->signature, sizeof(daemon->signature));
+
+      return true;
+    }
+
+    /**
+     * @author https://github.com/SigmaEG/Arcus
+     * @brief Writes a length-prefixed `<KEYWORD> <len>\n<bytes>` field of the daemon protocol, which may contain any byte
+     * 
+     * @param fd > File descriptor to write to
+     * @param keyword > Keyword of the field
+     * @param data > Contents of the field
+     * @param length > Amount of bytes in `data`
+     * 
+     * @return `bool` - > Whether the field was written
+    */
+    static
+    bool
+    write_daemon_field(
+      const int32_t fd,
+      const char* keyword,
+      const char* data,
+      const size_t length
+    ) {
+      char line[64];
+
+      snprintf(line, sizeof(line), "%s %lu\n", keyword, (unsigned long)length);
+
+      return write_all(fd, line, strlen(line)) && write_all(fd, data, length);
+    }
+
+    /**
+     * @author https://github.com/SigmaEG/Arcus
+     * @brief Disconnects a client of `arcusd`
+     * 
+     * @param daemon > State of the daemon
+     * @param client_idx > Index of the client in `daemon->clients` (the last client takes its place)
+     * @param reason > Logged with the client's process ID
+     * 
+     * @return `void`
+    */
+    static
+    void
+    drop_daemon_client(
+      arcus_daemon_t* daemon,
+      const int32_t client_idx,
+      const char* reason
+    ) {
+      arcus_daemon_client_t* client = &daemon->clients[client_idx];
+
+      printf("%s< arcusd : CLIENT %lld %s >\n", KBLU, (long long)client->pid, reason);
+
+      close(client->fd);
+      free(client->wanted);
+      *client = daemon->clients[--daemon->n_clients];
+    }
+
+    /**
+     * @author https://github.com/SigmaEG/Arcus
+     * @brief Sends the result of a Package to a client of `arcusd`, disconnecting it once it has every result it asked for
+     * 
+     * @param daemon > State of the daemon
+     * @param client_idx > Index of the client in `daemon->clients`
+     * @param pkg_idx > Index of the Package in `packages`
+     * @param shared > Whether the Package ran for another client (its output wasn't sent to this one)
+     * 
+     * @return `bool` - > Whether the client is still connected
+    */
+    static
+    bool
+    send_daemon_result(
+      arcus_daemon_t* daemon,
+      const int32_t client_idx,
+      const int32_t pkg_idx,
+      const bool shared
+    ) {
+      arcus_daemon_client_t* client = &daemon->clients[client_idx];
+      size_t result_size = strlen(packages[pkg_idx][0]) + 32;
+      char* result = (char*)calloc(result_size, sizeof(char));
+      bool sent = result != NULL;
+
+      if (sent) {
+        snprintf(result, result_size, "%d\t%s\t%s", daemon->results[pkg_idx], shared ? "shared" : "ran", packages[pkg_idx][0]);
+        sent = write_daemon_field(client->fd, "RESULT", result, strlen(result));
+        free(result);
+      }
+
+      client->wanted[pkg_idx] = false;
+      --client->pending;
+
+      if (!sent) {
+        drop_daemon_client(daemon, client_idx, "DISCONNECTED");
+
+        return false;
+      }
+
+      if (client->pending == 0) {
+        write_all(client->fd, "DONE\n", 5);
+        drop_daemon_client(daemon, client_idx, "FINISHED");
+
+        return false;
+      }
+
+      return true;
+    }
+
+    /**
+     * @author https://github.com/SigmaEG/Arcus
+     * @brief Frees the ignore list received from a client of `arcusd`
+     * 
+     * @param ignore > Ignore list, entries that weren't received are NULL
+     * @param n_ignore > Number of elements in `ignore`
+     * 
+     * @return `void`
+    */
+    static
+    void
+    free_daemon_ignores(
+      char** ignore,
+      const long n_ignore
+    ) {
+      for (long ignore_idx = 0; ignore != NULL && ignore_idx < n_ignore; ++ignore_idx)
+        free(ignore[ignore_idx]);
+
+      free(ignore);
+    }
+
+    #if defined(__linux__)
+      /**
+       * @author https://github.com/SigmaEG/Arcus
+       * @brief Checks whether the peer of a connection was a member of `group` when it connected
+       * 
+       * @param conn_fd > Connection to `arcusd`
+       * @param peer > Credentials of the peer
+       * @param group > Group to look for
+       * 
+       * @return `bool` - > true if `group` is the peer's primary or a supplementary group, false otherwise
+      */
+      static
+      bool
+      daemon_peer_in_group(
+        const int32_t conn_fd,
+        const struct ucred* peer,
+        const gid_t group
+      ) {
+        if (peer->gid == group)
+          return true;
+
+        #if defined(SO_PEERGROUPS)
+          gid_t groups[256];
+          socklen_t groups_len = sizeof(groups);
+
+          if (getsockopt(conn_fd, SOL_SOCKET, SO_PEERGROUPS, groups, &groups_len) != 0)
+            return false;
+
+          for (size_t group_idx = 0; group_idx < groups_len / sizeof(gid_t); ++group_idx) {
+            if (groups[group_idx] == group)
+              return true;
+          }
+        #else
+          (void)conn_fd;
+        #endif
+
+        return false;
+      }
+    #endif
+
+    /**
+     * @author https://github.com/SigmaEG/Arcus
+     * @brief Accepts a connection on the socket of `arcusd`, its request is then read by `read_daemon_request(...)` as it arrives
+     * 
+     * @param daemon > State of the daemon
+     * 
+     * @return `void`
+     * @note Only the daemon's own user, root and members of its `--group` are accepted.
+    */
+    static
+    void
+    accept_daemon_client(arcus_daemon_t* daemon) {
+      int32_t conn_fd = accept(daemon->listen_fd, NULL, NULL);
+
+      if (conn_fd < 0)
+        return;
+
+      fcntl(conn_fd, F_SETFD, FD_CLOEXEC);
+
+      // A client that stalls its reads can't hold up every other client for longer than this
+      struct timeval timeout = { ARCUS_DAEMON_IO_TIMEOUT, 0 };
+
+      setsockopt(conn_fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+
+      int64_t peer_pid = -1;
+      bool trusted = true;
+
+      #if defined(__linux__)
+        struct ucred peer;
+        socklen_t peer_len = sizeof(peer);
+
+        trusted = getsockopt(conn_fd, SOL_SOCKET, SO_PEERCRED, &peer, &peer_len) == 0 
+          && (peer.uid == getuid() || peer.uid == 0 || (daemon->group >= 0 && daemon_peer_in_group(conn_fd, &peer, (gid_t)daemon->group)));
+
+        if (trusted)
+          peer_pid = (int64_t)peer.pid;
+      #endif
+
+      arcus_daemon_request_t* requests = trusted && fcntl(conn_fd, F_SETFL, fcntl(conn_fd, F_GETFL) | O_NONBLOCK) == 0
+        ? (arcus_daemon_request_t*)realloc(daemon->requests, (daemon->n_requests + 1) * sizeof(arcus_daemon_request_t))
+        : NULL;
+
+      if (requests == NULL) {
+        const char* error = trusted ? "MEMORY" : "PEER";
+        char line[64];
+
+        snprintf(line, sizeof(line), "ERROR %s\n", error);
+        write_all(conn_fd, line, strlen(line));
+        printf("%s< arcusd : REJECTED CLIENT %lld (%s) >\n", KYEL, (long long)peer_pid, error);
+        close(conn_fd);
+
+        return;
+      }
+
+      daemon->requests = requests;
+      daemon->requests[daemon->n_requests++] = (arcus_daemon_request_t){ conn_fd, peer_pid, NULL, 0, stats_now_ns() + (int64_t)ARCUS_DAEMON_IO_TIMEOUT * 1000000000 };
+    }
+
+    /**
+     * @author https://github.com/SigmaEG/Arcus
+     * @brief Takes a `\n`-terminated line of a buffered daemon request
+     * 
+     * @param request > Request read so far
+     * @param pos > Offset in `request->data`, advanced past the line
+     * @param line > Receives the line without its `\n`
+     * @param size > Size of `line`
+     * 
+     * @return `int32_t` - > 1 once taken, 0 if the line hasn't fully arrived, -1 if it's too long
+    */
+    static
+    int32_t
+    take_request_line(
+      const arcus_daemon_request_t* request,
+      size_t* pos,
+      char* line,
+      const size_t size
+    ) {
+      const char* start = request->data + *pos;
+      const char* newline = (const char*)memchr(start, '\n', request->used - *pos);
+
+      if (newline == NULL)
+        return request->used - *pos >= size ? -1 : 0;
+
+      size_t length = (size_t)(newline - start);
+
+      if (length >= size)
+        return -1;
+
+      memcpy(line, start, length);
+      line[length] = '\0';
+      *pos += length + 1;
+
+      return 1;
+    }
+
+    /**
+     * @author https://github.com/SigmaEG/Arcus
+     * @brief Takes a length-prefixed `<KEYWORD> <len>\n<bytes>` field of a buffered daemon request, see `read_protocol_field(...)`
+     * 
+     * @param request > Request read so far
+     * @param pos > Offset in `request->data`, advanced past the field
+     * @param keyword > Keyword the field must start with
+     * @param field_out > Receives the NUL-terminated field contents
+     * 
+     * @return `int32_t` - > 1 once taken, 0 if the field hasn't fully arrived, -1 on a protocol violation (or when out of memory)
+    */
+    static
+    int32_t
+    take_request_field(
+      const arcus_daemon_request_t* request,
+      size_t* pos,
+      const char* keyword,
+      char** field_out
+    ) {
+      char line[64];
+      size_t keyword_len = strlen(keyword);
+      size_t field_pos = *pos;
+      int32_t taken = take_request_line(request, &field_pos, line, sizeof(line));
+
+      if (taken <= 0)
+        return taken;
+
+      if (strncmp(line, keyword, keyword_len) != 0 || line[keyword_len] != ' ')
+        return -1;
+
+      char* end = NULL;
+      long length = strtol(line + keyword_len + 1, &end, 10);
+
+      if (end == line + keyword_len + 1 || *end != '\0' || length < 0 || length > ARCUS_HELPER_MAX_FIELD)
+        return -1;
+
+      if (request->used - field_pos < (size_t)length)
+        return 0;
+
+      if (memchr(request->data + field_pos, '\0', (size_t)length) != NULL || (*field_out = (char*)calloc((size_t)length + 1, sizeof(char))) == NULL)
+        return -1;
+
+      memcpy(*field_out, request->data + field_pos, (size_t)length);
+      *pos = field_pos + (size_t)length;
+
+      return 1;
+    }
+
+    /**
+     * @author https://github.com/SigmaEG/Arcus
+     * @brief Parses a buffered `arcus install` request, see `run_daemon(...)` for the protocol
+     * 
+     * @param request > Request read so far
+     * @param config_out > Receives the configuration directory of the client
+     * @param ignore_out > Receives the ignore list of the client
+     * @param n_ignore_out > Receives the number of elements in `ignore_out`
+     * 
+     * @return `int32_t` - > 1 once the whole request arrived, 0 if more is needed, -1 on a protocol violation (nothing is returned through the pointers unless 1)
+    */
+    static
+    int32_t
+    parse_daemon_request(
+      const arcus_daemon_request_t* request,
+      char** config_out,
+      char*** ignore_out,
+      long* n_ignore_out
+    ) {
+      char line[64];
+      size_t pos = 0;
+      char* config = NULL;
+      char** ignore = NULL;
+      long n_ignore = 0;
+      int32_t parsed = take_request_line(request, &pos, line, sizeof(line));
+
+      if (parsed > 0 && strcmp(line, ARCUS_DAEMON_PROTOCOL " INSTALL") != 0)
+        parsed = -1;
+
+      if (parsed > 0)
+        parsed = take_request_field(request, &pos, "CONFIG", &config);
+
+      if (parsed > 0 && (parsed = take_request_line(request, &pos, line, sizeof(line))) > 0) {
+        char* end = NULL;
+
+        if (strncmp(line, "IGNORES ", 8) == 0)
+          n_ignore = strtol(line + 8, &end, 10);
+
+        if (end == NULL || end == line + 8 || *end != '\0' || n_ignore < 0 || n_ignore > n_packages + ARCUS_HELPER_MAX_ARGS)
+          parsed = -1;
+      }
+
+      if (parsed > 0 && n_ignore > 0 && (ignore = (char**)calloc((size_t)n_ignore, sizeof(char*))) == NULL)
+        parsed = -1;
+
+      for (long ignore_idx = 0; parsed > 0 && ignore_idx < n_ignore; ++ignore_idx)
+        parsed = take_request_field(request, &pos, "IGNORE", &ignore[ignore_idx]);
+
+      if (parsed > 0 && (parsed = take_request_line(request, &pos, line, sizeof(line))) > 0 && strcmp(line, "END") != 0)
+        parsed = -1;
+
+      if (parsed <= 0) {
+        free(config);
+        free_daemon_ignores(ignore, n_ignore);
+
+        return parsed;
+      }
+
+      *config_out = config;
+      *ignore_out = ignore;
+      *n_ignore_out = n_ignore;
+
+      return 1;
+    }
+
+    /**
+     * @author https://github.com/SigmaEG/Arcus
+     * @brief Removes a request from `daemon->requests`, rejecting it unless `error` is NULL
+     * 
+     * @param daemon > State of the daemon
+     * @param request_idx > Index of the request (the last request takes its place)
+     * @param error > Sent to the client and logged, NULL if its connection was handed on and stays open
+     * 
+     * @return `void`
+    */
+    static
+    void
+    drop_daemon_request(
+      arcus_daemon_t* daemon,
+      const int32_t request_idx,
+      const char* error
+    ) {
+      arcus_daemon_request_t* request = &daemon->requests[request_idx];
+
+      if (error != NULL) {
+        char line[64];
+
+        snprintf(line, sizeof(line), "ERROR %s\n", error);
+        write_all(request->fd, line, strlen(line));
+        printf("%s< arcusd : REJECTED CLIENT %lld (%s) >\n", KYEL, (long long)request->pid, error);
+        close(request->fd);
+      }
+
+      free(request->data);
+      *request = daemon->requests[--daemon->n_requests];
+    }
+
+    /**
+     * @author https://github.com/SigmaEG/Arcus
+     * @brief Adds a client whose request fully arrived to the current batch
+     * 
+     * @param daemon > State of the daemon
+     * @param conn_fd > Connection of the client, closed if it is rejected
+     * @param peer_pid > Process ID of the client, -1 if unknown
+     * @param config > Configuration directory the client installs from
+     * @param ignore > Ignore list of the client (freed)
+     * @param n_ignore > Number of elements in `ignore`
+     * 
+     * @return `void`
+    */
+    static
+    void
+    admit_daemon_client(
+      arcus_daemon_t* daemon,
+      const int32_t conn_fd,
+      const int64_t peer_pid,
+      const char* config,
+      char** ignore,
+      const long n_ignore
+    ) {
+      char line[64];
+      const char* error = NULL;
+
+      // Bodies only ever come from the daemon's own configuration, a client merely picks which of them it wants
+      if (strcmp(config, daemon->config_real) != 0)
+        error = "CONFIG";
+
+      if (error == NULL) {
+        char signature[sizeof(daemon->signature)];
+
+        daemon_config_signature(signature, sizeof(signature));
+
+        if (strcmp(signature, daemon->signature) != 0) {
+          if (daemon->n_clients > 0 || daemon->installing)
+            error = "BUSY";
+          else if (load_daemon_config(daemon))
+            printf("%s< arcusd : RELOADED %d PACKAGE(S) FROM %s%s%s >\n", KBLU, n_packages, KMAG, config_dir, KBLU);
+          else {
+            fprintf(stderr, "%s< arcusd : FAILED TO RELOAD CONFIGURATION FROM %s >\n", KRED, config_dir);
+            cancel_signal = SIGTERM;
+            error = "CONFIG";
+          }
+        }
+      }
+
+      arcus_daemon_client_t client = { conn_fd, peer_pid, NULL, 0, false };
+      arcus_daemon_client_t* clients = NULL;
+
+      if (error == NULL && n_packages > 0 && (client.wanted = (bool*)calloc(n_packages, sizeof(bool))) == NULL)
+        error = "MEMORY";
+
+      if (error == NULL && (clients = (arcus_daemon_client_t*)realloc(daemon->clients, (daemon->n_clients + 1) * sizeof(arcus_daemon_client_t))) == NULL)
+        error = "MEMORY";
+
+      if (error != NULL) {
+        snprintf(line, sizeof(line), "ERROR %s\n", error);
+        write_all(conn_fd, line, strlen(line));
+        printf("%s< arcusd : REJECTED CLIENT %lld (%s) >\n", KYEL, (long long)peer_pid, error);
+        close(conn_fd);
+        free(client.wanted);
+        free_daemon_ignores(ignore, n_ignore);
+
+        return;
+      }
+
+      int32_t n_wanted = 0;
+
+      for (int32_t pkg_idx = 0; pkg_idx < n_packages; ++pkg_idx) {
+        if (is_ignored(packages[pkg_idx][0], (const char**)ignore, (int32_t)n_ignore))
+          continue;
+
+        client.wanted[pkg_idx] = true;
+        ++client.pending;
+        ++n_wanted;
+      }
+
+      free_daemon_ignores(ignore, n_ignore);
+
+      daemon->clients = clients;
+      daemon->clients[daemon->n_clients++] = client;
+
+      snprintf(line, sizeof(line), "ACCEPT %d\n", n_wanted);
+
+      int32_t client_idx = daemon->n_clients - 1;
+
+      printf("%s< arcusd : CLIENT %lld REQUESTED %d PACKAGE(S) >\n", KBLU, (long long)peer_pid, n_wanted);
+
+      if (!write_all(conn_fd, line, strlen(line))) {
+        drop_daemon_client(daemon, client_idx, "DISCONNECTED");
+
+        return;
+      }
+
+      if (n_wanted == 0) {
+        write_all(conn_fd, "DONE\n", 5);
+        drop_daemon_client(daemon, client_idx, "FINISHED");
+      }
+    }
+
+    /**
+     * @author https://github.com/SigmaEG/Arcus
+     * @brief Reads what arrived of a pending request without blocking, admitting its client once the request is complete
+     * 
+     * @param daemon > State of the daemon
+     * @param request_idx > Index of the request in `daemon->requests`
+     * 
+     * @return `void`
+    */
+    static
+    void
+    read_daemon_request(
+      arcus_daemon_t* daemon,
+      const int32_t request_idx
+    ) {
+      arcus_daemon_request_t* request = &daemon->requests[request_idx];
+      char chunk[4096];
+      ssize_t n_read = read(request->fd, chunk, sizeof(chunk));
+
+      if (n_read < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR))
+        return;
+
+      if (n_read <= 0) {
+        drop_daemon_request(daemon, request_idx, "PROTOCOL");
+
+        return;
+      }
+
+      char* data = request->used + (size_t)n_read <= ARCUS_DAEMON_MAX_REQUEST ? (char*)realloc(request->data, request->used + (size_t)n_read) : NULL;
+
+      if (data == NULL) {
+        drop_daemon_request(daemon, request_idx, request->used + (size_t)n_read > ARCUS_DAEMON_MAX_REQUEST ? "PROTOCOL" : "MEMORY");
+
+        return;
+      }
+
+      memcpy(data + request->used, chunk, (size_t)n_read);
+      request->data = data;
+      request->used += (size_t)n_read;
+
+      char* config = NULL;
+      char** ignore = NULL;
+      long n_ignore = 0;
+      int32_t parsed = parse_daemon_request(request, &config, &ignore, &n_ignore);
+
+      if (parsed < 0)
+        drop_daemon_request(daemon, request_idx, "PROTOCOL");
+
+      if (parsed <= 0)
+        return;
+
+      int32_t conn_fd = request->fd;
+      int64_t peer_pid = request->pid;
+
+      // Replies are written whole, bounded by the send timeout instead
+      drop_daemon_request(daemon, request_idx, NULL);
+      fcntl(conn_fd, F_SETFL, fcntl(conn_fd, F_GETFL) & ~O_NONBLOCK);
+      admit_daemon_client(daemon, conn_fd, peer_pid, config, ignore, n_ignore);
+      free(config);
+    }
+
+    /**
+     * @author https://github.com/SigmaEG/Arcus
+     * @brief Adds the listening socket and every pending request of `arcusd` to a poll set
+     * 
+     * @param daemon > State of the daemon
+     * @param events > Receives `1 + daemon->n_requests` entries
+     * 
+     * @return `nfds_t` - > Number of entries written
+    */
+    static
+    nfds_t
+    poll_daemon_sockets(
+      const arcus_daemon_t* daemon,
+      struct pollfd* events
+    ) {
+      events[0] = (struct pollfd){ daemon->listen_fd, POLLIN, 0 };
+
+      for (int32_t request_idx = 0; request_idx < daemon->n_requests; ++request_idx)
+        events[request_idx + 1] = (struct pollfd){ daemon->requests[request_idx].fd, POLLIN, 0 };
+
+      return (nfds_t)daemon->n_requests + 1;
+    }
+
+    /**
+     * @author https://github.com/SigmaEG/Arcus
+     * @brief Serves the entries `poll_daemon_sockets(...)` added once polled: reads pending requests, accepts new connections and rejects requests past their deadline
+     * 
+     * @param daemon > State of the daemon
+     * @param events > Entries written by `poll_daemon_sockets(...)`
+     * @param n_events > Number of entries
+     * 
+     * @return `void`
+    */
+    static
+    void
+    serve_daemon_sockets(
+      arcus_daemon_t* daemon,
+      const struct pollfd* events,
+      const nfds_t n_events
+    ) {
+      // Walking backwards, a request that's removed is replaced by one that was already served
+      for (int32_t request_idx = (int32_t)n_events - 2; request_idx >= 0; --request_idx) {
+        if (events[request_idx + 1].revents != 0)
+          read_daemon_request(daemon, request_idx);
+      }
+
+      int64_t now_ns = stats_now_ns();
+
+      for (int32_t request_idx = daemon->n_requests - 1; request_idx >= 0; --request_idx) {
+        if (daemon->requests[request_idx].deadline_ns < now_ns)
+          drop_daemon_request(daemon, request_idx, "TIMEOUT");
+      }
+
+      if (events[0].revents != 0)
+        accept_daemon_client(daemon);
+    }
+
+    /**
+     * @author https://github.com/SigmaEG/Arcus
+     * @brief Determines whether any client of `arcusd` still wants a Package
+     * 
+     * @param daemon > State of the daemon
+     * @param pkg_idx > Index of the Package in `packages`
+     * 
+     * @return `bool` - > Whether a client is waiting on the Package
+    */
+    static
+    bool
+    daemon_package_wanted(
+      const arcus_daemon_t* daemon,
+      const int32_t pkg_idx
+    ) {
+      for (int32_t client_idx = 0; client_idx < daemon->n_clients; ++client_idx) {
+        if (daemon->clients[client_idx].wanted[pkg_idx])
+          return true;
+      }
+
+      return false;
+    }
+
+    /**
+     * @author https://github.com/SigmaEG/Arcus
+     * @brief Determines whether a Package may run in a single invocation with others that have an identical body
+     * 
+     * @param pkg_idx > Index of the Package in `packages`
+     * 
+     * @return `bool` - > Whether the body installs `${ARCUS_PACKAGES}` through `pacman`, `yay` or `flatpak` without a resource budget
+    */
+    static
+    bool
+    daemon_package_mergeable(const int32_t pkg_idx) {
+      arcus_manager_t manager = package_manager_at(pkg_idx);
+
+      if (manager != ARCUS_MANAGER_PACMAN && manager != ARCUS_MANAGER_YAY && manager != ARCUS_MANAGER_FLATPAK)
+        return false;
+
+      if (package_limits != NULL && package_limits[pkg_idx].active)
+        return false;
+
+      return strstr(package_body(pkg_idx), "${ARCUS_PACKAGES}") != NULL;
+    }
+
+    /**
+     * @author https://github.com/SigmaEG/Arcus
+     * @brief Runs a Package for every client of `arcusd` that wants it, together with any Package it can be merged with
+     * 
+     * @param daemon > State of the daemon
+     * @param lead_idx > Index of the first Package to run
+     * @param merge > Whether Packages with an identical body may join the invocation
+     * 
+     * @return `void`
+     * @note A merged invocation that fails is retried one Package at a time, so every Package gets a result of its own. An invocation nobody waits on any more is terminated.
+    */
+    static
+    void
+    run_daemon_batch(
+      arcus_daemon_t* daemon,
+      const int32_t lead_idx,
+      const bool merge
+    ) {
+      int32_t* members = (int32_t*)calloc(n_packages, sizeof(int32_t));
+      int32_t n_members = 0;
+      size_t names_size = 1;
+      const char* body = package_body(lead_idx);
+
+      if (members == NULL)
+        return;
+
+      members[n_members++] = lead_idx;
+      names_size += strlen(packages[lead_idx][0]) + 1;
+
+      if (merge && daemon_package_mergeable(lead_idx)) {
+        for (int32_t pkg_idx = lead_idx + 1; pkg_idx < n_packages; ++pkg_idx) {
+          if (
+            daemon->results[pkg_idx] == ARCUS_DAEMON_NOT_RUN
+            && daemon_package_wanted(daemon, pkg_idx)
+            && daemon_package_mergeable(pkg_idx)
+            && strcmp(package_body(pkg_idx), body) == 0
+          ) {
+            members[n_members++] = pkg_idx;
+            names_size += strlen(packages[pkg_idx][0]) + 1;
+          }
+        }
+      }
+
+      char* names = (char*)calloc(names_size, sizeof(char));
+
+      if (names == NULL) {
+        free(members);
+
+        return;
+      }
+
+      for (int32_t member_idx = 0; member_idx < n_members; ++member_idx) {
+        if (member_idx > 0)
+          strcat(names, " ");
+
+        strcat(names, packages[members[member_idx]][0]);
+      }
+
+      for (int32_t client_idx = daemon->n_clients - 1; client_idx >= 0; --client_idx) {
+        arcus_daemon_client_t* client = &daemon->clients[client_idx];
+
+        client->attached = false;
+
+        for (int32_t member_idx = 0; member_idx < n_members && !client->attached; ++member_idx)
+          client->attached = client->wanted[members[member_idx]];
+
+        if (client->attached && !write_daemon_field(client->fd, "START", names, strlen(names)))
+          drop_daemon_client(daemon, client_idx, "DISCONNECTED");
+      }
+
+      printf("%s< arcusd : INSTALLING %s%s%s >\n", KBLU, KMAG, names, KBLU);
+      set_env("ARCUS_PACKAGES", names);
+      status_started(lead_idx + 1, names);
+
+      struct rusage usage_before;
+      int32_t fds[2] = { -1, -1 };
+      pid_t group = 0;
+      pid_t pid = -1;
+      bool foreground = false;
+      bool abandoned = false;
+      time_t abandoned_at = 0;
+      char* cached_body = NULL;
+      int32_t mirror_fd = begin_git_cache(body, false, &group, &cached_body);
+      bool installing = daemon->installing;
+
+      // A client can't reload the configuration out from under the running invocation
+      daemon->installing = true;
+      begin_package_limits(lead_idx, &usage_before);
+
+      if (pipe(fds) == 0) {
+        fcntl(fds[0], F_SETFD, FD_CLOEXEC);
+        active_groups = &group;
+        n_active_groups = 1;
+        pid = spawn_package(lead_idx, cached_body != NULL ? cached_body : body, fds[1], &group, &foreground);
+        close(fds[1]);
+      }
+
+      while (pid > 0) {
+        int32_t n_clients = daemon->n_clients;
+        struct pollfd* events = (struct pollfd*)calloc((size_t)n_clients + (size_t)daemon->n_requests + 2, sizeof(struct pollfd));
+
+        if (events == NULL)
+          break;
+
+        events[0].fd = fds[0];
+        events[0].events = POLLIN;
+
+        for (int32_t client_idx = 0; client_idx < n_clients; ++client_idx) {
+          events[client_idx + 1].fd = daemon->clients[client_idx].fd;
+          events[client_idx + 1].events = POLLIN;
+        }
+
+        nfds_t n_sockets = poll_daemon_sockets(daemon, events + n_clients + 1);
+        int32_t ready = poll(events, (nfds_t)n_clients + 1 + n_sockets, 1000);
+        bool finished = false;
+
+        if (ready < 0 && errno != EINTR) {
+          free(events);
+
+          break;
+        }
+
+        // Clients send nothing after their request, so anything readable is a disconnect
+        for (int32_t client_idx = n_clients - 1; ready > 0 && client_idx >= 0; --client_idx) {
+          char discard;
+
+          if (events[client_idx + 1].revents != 0 && read(daemon->clients[client_idx].fd, &discard, 1) <= 0)
+            drop_daemon_client(daemon, client_idx, "DISCONNECTED");
+        }
+
+        if (ready > 0 && events[0].revents != 0) {
+          static char buffer[ARCUS_RELAY_CHUNK];
+          ssize_t n_read = read(fds[0], buffer, sizeof(buffer));
+
+          if (n_read <= 0 && !(n_read < 0 && errno == EINTR))
+            finished = true;
+
+          for (int32_t client_idx = daemon->n_clients - 1; n_read > 0 && client_idx >= 0; --client_idx) {
+            if (daemon->clients[client_idx].attached && !write_daemon_field(daemon->clients[client_idx].fd, "OUTPUT", buffer, (size_t)n_read))
+              drop_daemon_client(daemon, client_idx, "DISCONNECTED");
+          }
+        }
+
+        serve_daemon_sockets(daemon, events + n_clients + 1, n_sockets);
+        free(events);
+
+        if (finished)
+          break;
+
+        bool attached = false;
+
+        for (int32_t client_idx = 0; client_idx < daemon->n_clients && !attached; ++client_idx) {
+          for (int32_t member_idx = 0; member_idx < n_members && !attached; ++member_idx)
+            attached = daemon->clients[client_idx].wanted[members[member_idx]];
+        }
+
+        if (!attached && !abandoned) {
+          printf("%s< arcusd : NO CLIENT WAITS ON %s%s%s ANY MORE, TERMINATING IT >\n", KYEL, KMAG, names, KYEL);
+          kill(-group, SIGTERM);
+          abandoned = true;
+          abandoned_at = time(NULL);
+        }
+
+        if (abandoned && time(NULL) - abandoned_at > cancel_grace)
+          kill(-group, SIGKILL);
+      }
+
+      if (fds[0] >= 0)
+        close(fds[0]);
+
+      int32_t status = pid > 0 ? wait_package(pid, &group, foreground) : -1;
+      const char* limit_reason = end_package_limits(lead_idx, status, &usage_before);
+
+      if (mirror_fd >= 0)
+        close(mirror_fd);
+
+      free(cached_body);
+
+      active_groups = NULL;
+      n_active_groups = 0;
+      daemon->installing = installing;
+      unsetenv("ARCUS_PACKAGES");
+
+      int32_t exit_code = status == -1 ? -1 : WIFEXITED(status) ? WEXITSTATUS(status) : 128 + WTERMSIG(status);
+
+      if (status != 0 && !abandoned)
+        printf("%s< arcusd : FAILED : %s (STATUS %d%s%s) >\n", KRED, names, exit_code, limit_reason != NULL ? ", " : "", limit_reason != NULL ? limit_reason : "");
+
+      bool retrying = n_members > 1 && status != 0 && !abandoned && cancel_signal == 0;
+
+      // A failed merged invocation isn't counted, its retries count each member on its own
+      for (int32_t member_idx = 0; member_idx < n_members && !retrying; ++member_idx) {
+        const char* state = abandoned || cancel_signal != 0 ? "cancelled" : status != 0 ? "failed" : "installed";
+
+        status_finished(packages[members[member_idx]][0], state, exit_code);
+      }
+
+      if (retrying) {
+        printf("%s< arcusd : RETRYING %s%s%s ONE AT A TIME >\n", KYEL, KMAG, names, KYEL);
+
+        for (int32_t member_idx = 0; member_idx < n_members && cancel_signal == 0; ++member_idx) {
+          if (daemon_package_wanted(daemon, members[member_idx]))
+            run_daemon_batch(daemon, members[member_idx], false);
+        }
+      } else if (!abandoned && cancel_signal == 0) {
+        for (int32_t member_idx = 0; member_idx < n_members; ++member_idx)
+          daemon->results[members[member_idx]] = status;
+
+        for (int32_t client_idx = daemon->n_clients - 1; client_idx >= 0; --client_idx) {
+          bool attached = daemon->clients[client_idx].attached;
+
+          for (int32_t member_idx = 0; member_idx < n_members; ++member_idx) {
+            if (daemon->clients[client_idx].wanted[members[member_idx]] && !send_daemon_result(daemon, client_idx, members[member_idx], !attached))
+              break;
+          }
+        }
+
+        // Only the clients waiting now share this result, one asking later gets a run of its own rather than a stale (or failed) result
+        for (int32_t member_idx = 0; member_idx < n_members; ++member_idx)
+          daemon->results[members[member_idx]] = ARCUS_DAEMON_NOT_RUN;
+      }
+
+      free(names);
+      free(members);
+    }
+
+    /**
+     * @author https://github.com/SigmaEG/Arcus
+     * @brief Installs the Packages of an `arcus install` through `arcusd`, if it's running
+     * 
+     * @param ignore > The ignore list to query
+     * @param n_ignore > Number of elements in `ignore`
+     * @param summary > Receives the outcome of the installation
+     * 
+     * @return `bool` - > False if there is no `arcusd` to use (or it declined the request), in which case nothing was installed
+    */
+    static
+    bool
+    install_through_daemon(
+      const char** ignore,
+      const int32_t n_ignore,
+      arcus_summary_t* summary
+    ) {
+      char socket_path[ARCUS_PATH_MAX];
+      char config_real[ARCUS_PATH_MAX];
+      struct sockaddr_un address;
+      struct stat info;
+
+      // Without an arcusd of our own, try the one root runs, which lets us connect only if it was started with a `--group` we are in
+      if (!daemon_socket_path(socket_path, sizeof(socket_path), getuid()) && lstat(socket_path, &info) != 0)
+        daemon_socket_path(socket_path, sizeof(socket_path), 0);
+
+      if (lstat(socket_path, &info) != 0 || !S_ISSOCK(info.st_mode))
+        return false;
+
+      // Anyone can create a socket in /tmp, only trust one that belongs to us (or root)
+      if ((info.st_uid != getuid() && info.st_uid != 0) || strlen(socket_path) >= sizeof(address.sun_path) || realpath(config_dir, config_real) == NULL) {
+        fprintf(stderr, "%s< IGNORING arcusd SOCKET : %s >\n", KYEL, socket_path);
+
+        return false;
+      }
+
+      memset(&address, 0, sizeof(address));
+      address.sun_family = AF_UNIX;
+      memcpy(address.sun_path, socket_path, strlen(socket_path));
+
+      int32_t conn_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+
+      if (conn_fd < 0 || connect(conn_fd, (struct sockaddr*)&address, sizeof(address)) != 0) {
+        if (conn_fd >= 0)
+          close(conn_fd);
+
+        return false;
+      }
+
+      #if defined(__linux__)
+        struct ucred peer;
+        socklen_t peer_len = sizeof(peer);
+
+        if (getsockopt(conn_fd, SOL_SOCKET, SO_PEERCRED, &peer, &peer_len) != 0 || (peer.uid != getuid() && peer.uid != 0)) {
+          fprintf(stderr, "%s< IGNORING arcusd SOCKET : %s >\n", KYEL, socket_path);
+          close(conn_fd);
+
+          return false;
+        }
+      #endif
+
+      signal(SIGPIPE, SIG_IGN);
+
+      char line[64];
+      const char greeting[] = ARCUS_DAEMON_PROTOCOL " INSTALL\n";
+      bool sent = write_all(conn_fd, greeting, sizeof(greeting) - 1) && write_protocol_field(conn_fd, "CONFIG", config_real);
+
+      snprintf(line, sizeof(line), "IGNORES %d\n", n_ignore);
+      sent = sent && write_all(conn_fd, line, strlen(line));
+
+      for (int32_t ignore_idx = 0; sent && ignore_idx < n_ignore; ++ignore_idx)
+        sent = write_protocol_field(conn_fd, "IGNORE", ignore[ignore_idx]);
+
+      sent = sent && write_all(conn_fd, "END\n", 4);
+
+      if (!sent || !read_protocol_line(conn_fd, line, sizeof(line)) || strncmp(line, "ACCEPT ", 7) != 0) {
+        fprintf(stderr, "%s< arcusd DECLINED THE INSTALLATION (%s), INSTALLING IN-PROCESS >\n\n", KYEL, sent && strncmp(line, "ERROR ", 6) == 0 ? line + 6 : "NO REPLY");
+        close(conn_fd);
+
+        return false;
+      }
+
+      printf("%s< INSTALLING THROUGH arcusd : %s%s%s >\n\n", KBLU, KMAG, socket_path, KBLU);
+
+      const char** states = n_packages > 0 ? (const char**)calloc(n_packages, sizeof(char*)) : NULL;
+      bool finished = false;
+
+      *summary = (arcus_summary_t){ 0, 0, 0, 0, false };
+
+      for (int32_t pkg_idx = 0; pkg_idx < n_packages; ++pkg_idx) {
+        if (is_ignored(packages[pkg_idx][0], ignore, n_ignore)) {
+          printf("%s< IGNORING : %s >\n", KYEL, packages[pkg_idx][0]);
+          ++summary->ignored;
+
+          if (states != NULL)
+            states[pkg_idx] = "ignored";
+        }
+      }
+
+      while (cancel_signal == 0) {
+        struct pollfd event = { conn_fd, POLLIN, 0 };
+
+        if (poll(&event, 1, -1) < 0)
+          continue;
+
+        if (!read_protocol_line(conn_fd, line, sizeof(line)))
+          break;
+
+        if (strcmp(line, "DONE") == 0) {
+          finished = true;
+
+          break;
+        }
+
+        char* length_str = strchr(line, ' ');
+        long length = length_str != NULL ? strtol(length_str + 1, NULL, 10) : -1;
+        char* field = length >= 0 && length <= ARCUS_HELPER_MAX_FIELD ? (char*)calloc((size_t)length + 1, sizeof(char)) : NULL;
+
+        if (field == NULL || !read_exact(conn_fd, field, (size_t)length)) {
+          free(field);
+
+          break;
+        }
+
+        *length_str = '\0';
+
+        if (strcmp(line, "START") == 0) {
+          printf("%s< INSTALLING : %s%s%s >\n", KBLU, KMAG, field, KBLU);
+          fflush(stdout);
+        } else if (strcmp(line, "OUTPUT") == 0) {
+          fflush(stdout);
+          write_all(STDOUT_FILENO, field, (size_t)length);
+        } else if (strcmp(line, "RESULT") == 0) {
+          char* shared = strchr(field, '\t');
+          char* pkg_name = shared != NULL ? strchr(shared + 1, '\t') : NULL;
+          int32_t ret = (int32_t)strtol(field, NULL, 10);
+
+          if (pkg_name != NULL) {
+            *pkg_name++ = '\0';
+
+            int32_t pkg_idx = 0;
+
+            while (pkg_idx < n_packages && (strcmp(packages[pkg_idx][0], pkg_name) != 0 || (states != NULL && states[pkg_idx] != NULL)))
+              ++pkg_idx;
+
+            if (ret != 0) {
+              ret = ret == -1 ? -1 : WIFEXITED(ret) ? WEXITSTATUS(ret) : 128 + WTERMSIG(ret);
+
+              fprintf(stderr, "%s< FAILED : %s (STATUS %d%s) >\n", KRED, pkg_name, ret, strcmp(shared + 1, "shared") == 0 ? ", SHARED" : "");
+              ++summary->failed;
+            } else {
+              if (strcmp(shared + 1, "shared") == 0)
+                printf("%s< INSTALLED BY ANOTHER arcusd CLIENT : %s%s%s >\n", KBLU, KMAG, pkg_name, KBLU);
+
+              ++summary->installed;
+            }
+
+            if (states != NULL && pkg_idx < n_packages)
+              states[pkg_idx] = ret != 0 ? "failed" : "installed";
+          }
+        }
+
+        free(field);
+      }
+
+      close(conn_fd);
+
+      if (!finished && cancel_signal != 0) {
+        printf("%s\n< CANCELLED : REQUEST TO arcusd >\n", KRED);
+        summary->interrupted = true;
+
+        if (states != NULL)
+          write_partial_results(states);
+      } else if (!finished) {
+        for (int32_t pkg_idx = 0; pkg_idx < n_packages; ++pkg_idx) {
+          if (states != NULL && states[pkg_idx] == NULL) {
+            fprintf(stderr, "%s< FAILED : %s (LOST CONNECTION TO arcusd) >\n", KRED, packages[pkg_idx][0]);
+            states[pkg_idx] = "failed";
+            ++summary->failed;
+          }
+        }
+      }
+
+      free(states);
+
+      return true;
+    }
+  #endif
+
+  /**
+   * @author https://github.com/SigmaEG/Arcus
+   * @brief Round constants of SHA-256
+  */
+  static const uint32_t sha256_rounds[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+  };
+
+  /**
+   * @author https://github.com/SigmaEG/Arcus
+   * @brief Starts a SHA-256 digest
+   * 
+   * @param digest > Digest to reset
+   * 
+   * @return `void`
+  */
+  static
+  void
+  sha256_init(arcus_sha256_t* digest) {
+    const uint32_t initial[8] = {
+      0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+    };
+
+    memcpy(digest->state, initial, sizeof(initial));
+    digest->length = 0;
+    digest->used = 0;
+  }
+
+  /**
+   * @author https://github.com/SigmaEG/Arcus
+   * @brief Mixes a full 64-byte block into a SHA-256 digest
+   * 
+   * @param digest > Digest to update
+   * @param block > Block to mix in
+   * 
+   * @return `void`
+  */
+  static
+  void
+  sha256_block(
+    arcus_sha256_t* digest,
+    const uint8_t* block
+  ) {
+    #define ARCUS_ROTR(value, bits) (((value) >> (bits)) | ((value) << (32 - (bits))))
+
+    uint32_t words[64];
+    uint32_t vars[8];
+
+    for (int32_t word_idx = 0; word_idx < 16; ++word_idx) {
+      words[word_idx] =
+        (uint32_t)block[word_idx * 4] << 24 | (uint32_t)block[word_idx * 4 + 1] << 16 |
+        (uint32_t)block[word_idx * 4 + 2] << 8 | (uint32_t)block[word_idx * 4 + 3];
+    }
+
+    for (int32_t word_idx = 16; word_idx < 64; ++word_idx) {
+      uint32_t s0 = ARCUS_ROTR(words[word_idx - 15], 7) ^ ARCUS_ROTR(words[word_idx - 15], 18) ^ (words[word_idx - 15] >> 3);
+      uint32_t s1 = ARCUS_ROTR(words[word_idx - 2], 17) ^ ARCUS_ROTR(words[word_idx - 2], 19) ^ (words[word_idx - 2] >> 10);
+
+      words[word_idx] = words[word_idx - 16] + s0 + words[word_idx - 7] + s1;
+    }
+
+    memcpy(vars, digest->state, sizeof(vars));
+
+    for (int32_t round_idx = 0; round_idx < 64; ++round_idx) {
+      uint32_t s1 = ARCUS_ROTR(vars[4], 6) ^ ARCUS_ROTR(vars[4], 11) ^ ARCUS_ROTR(vars[4], 25);
+      uint32_t choice = (vars[4] & vars[5]) ^ (~vars[4] & vars[6]);
+      uint32_t temp1 = vars[7] + s1 + choice + sha256_rounds[round_idx] + words[round_idx];
+      uint32_t s0 = ARCUS_ROTR(vars[0], 2) ^ ARCUS_ROTR(vars[0], 13) ^ ARCUS_ROTR(vars[0], 22);
+      uint32_t majority = (vars[0] & vars[1]) ^ (vars[0] & vars[2]) ^ (vars[1] & vars[2]);
+
+      memmove(vars + 1, vars, 7 * sizeof(uint32_t));
+      vars[4] += temp1;
+      vars[0] = temp1 + s0 + majority;
+    }
+
+    for (int32_t var_idx = 0; var_idx < 8; ++var_idx)
+      digest->state[var_idx] += vars[var_idx];
+
+    #undef ARCUS_ROTR
+  }
+
+  /**
+   * @author https://github.com/SigmaEG/Arcus
+   * @brief Feeds bytes into a SHA-256 digest
+   * 
+   * @param digest > Digest to update
+   * @param data > Bytes to hash
+   * @param length > Amount of bytes in `data`
+   * 
+   * @return `void`
+  */
+  static
+  void
+  sha256_update(
+    arcus_sha256_t* digest,
+    const void* data,
+    size_t length
+  ) {
+    const uint8_t* bytes = (const uint8_t*)data;
+
+    digest->length += length;
+
+    while (length > 0) {
+      size_t take = 64 - digest->used < length ? 64 - digest->used : length;
+
+      memcpy(digest->block + digest->used, bytes, take);
+      digest->used += take;
+      bytes += take;
+      length -= take;
+
+      if (digest->used == 64) {
+        sha256_block(digest, digest->block);
+        digest->used = 0;
+      }
+    }
+  }
+
+  /**
+   * @author https://github.com/SigmaEG/Arcus
+   * @brief Finishes a SHA-256 digest
+   * 
+   * @param digest > Digest to finish
+   * @param hex_out > Receives the 64 lowercase hex digits of the hash and a null-terminator
+   * 
+   * @return `void`
+  */
+  static
+  void
+  sha256_final(
+    arcus_sha256_t* digest,
+    char* hex_out
+  ) {
+    uint64_t bits = digest->length * 8;
+    uint8_t padding[72] = { 0x80 };
+    size_t pad_len = digest->used < 56 ? 56 - digest->used : 120 - digest->used;
+
+    for (int32_t byte_idx = 0; byte_idx < 8; ++byte_idx)
+      padding[pad_len + byte_idx] = (uint8_t)(bits >> (56 - 8 * byte_idx));
+
+    sha256_update(digest, padding, pad_len + 8);
+
+    for (int32_t word_idx = 0; word_idx < 8; ++word_idx)
+      snprintf(hex_out + word_idx * 8, 9, "%08x", (unsigned int)digest->state[word_idx]);
+  }
+
+  /**
+   * @author https://github.com/SigmaEG/Arcus
+   * @brief Computes the SHA-256 of a file's contents
+   * 
+   * @param path > File to hash
+   * @param hex_out > Receives the 64 lowercase hex digits of the hash and a null-terminator
+   * 
+   * @return `bool` - > Whether the file could be read in full
+  */
+  static
+  bool
+  sha256_file(
+    const char* path,
+    char* hex_out
+  ) {
+    FILE* file = fopen(path, "rb");
+
+    if (file == NULL)
+      return false;
+
+    static uint8_t buffer[ARCUS_RELAY_CHUNK];
+    arcus_sha256_t digest;
+    size_t n_read = 0;
+
+    sha256_init(&digest);
+
+    while ((n_read = fread(buffer, 1, sizeof(buffer), file)) > 0)
+      sha256_update(&digest, buffer, n_read);
+
+    bool read = !ferror(file);
+
+    fclose(file);
+
+    if (read)
+      sha256_final(&digest, hex_out);
+
+    return read;
+  }
+
+  /**
+   * @author https://github.com/SigmaEG/Arcus
+   * @brief Determines whether a package name, version or file name from `pacman` or `arcus.lock` is safe to pass through a shell
+   * 
+   * @param token > Text to check
+   * 
+   * @return `bool` - > Whether `token` is non-empty, doesn't start with `-` and only holds `[A-Za-z0-9@._+:~-]`
+  */
+  static
+  bool
+  lock_token_valid(const char* token) {
+    if (token == NULL || token[0] == '\0' || token[0] == '-' || strcmp(token, ".") == 0 || strcmp(token, "..") == 0)
+      return false;
+
+    for (const char* cursor = token; *cursor != '\0'; ++cursor) {
+      if (!isalnum((unsigned char)*cursor) && strchr("@._+:~-", *cursor) == NULL)
+        return false;
+    }
+
+    return true;
+  }
+
+  #if defined(__unix__) || defined(__linux__)
+    /**
+     * @author https://github.com/SigmaEG/Arcus
+     * @brief Runs a command under `/bin/sh -c` and collects its stdout
+     * 
+     * @param command > Commands to run
+     * @param pkg_name > Exported to the command as `ARCUS_PACKAGES` (may be NULL)
+     * @param status_out > Receives the wait status of the command
+     * 
+     * @return `char*` - > Everything the command wrote to stdout, to be `free(...)`'d by the caller, or NULL if it couldn't be started
+     * @note stdin is `/dev/null` and stderr is inherited, so errors reach the terminal
+    */
+    static
+    char*
+    capture_command(
+      const char* command,
+      const char* pkg_name,
+      int32_t* status_out
+    ) {
+      int32_t fds[2];
+
+      *status_out = -1;
+
+      if (pipe(fds) != 0)
+        return NULL;
+
+      fflush(stdout);
+      fflush(stderr);
+
+      pid_t pid = fork();
+
+      if (pid == 0) {
+        int32_t in_fd = open("/dev/null", O_RDONLY);
+
+        if (in_fd >= 0)
+          dup2(in_fd, STDIN_FILENO);
+
+        dup2(fds[1], STDOUT_FILENO);
+        close(fds[0]);
+        close(fds[1]);
+
+        if (pkg_name != NULL)
+          setenv("ARCUS_PACKAGES", pkg_name, 1);
+
+        execl("/bin/sh", "sh", "-c", command, (char*)NULL);
+        _exit(127);
+      }
+
+      close(fds[1]);
+
+      if (pid < 0) {
+        close(fds[0]);
+
+        return NULL;
+      }
+
+      size_t output_len = 0;
+      size_t output_size = 256;
+      char* output = (char*)malloc(output_size);
+      ssize_t n_read = 0;
+
+      while (output != NULL && (n_read = read(fds[0], output + output_len, output_size - output_len - 1)) != 0) {
+        if (n_read < 0) {
+          if (errno == EINTR)
+            continue;
+
+          break;
+        }
+
+        output_len += (size_t)n_read;
+
+        if (output_size - output_len == 1) {
+          char* re_alloc = (char*)realloc(output, output_size * 2);
+
+          if (re_alloc == NULL) {
+            free(output);
+            output = NULL;
+
+            break;
+          }
+
+          output = re_alloc;
+          output_size *= 2;
+        }
+      }
+
+      close(fds[0]);
+
+      while (waitpid(pid, status_out, 0) < 0 && errno == EINTR);
+
+      if (output != NULL)
+        output[output_len] = '\0';
+
+      return output;
+    }
+
+    /**
+     * @author https://github.com/SigmaEG/Arcus
+     * @brief Builds the absolute path of the cache `arcus lock` downloads package files into
+     * 
+     * @param path_out > Receives `<cwd>/ARCUS_LOCK_CACHE_DIR`
+     * @param path_size > Size of `path_out`
+     * 
+     * @return `bool` - > Whether the path could be built (and is safe to single-quote)
+    */
+    static
+    bool
+    lock_cache_path(
+      char* path_out,
+      const size_t path_size
+    ) {
+      char cwd[ARCUS_PATH_MAX];
+
+      if (getcwd(cwd, sizeof(cwd)) == NULL || strchr(cwd, '\'') != NULL)
+        return false;
+
+      return snprintf(path_out, path_size, "%s/" ARCUS_LOCK_CACHE_DIR, cwd) < (int32_t)path_size;
+    }
+
+    /**
+     * @author https://github.com/SigmaEG/Arcus
+     * @brief Expands the targets of a Package's `${ARCUS_SU_PACMAN}`/`${ARCUS_YAY}` command through the shell
+     * 
+     * @param pkg_idx > Index of the Package in `packages`
+     * 
+     * @return `char*` - > The non-option arguments, one per line, to be `free(...)`'d by the caller, or NULL if the body isn't exactly one such command (or it upgrades, e.g `${ARCUS_SU_PACMAN}yu`)
+     * @note Bodies that run anything else are left unlocked, as installing them from the lockfile would skip the rest of the body
+    */
+    static
+    char*
+    lock_targets(const int32_t pkg_idx) {
+      const char* body = package_body(pkg_idx);
+      const char* token = package_manager_at(pkg_idx) == ARCUS_MANAGER_PACMAN ? "${ARCUS_SU_PACMAN}" : "${ARCUS_YAY}";
+      const char* start = body + strspn(body, " \t\n");
+
+      if (strncmp(start, token, strlen(token)) != 0 || start[strlen(token)] != ' ')
+        return NULL;
+
+      const char* after = start + strlen(token);
+      const char* end = command_end(after);
+
+      if (end[strspn(end, " \t\n")] != '\0')
+        return NULL;
+      size_t command_len = (size_t)(end - after) + 32;
+      char* command = (char*)calloc(command_len, sizeof(char));
+      int32_t status = 0;
+
+      if (command == NULL)
+        return NULL;
+
+      snprintf(command, command_len, "printf '%%s\\n'%.*s", (int32_t)(end - after), after);
+
+      char* expanded = capture_command(command, packages[pkg_idx][0], &status);
+      char* targets = expanded != NULL ? (char*)calloc(strlen(expanded) + 1, sizeof(char)) : NULL;
+
+      free(command);
+
+      if (targets == NULL || status != 0) {
+        free(expanded);
+        free(targets);
+
+        return NULL;
+      }
+
+      for (char* line = strtok(expanded, "\n"); line != NULL; line = strtok(NULL, "\n")) {
+        if (line[0] == '-')
+          continue;
+
+        strcat(targets, line);
+        strcat(targets, "\n");
+      }
+
+      free(expanded);
+
+      return targets;
+    }
+
+    /**
+     * @author https://github.com/SigmaEG/Arcus
+     * @brief Verifies the package files `arcus.lock` pins for the Packages to install and installs them in a single `pacman -U` transaction
+     * 
+     * @param ignore > The ignore list to query
+     * @param n_ignore > Number of elements in `ignore`
+     * 
+     * @return `bool` - > False if a file is missing or doesn't match its hash, in which case nothing was installed
+     * @note Sets `lock_results` to the wait status of the transaction for every Package it covered, `ARCUS_LOCK_UNCOVERED` for the rest
+    */
+    static
+    bool
+    run_locked_transaction(
+      const char** ignore,
+      const int32_t n_ignore
+    ) {
+      char cache[ARCUS_PATH_MAX];
+
+      if (n_packages > 0)
+        lock_results = (int32_t*)calloc(n_packages, sizeof(int32_t));
+
+      if (lock_results == NULL || !lock_cache_path(cache, sizeof(cache)))
+        return n_packages == 0;
+
+      for (int32_t pkg_idx = 0; pkg_idx < n_packages; ++pkg_idx)
+        lock_results[pkg_idx] = ARCUS_LOCK_UNCOVERED;
+
+      const char* pacman = getenv("ARCUS_LOCKFILE_PACMAN_CMD") != NULL ? getenv("ARCUS_LOCKFILE_PACMAN_CMD") : ARCUS_LOCKFILE_PACMAN;
+      size_t command_size = strlen(pacman) + 32;
+      int32_t n_files = 0;
+      int32_t n_covered = 0;
+
+      for (int32_t entry_idx = 0; entry_idx < n_lock_entries; ++entry_idx)
+        command_size += strlen(cache) + strlen(lock_entries[entry_idx].file) + 4;
+
+      char* command = (char*)calloc(command_size, sizeof(char));
+
+      if (command == NULL)
+        return false;
+
+      snprintf(command, command_size, "%s -U --needed --noconfirm", pacman);
+
+      for (int32_t entry_idx = 0; entry_idx < n_lock_entries; ++entry_idx) {
+        const arcus_lock_entry_t* entry = &lock_entries[entry_idx];
+        bool duplicate = false;
+
+        if (is_ignored(packages[entry->pkg_idx][0], ignore, n_ignore))
+          continue;
+
+        if (lock_results[entry->pkg_idx] == ARCUS_LOCK_UNCOVERED) {
+          lock_results[entry->pkg_idx] = 0;
+          ++n_covered;
+        }
+
+        for (int32_t prev_idx = 0; prev_idx < entry_idx && !duplicate; ++prev_idx)
+          duplicate = strcmp(lock_entries[prev_idx].file, entry->file) == 0 && !is_ignored(packages[lock_entries[prev_idx].pkg_idx][0], ignore, n_ignore);
+
+        if (duplicate)
+          continue;
+
+        char path[2 * ARCUS_PATH_MAX];
+        char hash[65];
+
+        snprintf(path, sizeof(path), "%s/%s", cache, entry->file);
+
+        if (!sha256_file(path, hash) || strcmp(hash, entry->sha256) != 0) {
+          fprintf(stderr, "%s< LOCKED FILE %s : %s%s%s >\n", KRED, pathexists(path) ? "FAILED VERIFICATION" : "IS MISSING", KMAG, path, KRED);
+          free(command);
+
+          return false;
+        }
+
+        snprintf(command + strlen(command), command_size - strlen(command), " '%s'", path);
+        ++n_files;
+      }
+
+      if (n_files > 0) {
+        printf("%s< INSTALLING %d LOCKED FILE(S) FOR %d PACKAGE(S) IN ONE TRANSACTION >\n", KBLU, n_files, n_covered);
+
+        pid_t group = 0;
+        bool foreground = false;
+
+        active_groups = &group;
+        n_active_groups = 1;
+
+        pid_t pid = spawn_package(-1, command, -1, &group, &foreground);
+        int32_t status = pid < 0 ? -1 : wait_package(pid, &group, foreground);
+
+        active_groups = NULL;
+        n_active_groups = 0;
+
+        if (interrupted_by(status) && cancel_signal == 0)
+          cancel_signal = SIGINT;
+
+        for (int32_t pkg_idx = 0; pkg_idx < n_packages; ++pkg_idx) {
+          if (lock_results[pkg_idx] != ARCUS_LOCK_UNCOVERED)
+            lock_results[pkg_idx] = status;
+        }
+
+        printf("\n");
+      }
+
+      free(command);
+
+      return true;
+    }
+  #endif
+
+  /**
+   * @author https://github.com/SigmaEG/Arcus
+   * @brief Checks that a string is a SHA-256 hash as written by `sha256_final(...)`
+   * 
+   * @param hex > String to check
+   * 
+   * @return `bool` - > Whether `hex` is exactly 64 lowercase hex digits
+  */
+  static
+  bool
+  sha256_hex_valid(const char* hex) {
+    return strlen(hex) == 64 && strspn(hex, "0123456789abcdef") == 64;
+  }
+
+  /**
+   * @author https://github.com/SigmaEG/Arcus
+   * @brief Releases the Package names and hashes of a fingerprint
+   * 
+   * @param fingerprint > Fingerprint to release
+   * 
+   * @return `void`
+  */
+  static
+  void
+  free_fingerprint(arcus_fingerprint_t* fingerprint) {
+    for (int32_t leaf_idx = 0; leaf_idx < fingerprint->n_leaves; ++leaf_idx)
+      free(fingerprint->names[leaf_idx]);
+
+    free(fingerprint->names);
+    free(fingerprint->hashes);
+
+    fingerprint->names = NULL;
+    fingerprint->hashes = NULL;
+    fingerprint->n_leaves = 0;
+  }
+
+  /**
+   * @author https://github.com/SigmaEG/Arcus
+   * @brief Adds a Package hash to a fingerprint
+   * 
+   * @param fingerprint > Fingerprint to extend
+   * @param name > Header of the Package, copied
+   * @param hash > SHA-256 of the Package
+   * 
+   * @return `bool` - > False if out of memory
+  */
+  static
+  bool
+  add_fingerprint_leaf(
+    arcus_fingerprint_t* fingerprint,
+    const char* name,
+    const char* hash
+  ) {
+    char** names = (char**)realloc(fingerprint->names, (fingerprint->n_leaves + 1) * sizeof(char*));
+
+    if (names == NULL)
+      return false;
+
+    fingerprint->names = names;
+
+    char (*hashes)[65] = (char (*)[65])realloc(fingerprint->hashes, (fingerprint->n_leaves + 1) * sizeof(*hashes));
+
+    if (hashes == NULL)
+      return false;
+
+    fingerprint->hashes = hashes;
+    fingerprint->names[fingerprint->n_leaves] = strdup(name);
+
+    if (fingerprint->names[fingerprint->n_leaves] == NULL)
+      return false;
+
+    memcpy(fingerprint->hashes[fingerprint->n_leaves], hash, 65);
+    ++fingerprint->n_leaves;
+
+    return true;
+  }
+
+  /**
+   * @author https://github.com/SigmaEG/Arcus
+   * @brief Hashes the header and body of a Package, the leaf of its fingerprint
+   * 
+   * @param pkg_idx > Index of the Package in `packages`
+   * @param hash_out > Receives the 64 hex digits and a NUL
+   * 
+   * @return `void`
+  */
+  static
+  void
+  package_leaf_hash(
+    const int32_t pkg_idx,
+    char* hash_out
+  ) {
+    const char* header = packages[pkg_idx][0];
+    const char* body = package_body(pkg_idx);
+    arcus_sha256_t leaf;
+
+    sha256_init(&leaf);
+    sha256_update(&leaf, (const uint8_t*)header, strlen(header));
+    sha256_update(&leaf, (const uint8_t*)"\n", 1);
+    sha256_update(&leaf, (const uint8_t*)body, strlen(body));
+    sha256_final(&leaf, hash_out);
+  }
+
+  /**
+   * @author https://github.com/SigmaEG/Arcus
+   * @brief Hashes every Package of the loaded configuration and the root over them
+   * 
+   * @param fingerprint_out > Receives the fingerprint, to be released with `free_fingerprint(...)`
+   * 
+   * @return `bool` - > False if out of memory
+  */
+  static
+  bool
+  fingerprint_config(arcus_fingerprint_t* fingerprint_out) {
+    arcus_sha256_t root;
+
+    *fingerprint_out = (arcus_fingerprint_t){ "", NULL, NULL, 0 };
+    sha256_init(&root);
+
+    for (int32_t pkg_idx = 0; pkg_idx < n_packages; ++pkg_idx) {
+      char hash[65];
+
+      package_leaf_hash(pkg_idx, hash);
+
+      if (!add_fingerprint_leaf(fingerprint_out, packages[pkg_idx][0], hash)) {
+        free_fingerprint(fingerprint_out);
+
+        return false;
+      }
+
+      sha256_update(&root, (const uint8_t*)hash, 64);
+    }
+
+    sha256_final(&root, fingerprint_out->root);
+
+    return true;
+  }
+
+  /**
+   * @author https://github.com/SigmaEG/Arcus
+   * @brief Reads a fingerprint written by `arcus fingerprint`
+   * 
+   * @param path > Fingerprint file to read
+   * @param root_only > Whether to stop after the root hash
+   * @param fingerprint_out > Receives the fingerprint, to be released with `free_fingerprint(...)`
+   * 
+   * @return `bool` - > Whether the file exists and is well-formed
+  */
+  static
+  bool
+  read_fingerprint(
+    const char* path,
+    const bool root_only,
+    arcus_fingerprint_t* fingerprint_out
+  ) {
+    *fingerprint_out = (arcus_fingerprint_t){ "", NULL, NULL, 0 };
+
+    FILE* file = fopen(path, "rb");
+
+    if (file == NULL) {
+      fprintf(stderr, "%s< FAILED TO OPEN FILE : %s >\n", KRED, path);
+
+      return false;
+    }
+
+    char* line = NULL;
+    int32_t line_size = 0;
+    int32_t line_no = 1;
+    bool valid = (line = arcus_getline(&line_size, true, '\n', file)) != NULL && strcmp(line, ARCUS_FINGERPRINT_MAGIC) == 0;
+
+    free(line);
+
+    if (valid) {
+      ++line_no;
+      line = arcus_getline(&line_size, true, '\n', file);
+      valid = line != NULL && strncmp(line, "root\t", 5) == 0 && sha256_hex_valid(line + 5);
+
+      if (valid)
+        memcpy(fingerprint_out->root, line + 5, 65);
+
+      free(line);
+    }
+
+    while (valid && !root_only && (line = arcus_getline(&line_size, true, '\n', file)) != NULL) {
+      if (line_size <= 0) {
+        free(line);
+
+        break;
+      }
+
+      ++line_no;
+
+      char* name = strchr(line, '\t');
+
+      if (name != NULL)
+        *name++ = '\0';
+
+      valid = name != NULL && name[0] != '\0' && sha256_hex_valid(line) && add_fingerprint_leaf(fingerprint_out, name, line);
+
+      free(line);
+    }
+
+    fclose(file);
+
+    if (!valid) {
+      fprintf(stderr, "%s< MALFORMED LINE %d IN %s >\n", KRED, line_no, path);
+      free_fingerprint(fingerprint_out);
+    }
+
+    return valid;
+  }
+
+  #if defined(__unix__) || defined(__linux__)
+    /**
+     * @author https://github.com/SigmaEG/Arcus
+     * @brief Measures the shell identifier at the start of a string
+     * 
+     * @param name > Candidate variable name
+     * 
+     * @return `size_t` - > Length of the identifier, 0 if `name` doesn't start with one
+    */
+    static
+    size_t
+    identifier_length(const char* name) {
+      if (!isalpha((unsigned char)name[0]) && name[0] != '_')
+        return 0;
+
+      size_t length = 1;
+
+      while (isalnum((unsigned char)name[length]) || name[length] == '_')
+        ++length;
+
+      return length;
+    }
+
+    /**
+     * @author https://github.com/SigmaEG/Arcus
+     * @brief Looks up what a `${VAR}` reference of a Package body expands to once it runs
+     * 
+     * @param pkg_idx > Index of the Package in `packages`
+     * @param name > Name of the variable, not null-terminated
+     * @param name_len > Length of `name`
+     * 
+     * @return `const char*` - > The value from `arcus.envs`, one Arcus exports itself or the environment's, else NULL
+    */
+    static
+    const char*
+    check_variable_value(
+      const int32_t pkg_idx,
+      const char* name,
+      const size_t name_len
+    ) {
+      char key[256];
+
+      if (name_len == 0 || name_len >= sizeof(key))
+        return NULL;
+
+      memcpy(key, name, name_len);
+      key[name_len] = '\0';
+
+      for (int32_t arg_idx = 0; arg_idx < n_env_args; ++arg_idx) {
+        if (strcmp(env_args[arg_idx][0], key) == 0)
+          return env_args[arg_idx][1];
+      }
+
+      if (strcmp(key, "ARCUS_PACKAGES") == 0)
+        return packages[pkg_idx][0];
+
+      if (strcmp(key, "ARCUS_ROOT") == 0 || (strcmp(key, "ARCUS_CWD") == 0 && scratch_max_bytes > 0))
+        return "/";
+
+      return getenv(key);
+    }
+
+    /**
+     * @author https://github.com/SigmaEG/Arcus
+     * @brief Checks whether a Package body sets a variable itself (`NAME=...`, `for NAME in ...`, `read NAME`, `getopts ... NAME`)
+     * 
+     * @param body > Commands of the Package
+     * @param name > Name of the variable, not null-terminated
+     * @param name_len > Length of `name`
+     * 
+     * @return `bool` - > Whether the variable is assigned somewhere in `body`
+    */
+    static
+    bool
+    body_assigns(
+      const char* body,
+      const char* name,
+      const size_t name_len
+    ) {
+      char key[256];
+
+      if (name_len >= sizeof(key))
+        return false;
+
+      memcpy(key, name, name_len);
+      key[name_len] = '\0';
+
+      for (const char* found = strstr(body, key); found != NULL; found = strstr(found + 1, key)) {
+        if (found != body && (isalnum((unsigned char)found[-1]) || strchr("_{$", found[-1]) != NULL))
+          continue;
+
+        if (found[name_len] == '=')
+          return true;
+
+        if (isalnum((unsigned char)found[name_len]) || found[name_len] == '_')
+          continue;
+
+        const char* word = found;
+
+        while (word > body && strchr(";&|\n(", word[-1]) == NULL)
+          --word;
+
+        // Any `for`, `read` or `getopts` earlier in the same command assigns its operands
+        while (word < found) {
+          while (word < found && (*word == ' ' || *word == '\t'))
+            ++word;
+
+          size_t word_len = strcspn(word, " \t");
+
+          if (
+            (word_len == 3 && strncmp(word, "for", 3) == 0)
+            || (word_len == 4 && strncmp(word, "read", 4) == 0)
+            || (word_len == 7 && strncmp(word, "getopts", 7) == 0)
+          )
+            return true;
+
+          word += word_len;
+        }
+      }
+
+      return false;
+    }
+
+    /**
+     * @author https://github.com/SigmaEG/Arcus
+     * @brief Reports every `${VAR}` reference of a Package body that resolves to nothing
+     * 
+     * @param pkg_idx > Index of the Package in `packages`
+     * @param body > Commands of the Package
+     * 
+     * @return `int32_t` - > Number of undefined variables reported
+     * @note References with a default or an alternative (`${VAR:-...}`, `${VAR+...}`, ...), special parameters and anything inside single quotes are left alone
+    */
+    static
+    int32_t
+    check_body_variables(
+      const int32_t pkg_idx,
+      const char* body
+    ) {
+      int32_t n_errors = 0;
+      char quote = '\0';
+
+      for (const char* cursor = body; *cursor != '\0'; ++cursor) {
+        if (*cursor == '\\' && quote != '\'' && cursor[1] != '\0') {
+          ++cursor;
+
+          continue;
+        }
+
+        if ((*cursor == '\'' || *cursor == '"') && (quote == '\0' || quote == *cursor)) {
+          quote = quote == '\0' ? *cursor : '\0';
+
+          continue;
+        }
+
+        if (quote == '\'' || cursor[0] != '$' || cursor[1] != '{')
+          continue;
+
+        const char* name = cursor + 2;
+        size_t name_len = identifier_length(name);
+
+        if (name_len == 0 || name[name_len] != '}')
+          continue;
+
+        if (check_variable_value(pkg_idx, name, name_len) != NULL || body_assigns(body, name, name_len))
+          continue;
+
+        char reference[260];
+
+        snprintf(reference, sizeof(reference), "${%.*s}", (int)name_len, name);
+
+        // Reported once per body
+        if (strstr(body, reference) != cursor)
+          continue;
+
+        printf("%s< ERROR : %s%s%s : UNDEFINED VARIABLE %s%s%s >\n", KRED, KMAG, packages[pkg_idx][0], KRED, KMAG, reference, KRED);
+        ++n_errors;
+      }
+
+      return n_errors;
+    }
+
+    /**
+     * @author https://github.com/SigmaEG/Arcus
+     * @brief Finds the end of the shell command starting at `cursor` for the preflight, unlike `command_end(...)` it skips quotes, escapes and redirections
+     * 
+     * @param body > Commands of the Package, `cursor` points inside it
+     * @param cursor > Start of the command
+     * 
+     * @return `const char*` - > The next unquoted `;`, `&`, `|`, newline, parenthesis, backtick, `$(`, comment or null-terminator
+    */
+    static
+    const char*
+    check_command_end(
+      const char* body,
+      const char* cursor
+    ) {
+      char quote = '\0';
+
+      for (; *cursor != '\0'; ++cursor) {
+        if (quote != '\0') {
+          if (*cursor == quote)
+            quote = '\0';
+          else if (quote == '"' && *cursor == '\\' && cursor[1] != '\0')
+            ++cursor;
+
+          continue;
+        }
+
+        if (*cursor == '\\' && cursor[1] != '\0') {
+          ++cursor;
+
+          continue;
+        }
+
+        if (*cursor == '\'' || *cursor == '"') {
+          quote = *cursor;
+
+          continue;
+        }
+
+        // Arithmetic expansions are part of the word they appear in
+        if (strncmp(cursor, "$((", 3) == 0) {
+          const char* close = strstr(cursor, "))");
+
+          if (close == NULL)
+            return cursor + strlen(cursor);
+
+          cursor = close + 1;
+
+          continue;
+        }
+
+        if (strncmp(cursor, "$(", 2) == 0)
+          return cursor;
+
+        if (*cursor == '#' && (cursor == body || strchr(" \t\n;&|()", cursor[-1]) != NULL))
+          return cursor;
+
+        // `>&2`, `2>&1` and `&>` redirect rather than end the command
+        if (*cursor == '&' && ((cursor > body && (cursor[-1] == '>' || cursor[-1] == '<')) || cursor[1] == '>'))
+          continue;
+
+        if (strchr(";&|\n()`", *cursor) != NULL)
+          return cursor;
+      }
+
+      return cursor;
+    }
+
+    /**
+     * @author https://github.com/SigmaEG/Arcus
+     * @brief Expands the `${VAR}` references of a single command the way its shell will
+     * 
+     * @param pkg_idx > Index of the Package in `packages`
+     * @param command > Start of the command, not null-terminated
+     * @param length > Length of `command`
+     * 
+     * @return `char*` - > The expanded command, to be `free(...)`'d by the caller, or NULL on allocation failure
+     * @note References that resolve to nothing are kept as they are, so the words containing them are skipped
+    */
+    static
+    char*
+    expand_check_command(
+      const int32_t pkg_idx,
+      const char* command,
+      const size_t length
+    ) {
+      char* expanded = NULL;
+      size_t size = 0;
+
+      // The first pass measures, the second writes
+      for (int32_t pass = 0; pass < 2; ++pass) {
+        size_t used = 0;
+
+        for (size_t offset = 0; offset < length; ++offset) {
+          const char* value = NULL;
+          size_t name_len = 0;
+
+          if (command[offset] == '$' && offset + 1 < length && command[offset + 1] == '{') {
+            name_len = identifier_length(command + offset + 2);
+
+            if (name_len > 0 && offset + 2 + name_len < length && command[offset + 2 + name_len] == '}')
+              value = check_variable_value(pkg_idx, command + offset + 2, name_len);
+          }
+
+          if (value == NULL) {
+            if (expanded != NULL)
+              expanded[used] = command[offset];
+
+            ++used;
+
+            continue;
+          }
+
+          size_t value_len = strlen(value);
+
+          if (expanded != NULL)
+            memcpy(expanded + used, value, value_len);
+
+          used += value_len;
+          offset += 2 + name_len;
+        }
+
+        if (pass == 0) {
+          size = used + 1;
+          expanded = (char*)calloc(size, sizeof(char));
+
+          if (expanded == NULL)
+            return NULL;
+        }
+      }
+
+      return expanded;
+    }
+
+    /**
+     * @author https://github.com/SigmaEG/Arcus
+     * @brief Reads the next word of an expanded command, keeping its quotes
+     * 
+     * @param cursor > Position in the command, advanced past the word
+     * @param word_out > Buffer of `ARCUS_PATH_MAX` bytes receiving the word (truncated words come back empty)
+     * 
+     * @return `bool` - > Whether there was a word left
+    */
+    static
+    bool
+    next_check_word(
+      const char** cursor,
+      char* word_out
+    ) {
+      const char* start = *cursor;
+      char quote = '\0';
+
+      while (*start == ' ' || *start == '\t')
+        ++start;
+
+      if (*start == '\0')
+        return false;
+
+      const char* end = start;
+
+      for (; *end != '\0' && (quote != '\0' || (*end != ' ' && *end != '\t')); ++end) {
+        if (quote == '\0' && (*end == '\'' || *end == '"'))
+          quote = *end;
+        else if (*end == quote)
+          quote = '\0';
+      }
+
+      size_t word_len = (size_t)(end - start);
+
+      if (word_len >= ARCUS_PATH_MAX)
+        word_len = 0;
+
+      memcpy(word_out, start, word_len);
+      word_out[word_len] = '\0';
+      *cursor = end;
+
+      return true;
+    }
+
+    /**
+     * @author https://github.com/SigmaEG/Arcus
+     * @brief Checks whether a word is in a NULL-terminated list
+     * 
+     * @param word > Word to look up
+     * @param list > NULL-terminated list of words
+     * 
+     * @return `bool` - > Whether `word` is in `list`
+    */
+    static
+    bool
+    word_in(
+      const char* word,
+      const char* const* list
+    ) {
+      for (; *list != NULL; ++list) {
+        if (strcmp(word, *list) == 0)
+          return true;
+      }
+
+      return false;
+    }
+
+    /**
+     * @author https://github.com/SigmaEG/Arcus
+     * @brief Resolves a command the preflight found in a Package body
+     * 
+     * @param pkg_idx > Index of the Package in `packages`
+     * @param body > Commands of the Package
+     * @param word > The command
+     * @param ignore > The ignore list to query
+     * @param n_ignore > Number of ignored packages (size of `ignore`)
+     * 
+     * @return `bool` - > Whether the command is a builtin, a function of the body, an executable, listed in `ARCUS_CHECK_ALLOW` or installed by this or an earlier selected Package of the same name
+    */
+    static
+    bool
+    resolve_check_command(
+      const int32_t pkg_idx,
+      const char* body,
+      const char* word,
+      const char** ignore,
+      const int32_t n_ignore
+    ) {
+      static const char* const builtins[] = {
+        ".", ":", "[", "[[", "alias", "bg", "break", "builtin", "cd", "command", "continue", "declare", "echo", "eval", "exec", "exit", "export",
+        "false", "fg", "getopts", "hash", "jobs", "kill", "let", "local", "printf", "pushd", "popd", "pwd", "read", "readonly", "return", "set",
+        "shift", "source", "test", "times", "trap", "true", "type", "typeset", "ulimit", "umask", "unalias", "unset", "wait", NULL
+      };
+
+      char path[ARCUS_PATH_MAX];
+
+      if (word_in(word, builtins) || find_executable(word, path))
+        return true;
+
+      char definition[ARCUS_PATH_MAX + 16];
+
+      snprintf(definition, sizeof(definition), "%s()", word);
+
+      if (strstr(body, definition) != NULL)
+        return true;
+
+      snprintf(definition, sizeof(definition), "function %s", word);
+
+      if (strstr(body, definition) != NULL)
+        return true;
+
+      for (int32_t provider_idx = 0; provider_idx <= pkg_idx; ++provider_idx) {
+        if (strcmp(packages[provider_idx][0], word) == 0 && !is_ignored(word, ignore, n_ignore))
+          return true;
+      }
+
+      // Commands a Package installs under another name (e.g. `gext` from `gnome-extensions-cli`) are declared by name, separated by whitespace
+      const char* allowed = check_variable_value(pkg_idx, "ARCUS_CHECK_ALLOW", strlen("ARCUS_CHECK_ALLOW"));
+      size_t word_len = strlen(word);
+
+      while (allowed != NULL && *(allowed += strspn(allowed, " \t\n")) != '\0') {
+        size_t allowed_len = strcspn(allowed, " \t\n");
+
+        if (allowed_len == word_len && strncmp(allowed, word, word_len) == 0)
+          return true;
+
+        allowed += allowed_len;
+      }
+
+      return false;
+    }
+
+    /**
+     * @author https://github.com/SigmaEG/Arcus
+     * @brief Reports every command of a Package body that doesn't resolve to an executable
+     * 
+     * @param pkg_idx > Index of the Package in `packages`
+     * @param body > Commands of the Package
+     * @param ignore > The ignore list to query
+     * @param n_ignore > Number of ignored packages (size of `ignore`)
+     * 
+     * @return `int32_t` - > Number of unresolved commands reported
+     * @note The first word of every command (and the one `sudo`, `exec` or `nohup` runs) is checked after `${VAR}` expansion. Words that are still dynamic (quotes, `$`, globs) or relative paths are left to run time.
+    */
+    static
+    int32_t
+    check_body_commands(
+      const int32_t pkg_idx,
+      const char* body,
+      const char** ignore,
+      const int32_t n_ignore
+    ) {
+      static const char* const prefixes[] = { "if", "then", "else", "elif", "do", "while", "until", "!", "{", "time", NULL };
+      static const char* const no_command[] = { "fi", "done", "esac", "}", "for", "case", "select", "function", "in", "]]", NULL };
+      static const char* const wrappers[] = { "sudo", "exec", "nohup", NULL };
+
+      int32_t n_errors = 0;
+      bool has_case = strstr(body, "case ") != NULL;
+      char word[ARCUS_PATH_MAX];
+      char reported[1024] = "\n";
+      const char* cursor = body;
+
+      while (*cursor != '\0') {
+        const char* end = check_command_end(body, cursor);
+        char* command = expand_check_command(pkg_idx, cursor, (size_t)(end - cursor));
+
+        if (command == NULL)
+          return n_errors;
+
+        const char* words = command;
+        int32_t n_words = 0;
+        bool wrapped = false;
+
+        while (next_check_word(&words, word)) {
+          ++n_words;
+
+          if (wrapped && word[0] == '-') {
+            // `sudo -u <user>` and friends take the next word as their value
+            if (strlen(word) == 2 && strchr("ugCDhprtTRU", word[1]) != NULL)
+              next_check_word(&words, word);
+
+            continue;
+          }
+
+          if (!wrapped && (identifier_length(word) > 0 && word[identifier_length(word)] == '='))
+            continue;
+
+          if (word[0] == '<' || word[0] == '>' || (isdigit((unsigned char)word[0]) && (word[1] == '<' || word[1] == '>'))) {
+            char last = word[strlen(word) - 1];
+
+            if (last == '<' || last == '>' || last == '&')
+              next_check_word(&words, word);
+
+            continue;
+          }
+
+          if (!wrapped && word_in(word, prefixes))
+            continue;
+
+          if (word[0] == '\0' || (!wrapped && word_in(word, no_command)))
+            break;
+
+          const char* rest = words + strspn(words, " \t");
+
+          // `name()` defines a function and a lone word before `)` or `|` inside a `case` is a pattern
+          if (n_words == 1 && *rest == '\0' && (*end == '(' || (has_case && (*end == ')' || *end == '|'))))
+            break;
+
+          char entry[ARCUS_PATH_MAX + 2];
+
+          snprintf(entry, sizeof(entry), "%s\n", word);
+
+          // Paths relative to wherever the body `cd`'d to are left to run time too
+          if (
+            strpbrk(word, "$`'\"*?[~\\") == NULL
+            && (word[0] == '/' || strchr(word, '/') == NULL)
+            && !resolve_check_command(pkg_idx, body, word, ignore, n_ignore)
+          ) {
+            // Reported once per body
+            char* seen = strstr(reported, entry);
+
+            if (seen == NULL || seen[-1] != '\n') {
+              printf("%s< ERROR : %s%s%s : COMMAND NOT FOUND ON PATH : %s%s%s >\n", KRED, KMAG, packages[pkg_idx][0], KRED, KMAG, word, KRED);
+              ++n_errors;
+
+              if (strlen(reported) + strlen(entry) < sizeof(reported))
+                strcat(reported, entry);
+            }
+          }
+
+          if (!word_in(word, wrappers))
+            break;
+
+          wrapped = true;
+        }
+
+        free(command);
+
+        if (*end == '\0')
+          break;
+
+        if (*end == '#') {
+          end = strchr(end, '\n');
+
+          if (end == NULL)
+            break;
+        }
+
+        cursor = end + (strncmp(end, "$(", 2) == 0 ? 2 : 1);
+      }
+
+      return n_errors;
+    }
+
+    /**
+     * @author https://github.com/SigmaEG/Arcus
+     * @brief Checks whether a Package body is too simple to be malformed: plain words and `${VAR}` references making up a single command that isn't a reserved word
+     * 
+     * @param body > Commands of the Package
+     * 
+     * @return `bool` - > Whether `sh -n` can be skipped for the body
+    */
+    static
+    bool
+    syntax_trivial(const char* body) {
+      static const char* const reserved[] = { "if", "then", "else", "elif", "fi", "do", "done", "case", "esac", "for", "while", "until", "in", "!", "{", "}", NULL };
+
+      for (const char* cursor = body; *cursor != '\0'; ++cursor) {
+        if (isalnum((unsigned char)*cursor) || strchr(" \t-_./:=@+,%", *cursor) != NULL)
+          continue;
+
+        size_t name_len = cursor[0] == '$' && cursor[1] == '{' ? identifier_length(cursor + 2) : 0;
+
+        if (name_len == 0 || cursor[2 + name_len] != '}')
+          return false;
+
+        cursor += 2 + name_len;
+      }
+
+      char first[ARCUS_PATH_MAX];
+      const char* cursor = body;
+
+      return !next_check_word(&cursor, first) || (first[0] != '\0' && !word_in(first, reserved));
+    }
+
+    /**
+     * @author https://github.com/SigmaEG/Arcus
+     * @brief Runs `sh -n` over the body of every selected Package, `ARCUS_CHECK_JOBS` at a time
+     * 
+     * @param ignore > The ignore list to query
+     * @param n_ignore > Number of ignored packages (size of `ignore`)
+     * @param errors_out > Array of `n_packages` receiving what `sh -n` printed for each body it rejected (NULL for the rest), each to be `free(...)`'d by the caller
+     * 
+     * @return `bool` - > Whether every check could be started
+     * @note Bodies passing `syntax_trivial(...)` aren't checked and identical bodies are only checked once
+    */
+    static
+    bool
+    check_syntax(
+      const char** ignore,
+      const int32_t n_ignore,
+      char** errors_out
+    ) {
+      int32_t* queue = n_packages > 0 ? (int32_t*)calloc(n_packages, sizeof(int32_t)) : NULL;
+      int32_t* same_as = n_packages > 0 ? (int32_t*)calloc(n_packages, sizeof(int32_t)) : NULL;
+      uint64_t* hashes = n_packages > 0 ? (uint64_t*)calloc(n_packages, sizeof(uint64_t)) : NULL;
+      int32_t n_queued = 0;
+
+      if (n_packages > 0 && (queue == NULL || same_as == NULL || hashes == NULL)) {
+        free(queue);
+        free(same_as);
+        free(hashes);
+
+        return false;
+      }
+
+      for (int32_t pkg_idx = 0; pkg_idx < n_packages; ++pkg_idx) {
+        same_as[pkg_idx] = -1;
+
+        if (is_ignored(packages[pkg_idx][0], ignore, n_ignore))
+          continue;
+
+        const char* body = package_body(pkg_idx);
+
+        if (syntax_trivial(body))
+          continue;
+
+        // FNV-1a
+        uint64_t hash = 14695981039346656037ULL;
+
+        for (const char* cursor = body; *cursor != '\0'; ++cursor)
+          hash = (hash ^ (uint8_t)*cursor) * 1099511628211ULL;
+
+        hashes[pkg_idx] = hash;
+
+        for (int32_t queue_idx = 0; queue_idx < n_queued && same_as[pkg_idx] == -1; ++queue_idx) {
+          if (hashes[queue[queue_idx]] == hash && strcmp(package_body(queue[queue_idx]), body) == 0)
+            same_as[pkg_idx] = queue[queue_idx];
+        }
+
+        if (same_as[pkg_idx] == -1)
+          queue[n_queued++] = pkg_idx;
+      }
+
+      struct pollfd running[ARCUS_CHECK_JOBS];
+      pid_t running_pids[ARCUS_CHECK_JOBS];
+      int32_t running_pkgs[ARCUS_CHECK_JOBS];
+      char output[ARCUS_CHECK_JOBS][256];
+      size_t output_len[ARCUS_CHECK_JOBS];
+      int32_t n_running = 0;
+      int32_t next = 0;
+      bool started = true;
+
+      fflush(stdout);
+
+      while ((started && next < n_queued) || n_running > 0) {
+        while (started && next < n_queued && n_running < ARCUS_CHECK_JOBS) {
+          int32_t pkg_idx = queue[next++];
+          int32_t fds[2];
+
+          if (pipe(fds) != 0) {
+            started = false;
+
+            break;
+          }
+
+          pid_t pid = fork();
+
+          if (pid == 0) {
+            int32_t null_fd = open("/dev/null", O_RDWR);
+
+            if (null_fd >= 0) {
+              dup2(null_fd, STDIN_FILENO);
+              dup2(null_fd, STDOUT_FILENO);
+            }
+
+            dup2(fds[1], STDERR_FILENO);
+            close(fds[0]);
+            close(fds[1]);
+
+            execl("/bin/sh", "sh", "-n", "-c", package_body(pkg_idx), (char*)NULL);
+            _exit(127);
+          }
+
+          close(fds[1]);
+
+          if (pid < 0) {
+            close(fds[0]);
+            started = false;
+
+            break;
+          }
+
+          running[n_running] = (struct pollfd){ fds[0], POLLIN, 0 };
+          running_pids[n_running] = pid;
+          running_pkgs[n_running] = pkg_idx;
+          output_len[n_running] = 0;
+          ++n_running;
+        }
+
+        if (n_running == 0)
+          break;
+
+        if (poll(running, (nfds_t)n_running, -1) < 0) {
+          if (errno == EINTR)
+            continue;
+
+          started = false;
+        }
+
+        for (int32_t slot = n_running - 1; slot >= 0; --slot) {
+          if (running[slot].revents == 0 && started)
+            continue;
+
+          char chunk[512];
+          ssize_t n_read = started ? read(running[slot].fd, chunk, sizeof(chunk)) : 0;
+
+          if (n_read < 0 && errno == EINTR)
+            continue;
+
+          if (n_read > 0) {
+            size_t kept = sizeof(output[slot]) - 1 - output_len[slot];
+
+            if ((size_t)n_read < kept)
+              kept = (size_t)n_read;
+
+            memcpy(output[slot] + output_len[slot], chunk, kept);
+            output_len[slot] += kept;
+
+            continue;
+          }
+
+          int status = 0;
+
+          close(running[slot].fd);
+
+          while (waitpid(running_pids[slot], &status, 0) < 0 && errno == EINTR);
+
+          if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+            output[slot][output_len[slot]] = '\0';
+            output[slot][strcspn(output[slot], "\n")] = '\0';
+            errors_out[running_pkgs[slot]] = strdup(output[slot][0] != '\0' ? output[slot] : "sh -n FAILED");
+          }
+
+          --n_running;
+          running[slot] = running[n_running];
+          running_pids[slot] = running_pids[n_running];
+          running_pkgs[slot] = running_pkgs[n_running];
+          output_len[slot] = output_len[n_running];
+          memcpy(output[slot], output[n_running], output_len[n_running]);
+        }
+      }
+
+      for (int32_t pkg_idx = 0; pkg_idx < n_packages; ++pkg_idx) {
+        if (same_as[pkg_idx] != -1 && errors_out[same_as[pkg_idx]] != NULL)
+          errors_out[pkg_idx] = strdup(errors_out[same_as[pkg_idx]]);
+      }
+
+      free(queue);
+      free(same_as);
+      free(hashes);
+
+      return started;
+    }
+
+    /**
+     * @author https://github.com/SigmaEG/Arcus
+     * @brief `qsort(...)`/`bsearch(...)` comparator for `arcus_duration_t` by Package name
+    */
+    static
+    int
+    compare_durations(
+      const void* lhs,
+      const void* rhs
+    ) {
+      return strcmp(((const arcus_duration_t*)lhs)->name, ((const arcus_duration_t*)rhs)->name);
+    }
+
+    /**
+     * @author https://github.com/SigmaEG/Arcus
+     * @brief `qsort(...)` comparator for `arcus_duration_t` by Package name, then by line so the last line of a Package sorts last
+    */
+    static
+    int
+    compare_duration_lines(
+      const void* lhs,
+      const void* rhs
+    ) {
+      int named = compare_durations(lhs, rhs);
+
+      return named != 0 ? named : ((const arcus_duration_t*)lhs)->line_no - ((const arcus_duration_t*)rhs)->line_no;
+    }
+
+    /**
+     * @author https://github.com/SigmaEG/Arcus
+     * @brief `qsort(...)` comparator for `arcus_sim_task_t`, longest first and in file order on ties
+    */
+    static
+    int
+    compare_longest(
+      const void* lhs,
+      const void* rhs
+    ) {
+      const arcus_sim_task_t* left = (const arcus_sim_task_t*)lhs;
+      const arcus_sim_task_t* right = (const arcus_sim_task_t*)rhs;
+
+      if (left->seconds != right->seconds)
+        return left->seconds > right->seconds ? -1 : 1;
+
+      return left->pkg_idx - right->pkg_idx;
+    }
+
+    /**
+     * @author https://github.com/SigmaEG/Arcus
+     * @brief `qsort(...)` comparator for `arcus_sim_task_t`, shortest first and in file order on ties
+    */
+    static
+    int
+    compare_shortest(
+      const void* lhs,
+      const void* rhs
+    ) {
+      const arcus_sim_task_t* left = (const arcus_sim_task_t*)lhs;
+      const arcus_sim_task_t* right = (const arcus_sim_task_t*)rhs;
+
+      if (left->seconds != right->seconds)
+        return left->seconds < right->seconds ? -1 : 1;
+
+      return left->pkg_idx - right->pkg_idx;
+    }
+
+    /**
+     * @author https://github.com/SigmaEG/Arcus
+     * @brief Releases durations read by `read_durations(...)`
+     * 
+     * @param durations > Durations to release
+     * @param n_durations > Number of durations (size of `durations`)
+     * 
+     * @return `void`
+    */
+    static
+    void
+    free_durations(
+      arcus_duration_t* durations,
+      const int32_t n_durations
+    ) {
+      for (int32_t duration_idx = 0; duration_idx < n_durations; ++duration_idx)
+        free(durations[duration_idx].name);
+
+      free(durations);
+    }
+
+    /**
+     * @author https://github.com/SigmaEG/Arcus
+     * @brief Reads the durations file of `arcus simulate`, sorted by Package name
+     * 
+     * @param path > File of `<package>\t<seconds>[\t<locks>]` lines, empty lines and lines starting with `#` are skipped, the last line of a Package listed more than once wins
+     * @param n_durations_out > Receives the number of durations
+     * 
+     * @return `arcus_duration_t*` - > The durations (`locks` is -1 when omitted), to be released with `free_durations(...)`, or NULL if the file can't be read or is malformed
+    */
+    static
+    arcus_duration_t*
+    read_durations(
+      const char* path,
+      int32_t* n_durations_out
+    ) {
+      FILE* file = fopen(path, "rb");
+
+      *n_durations_out = 0;
+
+      if (file == NULL) {
+        fprintf(stderr, "%s< FAILED TO OPEN FILE : %s >\n", KRED, path);
+
+        return NULL;
+      }
+
+      arcus_duration_t* durations = NULL;
+      int32_t n_durations = 0;
+      int32_t capacity = 0;
+      int32_t line_no = 0;
+      int32_t line_size = 0;
+      char* line = NULL;
+      bool valid = true;
+
+      while (valid) {
+        line = arcus_getline(&line_size, true, '\n', file);
+        ++line_no;
+
+        // `arcus_getline(...)` reports an empty line as NULL and the end of the file as an empty string
+        if (line == NULL)
+          continue;
+
+        if (line_size <= 0) {
+          free(line);
+
+          break;
+        }
+
+        if (line[0] == '#') {
+          free(line);
+
+          continue;
+        }
+
+        char* seconds = strchr(line, '\t');
+        char* locks = seconds != NULL ? strchr(seconds + 1, '\t') : NULL;
+        char* end = NULL;
+
+        if (seconds != NULL)
+          *seconds++ = '\0';
+
+        if (locks != NULL)
+          *locks++ = '\0';
+
+        double value = seconds != NULL ? strtod(seconds, &end) : -1.0;
+        int32_t mask = locks == NULL ? -1 : 0;
+
+        valid = line[0] != '\0' && end != seconds && end != NULL && *end == '\0' && value >= 0.0 && value < 1e12;
+
+        // `<locks>` is a `,`-separated list of lock names
+        for (char* lock = locks; valid && lock != NULL && *lock != '\0';) {
+          size_t lock_len = strcspn(lock, ",");
+
+          if (lock_len == 6 && strncmp(lock, "pacman", 6) == 0)
+            mask |= ARCUS_LOCK_PACMAN;
+          else if (lock_len == 7 && strncmp(lock, "flatpak", 7) == 0)
+            mask |= ARCUS_LOCK_FLATPAK;
+          else if (lock_len != 4 || strncmp(lock, "none", 4) != 0)
+            valid = false;
+
+          lock += lock_len + (lock[lock_len] == ',' ? 1 : 0);
+        }
+
+        if (valid && n_durations == capacity) {
+          int32_t grown = capacity == 0 ? 64 : capacity * 2;
+          arcus_duration_t* resized = (arcus_duration_t*)realloc(durations, (size_t)grown * sizeof(arcus_duration_t));
+
+          valid = resized != NULL;
+
+          if (valid) {
+            durations = resized;
+            capacity = grown;
+          }
+        }
+
+        if (valid) {
+          durations[n_durations] = (arcus_duration_t){ line, value, mask, line_no };
+          ++n_durations;
+        } else {
+          free(line);
+        }
+      }
+
+      fclose(file);
+
+      if (!valid) {
+        fprintf(stderr, "%s< MALFORMED LINE %d IN %s, EXPECTED <package>\\t<seconds>[\\t<locks>] >\n", KRED, line_no, path);
+        free_durations(durations, n_durations);
+
+        return NULL;
+      }
+
+      if (n_durations > 0)
+        qsort(durations, n_durations, sizeof(arcus_duration_t), compare_duration_lines);
+
+      int32_t n_unique = 0;
+
+      // Timings appended run after run list a Package more than once, `bsearch(...)` needs each name once
+      for (int32_t duration_idx = 0; duration_idx < n_durations; ++duration_idx) {
+        if (duration_idx + 1 < n_durations && strcmp(durations[duration_idx].name, durations[duration_idx + 1].name) == 0)
+          free(durations[duration_idx].name);
+        else
+          durations[n_unique++] = durations[duration_idx];
+      }
+
+      *n_durations_out = n_unique;
+
+      return durations;
+    }
+
+    /**
+     * @author https://github.com/SigmaEG/Arcus
+     * @brief Orders running tasks of `simulate_schedule(...)` by finish time, then by position so ties resolve the same way every run
+    */
+    static
+    bool
+    sim_finishes_before(
+      const double* finishes,
+      const int32_t lhs,
+      const int32_t rhs
+    ) {
+      return finishes[lhs] < finishes[rhs] || (finishes[lhs] == finishes[rhs] && lhs < rhs);
+    }
+
+    /**
+     * @author https://github.com/SigmaEG/Arcus
+     * @brief Simulates running tasks in array order on a number of workers, a task starting as soon as a worker and its locks are free
+     * 
+     * @param tasks > Tasks in the order they're taken
+     * @param n_tasks > Number of tasks (size of `tasks`)
+     * @param jobs > Number of workers
+     * @param batched > Whether tasks are taken `jobs` at a time, each batch starting once the previous one finished
+     * @param queue > Scratch array of `n_tasks`
+     * @param running > Scratch array of `jobs`
+     * @param blockers_out > Array of `n_tasks` receiving the task whose completion started each task, -1 for tasks starting at 0
+     * @param finishes_out > Array of `n_tasks` receiving the finish time of each task
+     * 
+     * @return `double` - > The makespan in seconds
+     * @note A task whose locks are held waits without holding up later tasks that don't need them. Tasks are bucketed by lock mask, so each start only looks at the head of every bucket.
+    */
+    static
+    double
+    simulate_schedule(
+      const arcus_sim_task_t* tasks,
+      const int32_t n_tasks,
+      const int32_t jobs,
+      const bool batched,
+      int32_t* queue,
+      int32_t* running,
+      int32_t* blockers_out,
+      double* finishes_out
+    ) {
+      // Lock masks are 0 to 3, bucket `mask` holds queue[offsets[mask]] to queue[offsets[mask + 1] - 1] in task order
+      int32_t offsets[5] = { 0 };
+      int32_t heads[4];
+
+      for (int32_t task_idx = 0; task_idx < n_tasks; ++task_idx)
+        ++offsets[(tasks[task_idx].locks & 3) + 1];
+
+      for (int32_t mask = 0; mask < 4; ++mask) {
+        offsets[mask + 1] += offsets[mask];
+        heads[mask] = offsets[mask];
+      }
+
+      for (int32_t task_idx = 0; task_idx < n_tasks; ++task_idx)
+        queue[heads[tasks[task_idx].locks & 3]++] = task_idx;
+
+      for (int32_t mask = 0; mask < 4; ++mask)
+        heads[mask] = offsets[mask];
+
+      double now = 0.0;
+      int32_t n_running = 0;
+      int32_t started = 0;
+      int32_t held = 0;
+      int32_t last_done = -1;
+      int32_t batch_end = batched ? jobs : n_tasks;
+
+      while (started < n_tasks || n_running > 0) {
+        while (n_running < jobs) {
+          int32_t best = -1;
+
+          for (int32_t mask = 0; mask < 4; ++mask) {
+            if (
+              heads[mask] < offsets[mask + 1]
+              && (mask & held) == 0
+              && queue[heads[mask]] < batch_end
+              && (best == -1 || queue[heads[mask]] < queue[heads[best]])
+            )
+              best = mask;
+          }
+
+          if (best == -1)
+            break;
+
+          int32_t task_idx = queue[heads[best]++];
+
+          held |= best;
+          blockers_out[task_idx] = last_done;
+          finishes_out[task_idx] = now + tasks[task_idx].seconds;
+          ++started;
+
+          // `running` is a min-heap on finish time, so thousands of workers cost a log per step
+          int32_t slot = n_running++;
+
+          while (slot > 0 && sim_finishes_before(finishes_out, task_idx, running[(slot - 1) / 2])) {
+            running[slot] = running[(slot - 1) / 2];
+            slot = (slot - 1) / 2;
+          }
+
+          running[slot] = task_idx;
+        }
+
+        if (n_running == 0) {
+          // Nothing runs and nothing could start, so the batch is over
+          if (!batched)
+            break;
+
+          batch_end += jobs;
+
+          continue;
+        }
+
+        int32_t last = running[--n_running];
+        int32_t slot = 0;
+
+        last_done = running[0];
+
+        while (2 * slot + 1 < n_running) {
+          int32_t child = 2 * slot + 1;
+
+          if (child + 1 < n_running && sim_finishes_before(finishes_out, running[child + 1], running[child]))
+            ++child;
+
+          if (!sim_finishes_before(finishes_out, running[child], last))
+            break;
+
+          running[slot] = running[child];
+          slot = child;
+        }
+
+        if (n_running > 0)
+          running[slot] = last;
+
+        now = finishes_out[last_done];
+        held &= ~(tasks[last_done].locks & 3);
+      }
+
+      return now;
+    }
+  #endif
+
+#pragma endregion LOCAL FUNCTION DECLARATIONS
+
+#pragma region FUNCTION DECLARATIONS
+
+  bool
+  pathexists(const char* path) {
+    struct stat file;
+
+    if (stat(path, &file) == 0)
+      return true;
+
+    return false;
+  }
+
+  #pragma region OS-SPECIFIC DECLARATIONS
+
+    #if defined(__unix__) || defined(__linux__)
+      bool
+      has_neofetch(void) {
+        if (pathexists("/usr/local/bin/neofetch")
+            || pathexists("/usr/bin/neofetch")
+            || pathexists("/var/lib/flatpak/exports/bin/neofetch")
+        ) {
+          return true;
+        }
+
+        return false;
+      }
+
+      bool
+      has_lolcat(void) {
+        if (pathexists("/usr/local/bin/lolcat")
+            || pathexists("/usr/bin/lolcat")
+            || pathexists("/var/lib/flatpak/exports/bin/lolcat")
+        ) {
+          if (LOLCAT_SUPPORT)
+            return true;
+        }
+
+        return false;
+      }
+    #endif
 
     #if defined(_WIN32)
       // Source: https://solarianprogrammer.com/2019/04/08/c-programming-ansi-escape-codes-windows-macos-linux-terminals/
@@ -390,360 +7758,3237 @@
         static HANDLE stdout_handle;
         static DWORD outmode_init;
 
-        void
-        enable_ansi(void) {
-          DWORD out_mode = 0;
-          stdout_handle = GetStdHandle(STD_OUTPUT_HANDLE);
-          
-          if (stdout_handle == INVALID_HANDLE_VALUE)
-            exit(GetLastError());
-          
-          if (!GetConsoleMode(stdout_handle, &out_mode))
-            exit(GetLastError());
-          
-          outmode_init = out_mode;
-          
-          // Enable ANSI escape codes
-          out_mode |= ENABLE_VIRTUAL_TERMINAL_PROCESSING;
-          
-          if (!SetConsoleMode(stdout_handle, out_mode))
-            exit(GetLastError());
+        void
+        enable_ansi(void) {
+          DWORD out_mode = 0;
+          stdout_handle = GetStdHandle(STD_OUTPUT_HANDLE);
+          
+          if (stdout_handle == INVALID_HANDLE_VALUE)
+            exit(GetLastError());
+          
+          if (!GetConsoleMode(stdout_handle, &out_mode))
+            exit(GetLastError());
+          
+          outmode_init = out_mode;
+          
+          // Enable ANSI escape codes
+          out_mode |= ENABLE_VIRTUAL_TERMINAL_PROCESSING;
+          
+          if (!SetConsoleMode(stdout_handle, out_mode))
+            exit(GetLastError());
+        }
+        
+        void
+        disable_ansi(void) {
+          // ANSI \Esc[0m (Normal)
+          printf("\x1b[0m");	
+        
+          if(!SetConsoleMode(stdout_handle, outmode_init))
+            exit(GetLastError());
+        }
+      #else
+        void
+        enable_ansi(void) {}
+        
+        void
+        disable_ansi(void) {
+            // ANSI \Esc[0m (Normal)
+            printf("\x1b[0m");
+        }
+      #endif
+      /* Source-End */
+
+      int32_t setenv(const char* name, const char* value, int32_t overwrite) {   
+        int32_t errcode = 0;
+        
+        if (!overwrite) {
+          size_t envsize = 0;
+          errcode = getenv_s(&envsize, NULL, 0, name);
+          
+          if (errcode || envsize)
+            return errcode;
+        }
+
+        return _putenv_s(name, value);
+      }
+
+      int32_t unsetenv(const char* name) {
+        return setenv(name, "", 1);
+      }
+
+      int32_t isatty(int32_t fd) {
+        return _isatty(fd);
+      }
+    #endif
+
+  #pragma endregion OS-SPECIFIC DECLARATIONS
+
+  char*
+  arcus_getline(
+    int32_t* size_out,
+    const bool remove_delim,
+    const char delimiter,
+    FILE* fstream
+  ) {
+    char* line = (char*)malloc(8 * sizeof(char));
+    int32_t line_sz = 8;
+
+    if (line == NULL) {
+      *size_out = 0;
+      return NULL;
+    }
+
+    char character;
+    int32_t read_count = 0;
+
+    while (fread(&character, 1, sizeof(char), fstream) > 0) {
+      if ((read_count + 1) == line_sz) {
+        char* line_realloc = (char*)realloc(line, (line_sz * 2) * sizeof(char));
+
+        if (line_realloc == NULL)
+          break;
+
+        line = line_realloc;
+        line_sz *= 2;
+
+        line[line_sz - 1] = '\0';
+
+        if (size_out != NULL)
+          *size_out = line_sz - 1;
+      }
+    
+      ++read_count;
+      line[read_count - 1] = character;
+
+      if (character == delimiter)
+        break;
+    }
+
+    if (read_count == 1) {
+      free(line);
+      line = NULL;
+
+      if (size_out != NULL)
+        *size_out = 0;
+
+      return NULL;
+    }
+
+    // Nothing could be read (end of the stream, or a signal interrupted the read), reported as an empty line of size 0
+    if (read_count == 0) {
+      line[0] = '\0';
+
+      if (size_out != NULL)
+        *size_out = 0;
+
+      return line;
+    }
+
+    if (!remove_delim)
+      read_count += 1;
+
+    if (read_count != line_sz) {
+      char* line_realloc = (char*)realloc(line, line_sz * sizeof(char));
+
+      if (line_realloc != NULL)
+        line = line_realloc;
+    }
+
+    line_sz = read_count;
+    line[line_sz - 1] = '\0';
+
+    if (size_out != NULL)
+      *size_out = line_sz;
+
+    return line;
+  }
+
+  bool
+  set_env(
+    const char* name,
+    const char* value
+  ) {
+    #if defined(__unix__) || defined(__linux__)
+      if (has_lolcat()) {
+        char* lolcat = (char*)calloc(strlen("echo \"< ALLOCATING TEMPORARY ENVIRONMENT VARIABLE :  =  >\" | lolcat") + strlen(name) + strlen(value) + 1, sizeof(char));
+        sprintf(lolcat, "echo \"< ALLOCATING TEMPORARY ENVIRONMENT VARIABLE : %s=%s >\" | lolcat", name, value);
+
+        system(lolcat);
+        free(lolcat);
+      } else
+        printf("%s< ALLOCATING TEMPORARY ENVIRONMENT VARIABLE : %s%s=%s%s >\n", KBLU, KMAG, name, value, KBLU);
+    #else
+      printf("%s< ALLOCATING TEMPORARY ENVIRONMENT VARIABLE : %s%s=%s%s >\n", KBLU, KMAG, name, value, KBLU);
+    #endif
+
+    if (setenv(name, value, 1) == 1) {
+      fprintf(stderr, "%s< FAILED TO ALLOCATE TEMPORARY ENVIRONMENT VARIABLE %s\"%s\"%s >\n", KRED, KMAG, name, KBLU);
+
+      return false;
+    }
+    
+    #if defined(__unix__) || defined(__linux__)
+      if (has_lolcat()) {
+        char* lolcat = (char*)calloc(strlen("echo \"< SUCCESSFULLY ALLOCATED TEMPORARY ENVIRONMENT VARIABLE :  =  >\" | lolcat") + strlen(name) + strlen(value) + 1, sizeof(char));
+        sprintf(lolcat, "echo \"< SUCCESSFULLY ALLOCATED TEMPORARY ENVIRONMENT VARIABLE : %s=%s >\" | lolcat", name, value);
+
+        system(lolcat);
+        free(lolcat);
+      }
+      else
+        printf("%s< SUCCESSFULLY ALLOCATED TEMPORARY ENVIRONMENT VARIABLE : %s%s=%s%s >\n", KGRN, KMAG, name, value, KGRN);
+    #else
+        printf("%s< SUCCESSFULLY ALLOCATED TEMPORARY ENVIRONMENT VARIABLE : %s%s=%s%s >\n", KGRN, KMAG, name, value, KGRN);
+    #endif
+
+
+    return true;
+  }
+
+  void
+  init_env_args(const bool remove) {
+    for (int32_t arg_idx = 0; arg_idx < n_env_args; ++arg_idx) {
+      if (!remove) {
+        if (!set_env(env_args[arg_idx][0], env_args[arg_idx][1])) {
+          fprintf(stderr, KRED "< ERROR : QUITTING ARCUS >\n");
+          exit(1);
+        }
+      } else
+        unsetenv(env_args[arg_idx][0]);
+    }
+  }
+
+  bool
+   is_ignored(
+    const char* package,
+    const char** ignore,
+    const int32_t n_ignore
+  ) {
+    for (int32_t ignore_idx = 0; ignore_idx < n_ignore; ++ignore_idx) {
+      if (strcmp(package, ignore[ignore_idx]) == 0)
+        return true;
+    }
+
+    return false;
+  }
+
+  arcus_manager_t
+  package_manager(const char* body) {
+    if (strstr(body, "PACMAN") != NULL)
+      return ARCUS_MANAGER_PACMAN;
+
+    if (strstr(body, "YAY") != NULL)
+      return ARCUS_MANAGER_YAY;
+
+    if (strstr(body, "flatpak install") != NULL)
+      return ARCUS_MANAGER_FLATPAK;
+
+    if (strstr(body, "git clone") != NULL || strstr(body, "github") != NULL)
+      return ARCUS_MANAGER_GIT;
+
+    return ARCUS_MANAGER_SELF;
+  }
+
+  const char*
+  manager_name(const arcus_manager_t manager) {
+    switch (manager) {
+      case ARCUS_MANAGER_PACMAN:
+        return "PACMAN";
+      case ARCUS_MANAGER_YAY:
+        return "YAY-AUR";
+      case ARCUS_MANAGER_FLATPAK:
+        return "FLATPAK";
+      case ARCUS_MANAGER_GIT:
+        return "GITHUB";
+      default:
+        return "SELF-DEFINED";
+    }
+  }
+
+  arcus_manager_t
+  package_manager_at(const int32_t pkg_idx) {
+    if (package_index != NULL)
+      return package_index[pkg_idx].manager;
+
+    return package_manager(package_body(pkg_idx));
+  }
+
+  const char*
+  package_body(const int32_t pkg_idx) {
+    if (packages[pkg_idx][1] != NULL)
+      return packages[pkg_idx][1];
+
+    if (package_index == NULL)
+      return "";
+
+    if (package_file == NULL)
+      package_file = fopen(package_path, "rb");
+
+    arcus_index_entry_t entry = package_index[pkg_idx];
+    char* body = (char*)calloc((size_t)entry.length + 1, sizeof(char));
+
+    if (
+      package_file == NULL
+      || body == NULL
+      || fseek(package_file, (long)entry.offset, SEEK_SET) != 0
+      || fread(body, 1, (size_t)entry.length, package_file) != (size_t)entry.length
+    ) {
+      fprintf(stderr, "%s< FAILED TO READ BODY OF PACKAGE : %s >\n", KRED, packages[pkg_idx][0]);
+      free(body);
+
+      return "";
+    }
+
+    if (package_lines) {
+      int64_t body_len = unescape_field(body, entry.length);
+
+      body[body_len < 0 ? 0 : body_len] = '\0';
+    } else {
+      strip_body(&body);
+    }
+
+    packages[pkg_idx][1] = body;
+
+    return body;
+  }
+
+  bool
+  show_package(const char* pkg_name) {
+    for (int32_t pkg_idx = 0; pkg_idx < n_packages; ++pkg_idx) {
+      if (strcmp(packages[pkg_idx][0], pkg_name) != 0)
+        continue;
+
+      const char* body = package_body(pkg_idx);
+
+      printf("%sPackage:%s %s%s\n", KCYN, KNRM, KMAG, pkg_name);
+      printf("%sManager:%s %s\n", KCYN, KNRM, manager_name(package_manager_at(pkg_idx)));
+      printf("%sPosition:%s %d of %d\n", KCYN, KNRM, pkg_idx + 1, n_packages);
+
+      if (config_embedded)
+        printf("%sSource:%s embedded\n", KCYN, KNRM);
+      else if (package_index != NULL)
+        printf("%sSource:%s %s (offset %lld, %d byte(s))\n", KCYN, KNRM, package_path, (long long)package_index[pkg_idx].offset, package_index[pkg_idx].length);
+      else
+        printf("%sSource:%s %s\n", KCYN, KNRM, package_path);
+
+      printf("%sBody:%s\n%s\n", KCYN, KNRM, body);
+
+      return true;
+    }
+
+    fprintf(stderr, "%s< PACKAGE NOT FOUND : %s >\n", KRED, pkg_name);
+
+    return false;
+  }
+
+  void
+  list_packages(
+    const char** ignore,
+    const int32_t n_ignore
+  ) {
+    printf("%sPackages to Install:\n", KGRN);
+
+    for (int32_t pkg_idx = 0; pkg_idx < n_packages; ++pkg_idx) {
+      const char* pkg_name = packages[pkg_idx][0];
+      const char* pkg_how = manager_name(package_manager_at(pkg_idx));
+      bool ignored = is_ignored(pkg_name, ignore, n_ignore);
+
+      printf("%s[%s]:%s %s%s%s%s\n", KCYN, pkg_how, KNRM, KMAG, pkg_name, KYEL, ignored ? " [IGNORED]" : "");
+    }
+
+    printf("%s\n%d Package%s Ignored%s\n", KYEL, n_ignore, n_ignore == 1 ? "" : "(s)", n_ignore == 0 ? ", See \"arcus {-h --help}\"" : "");
+  }
+
+  void
+  install_packages(
+    const char** ignore,
+    const int32_t n_ignore
+  ) {
+    if (!confirm_installation(ignore, n_ignore)) {
+      printf("%s\n< INSTALLATION CANCELED >\n", KRED);
+      free(ignore);
+
+      exit(0);
+    }
+
+    printf("%sBeginning installation...\n\n", KGRN);
+
+    #if defined(__unix__) || defined(__linux__)
+      arcus_summary_t daemon_summary;
+
+      // Logging, prefetching, elevation, the lockfile, scratch workspaces and opting out of the git cache are per-invocation, so those installs always run in-process
+      if (!no_daemon && log_keep == 0 && prefetch_depth == 0 && !elevate && !locked && !no_git_cache && scratch_max_bytes == 0) {
+        install_cancel_handlers();
+
+        if (install_through_daemon(ignore, n_ignore, &daemon_summary)) {
+          if (daemon_summary.interrupted)
+            printf("%s\n< INSTALLATION CANCELLED : %d installed, %d failed, %d ignored >\n", KRED, daemon_summary.installed, daemon_summary.failed, daemon_summary.ignored);
+
+          printf("\n");
+
+          return;
+        }
+      }
+    #endif
+
+    if (log_keep > 0 && start_log_run(log_keep, log_max_bytes))
+      printf("%s< LOGGING PACKAGES TO : %s%s%s >\n\n", KBLU, KMAG, log_run_dir, KBLU);
+
+    if (elevate && !start_privileged_helper()) {
+      printf("%s< INSTALLATION ABORTED >\n", KRED);
+      free(ignore);
+
+      exit(1);
+    }
+
+    #if defined(__unix__) || defined(__linux__)
+      install_cancel_handlers();
+    #endif
+
+    init_env_args(false);
+    set_env("ARCUS_ROOT", "/");
+
+    printf("\n");
+
+    #if defined(__unix__) || defined(__linux__)
+      begin_status(1, n_packages);
+
+      if (locked && !run_locked_transaction(ignore, n_ignore)) {
+        printf("%s< INSTALLATION ABORTED >\n", KRED);
+        end_status();
+        stop_privileged_helper();
+        init_env_args(true);
+        free_lock();
+        free(ignore);
+
+        exit(1);
+      }
+    #endif
+
+    arcus_summary_t summary = run_packages(ignore, n_ignore);
+
+    #if defined(__unix__) || defined(__linux__)
+      end_status();
+    #endif
+
+    stop_privileged_helper();
+
+    init_env_args(true);
+    unsetenv("ARCUS_PACKAGES");
+    unsetenv("ARCUS_ROOT");
+
+    if (summary.interrupted)
+      printf("%s\n< INSTALLATION CANCELLED : %d installed, %d failed, %d ignored, %d cancelled >\n", KRED, summary.installed, summary.failed, summary.ignored, summary.cancelled);
+
+    printf("\n");
+  }
+
+  arcus_summary_t
+  run_packages(
+    const char** ignore,
+    const int32_t n_ignore
+  ) {
+    arcus_summary_t summary = { 0, 0, 0, 0, false };
+    const char** states = n_packages > 0 ? (const char**)calloc(n_packages, sizeof(char*)) : NULL;
+
+    #if defined(__unix__) || defined(__linux__)
+      pid_t* prefetch = NULL;
+      int32_t prefetching = 0;
+      pid_t group = 0;
+
+      if (prefetch_depth > 0 && n_packages > 0)
+        prefetch = (pid_t*)calloc(n_packages, sizeof(pid_t));
+
+      active_groups = &group;
+      n_active_groups = 1;
+    #endif
+
+    for (int32_t pkg_idx = 0; pkg_idx < n_packages && cancel_signal == 0; ++pkg_idx) {
+      const char* pkg_name = packages[pkg_idx][0];
+      bool ignored = is_ignored(pkg_name, ignore, n_ignore);
+
+      if (ignored) {
+        printf("%s< IGNORING : %s >\n", KYEL, pkg_name);
+        ++summary.ignored;
+
+        if (states != NULL)
+          states[pkg_idx] = "ignored";
+
+        #if defined(__unix__) || defined(__linux__)
+          status_finished(pkg_name, "ignored", 0);
+        #endif
+
+        continue;
+      }
+
+      #if defined(__unix__) || defined(__linux__)
+        // Packages `arcus.lock` covers were already installed by the locked transaction, only their outcome is left to report
+        if (lock_results != NULL && lock_results[pkg_idx] != ARCUS_LOCK_UNCOVERED) {
+          int32_t status = lock_results[pkg_idx];
+
+          if (status != 0) {
+            status = WIFEXITED(status) ? WEXITSTATUS(status) : 128 + WTERMSIG(status);
+
+            fprintf(stderr, "%s< FAILED : %s (STATUS %d, " ARCUS_LOCK_FILE " TRANSACTION) >\n", KRED, pkg_name, status);
+            ++summary.failed;
+          } else {
+            printf("%s< INSTALLED FROM " ARCUS_LOCK_FILE " : %s >\n", KGRN, pkg_name);
+            ++summary.installed;
+          }
+
+          if (states != NULL)
+            states[pkg_idx] = status != 0 ? "failed" : "installed";
+
+          status_finished(pkg_name, status != 0 ? "failed" : "installed", status);
+
+          continue;
+        }
+      #endif
+
+      int32_t ret = 0;
+
+      const char* body = package_body(pkg_idx);
+
+      #if defined(__unix__) || defined(__linux__)
+        if (prefetch != NULL) {
+          reap_prefetches(prefetch, &prefetching, pkg_idx);
+          schedule_prefetches(prefetch, &prefetching, pkg_idx, ignore, n_ignore);
+        }
+
+        char* cached_body = NULL;
+        int32_t mirror_fd = begin_git_cache(body, prefetch != NULL && prefetch[pkg_idx] == ARCUS_PREFETCH_DONE, &group, &cached_body);
+
+        if (cached_body != NULL)
+          body = cached_body;
+      #endif
+
+      set_env("ARCUS_PACKAGES", pkg_name);
+
+      fflush(stdout);
+
+      const char* limit_reason = NULL;
+
+      #if defined(__unix__) || defined(__linux__)
+        struct rusage usage_before;
+
+        status_started(pkg_idx + 1, pkg_name);
+        begin_package_limits(pkg_idx, &usage_before);
+        begin_package_scratch(pkg_idx, pkg_idx + 1);
+
+        if (log_run_dir[0] != '\0')
+          ret = run_captured(pkg_idx, pkg_idx + 1, pkg_name, body, &group);
+        else {
+          bool foreground = false;
+          pid_t pid = spawn_package(pkg_idx, body, -1, &group, &foreground);
+
+          ret = pid < 0 ? -1 : wait_package(pid, &group, foreground);
+        }
+
+        limit_reason = end_package_limits(pkg_idx, ret, &usage_before);
+        end_package_scratch(ret);
+
+        if (mirror_fd >= 0)
+          close(mirror_fd);
+
+        free(cached_body);
+      #else
+        ret = system(body);
+      #endif
+
+      // A Ctrl-C is normally relayed by the Package's group leader, the status covers bodies started without one
+      if (interrupted_by(ret) && cancel_signal == 0)
+        cancel_signal = SIGINT;
+
+      if (cancel_signal != 0) {
+        printf("%s\n< CANCELLED : %s >\n", KRED, pkg_name);
+        ++summary.cancelled;
+
+        if (states != NULL)
+          states[pkg_idx] = "cancelled";
+
+        #if defined(__unix__) || defined(__linux__)
+          status_finished(pkg_name, "cancelled", 128 + cancel_signal);
+        #endif
+
+        break;
+      }
+
+      if (ret != 0) {
+        #if defined(__unix__) || defined(__linux__)
+          ret = WIFEXITED(ret) ? WEXITSTATUS(ret) : 128 + WTERMSIG(ret);
+        #endif
+
+        fprintf(stderr, "%s< FAILED : %s (STATUS %d%s%s) >\n", KRED, pkg_name, ret, limit_reason != NULL ? ", " : "", limit_reason != NULL ? limit_reason : "");
+        ++summary.failed;
+      } else
+        ++summary.installed;
+
+      if (states != NULL)
+        states[pkg_idx] = ret != 0 ? "failed" : "installed";
+
+      #if defined(__unix__) || defined(__linux__)
+        status_finished(pkg_name, ret != 0 ? "failed" : "installed", ret);
+      #endif
+    }
+
+    #if defined(__unix__) || defined(__linux__)
+      active_groups = NULL;
+      n_active_groups = 0;
+
+      if (prefetch != NULL) {
+        cancel_prefetches(prefetch, &prefetching);
+        free(prefetch);
+      }
+    #endif
+
+    if (cancel_signal != 0) {
+      summary.interrupted = true;
+
+      if (states != NULL)
+        write_partial_results(states);
+    }
+
+    free(states);
+
+    return summary;
+  }
+
+  void
+  install_stream(
+    const char** ignore,
+    const int32_t n_ignore
+  ) {
+    FILE* stream = stdin;
+
+    #if defined(__unix__) || defined(__linux__)
+      // The definitions keep stdin, bodies get the terminal (or nothing) so they can't consume the stream
+      int32_t stream_fd = dup(STDIN_FILENO);
+      int32_t in_fd = open("/dev/tty", O_RDONLY);
+
+      if (in_fd < 0)
+        in_fd = open("/dev/null", O_RDONLY);
+
+      stream = stream_fd >= 0 && in_fd >= 0 ? fdopen(stream_fd, "r") : NULL;
+
+      if (stream == NULL) {
+        fprintf(stderr, "%s< FAILED TO READ PACKAGES FROM STDIN >\n", KRED);
+
+        if (stream_fd >= 0)
+          close(stream_fd);
+
+        if (in_fd >= 0)
+          close(in_fd);
+
+        return;
+      }
+
+      fcntl(stream_fd, F_SETFD, FD_CLOEXEC);
+      dup2(in_fd, STDIN_FILENO);
+      close(in_fd);
+    #endif
+
+    printf("%sBeginning installation from stdin...\n\n", KGRN);
+
+    if (log_keep > 0 && start_log_run(log_keep, log_max_bytes))
+      printf("%s< LOGGING PACKAGES TO : %s%s%s >\n\n", KBLU, KMAG, log_run_dir, KBLU);
+
+    if (elevate && !start_privileged_helper()) {
+      printf("%s< INSTALLATION ABORTED >\n", KRED);
+      free(ignore);
+
+      exit(1);
+    }
+
+    #if defined(__unix__) || defined(__linux__)
+      install_cancel_handlers();
+    #endif
+
+    init_env_args(false);
+    set_env("ARCUS_ROOT", "/");
+
+    printf("\n");
+
+    #if defined(__unix__) || defined(__linux__)
+      begin_status(1, 0);
+    #endif
+
+    arcus_summary_t summary = run_stream(stream, ignore, n_ignore);
+
+    #if defined(__unix__) || defined(__linux__)
+      end_status();
+      fclose(stream);
+    #endif
+
+    stop_privileged_helper();
+
+    init_env_args(true);
+    unsetenv("ARCUS_PACKAGES");
+    unsetenv("ARCUS_ROOT");
+
+    if (summary.interrupted)
+      printf("%s\n< INSTALLATION CANCELLED : %d installed, %d failed, %d ignored, %d cancelled >\n", KRED, summary.installed, summary.failed, summary.ignored, summary.cancelled);
+
+    printf("\n");
+  }
+
+  arcus_summary_t
+  run_stream(
+    FILE* stream,
+    const char** ignore,
+    const int32_t n_ignore
+  ) {
+    arcus_summary_t summary = { 0, 0, 0, 0, false };
+    char* row[2] = { NULL, NULL };
+    char** window[1] = { row };
+    const char* states[1] = { NULL };
+    int32_t number = 0;
+    bool parsing_package = false;
+
+    arcus_limits_t limits;
+
+    // Only the Package being installed is held, in a single-row `packages` that the per-Package helpers index with 0
+    packages = window;
+    n_packages = 1;
+
+    if (limit_entries != NULL)
+      package_limits = &limits;
+
+    #if defined(__unix__) || defined(__linux__)
+      pid_t group = 0;
+
+      active_groups = &group;
+      n_active_groups = 1;
+    #endif
+
+    while (cancel_signal == 0 && next_entry(stream, &parsing_package, &row[0], &row[1])) {
+      const char* pkg_name = row[0];
+      const char* body = row[1];
+
+      ++number;
+
+      if (is_ignored(pkg_name, ignore, n_ignore)) {
+        printf("%s< IGNORING : %s >\n", KYEL, pkg_name);
+        ++summary.ignored;
+
+        #if defined(__unix__) || defined(__linux__)
+          status_finished(pkg_name, "ignored", 0);
+        #endif
+
+        free(row[0]);
+        free(row[1]);
+
+        continue;
+      }
+
+      set_env("ARCUS_PACKAGES", pkg_name);
+
+      fflush(stdout);
+
+      int32_t ret = 0;
+      const char* limit_reason = NULL;
+
+      #if defined(__unix__) || defined(__linux__)
+        struct rusage usage_before;
+
+        if (limit_entries != NULL)
+          select_limits(limit_entries, n_limit_entries, pkg_name, &limits);
+
+        char* cached_body = NULL;
+        int32_t mirror_fd = begin_git_cache(body, false, &group, &cached_body);
+
+        if (cached_body != NULL)
+          body = cached_body;
+
+        status_started(number, pkg_name);
+        begin_package_limits(0, &usage_before);
+        begin_package_scratch(0, number);
+
+        if (log_run_dir[0] != '\0')
+          ret = run_captured(0, number, pkg_name, body, &group);
+        else {
+          bool foreground = false;
+          pid_t pid = spawn_package(0, body, -1, &group, &foreground);
+
+          ret = pid < 0 ? -1 : wait_package(pid, &group, foreground);
+        }
+
+        limit_reason = end_package_limits(0, ret, &usage_before);
+        end_package_scratch(ret);
+
+        if (mirror_fd >= 0)
+          close(mirror_fd);
+
+        free(cached_body);
+      #else
+        ret = system(body);
+      #endif
+
+      // A Ctrl-C is normally relayed by the Package's group leader, the status covers bodies started without one
+      if (interrupted_by(ret) && cancel_signal == 0)
+        cancel_signal = SIGINT;
+
+      if (cancel_signal != 0) {
+        printf("%s\n< CANCELLED : %s >\n", KRED, pkg_name);
+        ++summary.cancelled;
+        states[0] = "cancelled";
+
+        // Definitions that weren't read yet can't be listed, the results hold the Package that was cancelled
+        write_partial_results(states);
+      } else if (ret != 0) {
+        #if defined(__unix__) || defined(__linux__)
+          ret = WIFEXITED(ret) ? WEXITSTATUS(ret) : 128 + WTERMSIG(ret);
+        #endif
+
+        fprintf(stderr, "%s< FAILED : %s (STATUS %d%s%s) >\n", KRED, pkg_name, ret, limit_reason != NULL ? ", " : "", limit_reason != NULL ? limit_reason : "");
+        ++summary.failed;
+      } else
+        ++summary.installed;
+
+      #if defined(__unix__) || defined(__linux__)
+        status_finished(pkg_name, cancel_signal != 0 ? "cancelled" : ret != 0 ? "failed" : "installed", cancel_signal != 0 ? 128 + cancel_signal : ret);
+      #endif
+
+      free(row[0]);
+      free(row[1]);
+    }
+
+    #if defined(__unix__) || defined(__linux__)
+      active_groups = NULL;
+      n_active_groups = 0;
+    #endif
+
+    packages = NULL;
+    n_packages = 0;
+    package_limits = NULL;
+
+    summary.interrupted = cancel_signal != 0;
+
+    return summary;
+  }
+
+  bool
+  install_roots(
+    const char** roots,
+    const int32_t n_roots,
+    const int32_t max_jobs,
+    const char** ignore,
+    const int32_t n_ignore
+  ) {
+    if (!confirm_installation(ignore, n_ignore)) {
+      printf("%s\n< INSTALLATION CANCELED >\n", KRED);
+
+      return true;
+    }
+
+    printf("%sBeginning installation into %d root%s, %d at a time...\n\n", KGRN, n_roots, n_roots == 1 ? "" : "(s)", max_jobs);
+
+    if (log_keep > 0 && start_log_run(log_keep, log_max_bytes))
+      printf("%s< LOGGING PACKAGES TO : %s%s%s >\n\n", KBLU, KMAG, log_run_dir, KBLU);
+
+    if (elevate && !start_privileged_helper())
+      return false;
+
+    bool success = true;
+
+    #if defined(__unix__) || defined(__linux__)
+      // Workers escalate their own Package first, so only kill a worker that outlived that
+      cancel_grace = ARCUS_CANCEL_GRACE + 2;
+      install_cancel_handlers();
+
+      if (!pathexists(ARCUS_LOG_DIR) && mkdir(ARCUS_LOG_DIR, 0755) != 0) {
+        fprintf(stderr, "%s< FAILED TO CREATE LOG DIRECTORY : %s >\n", KRED, ARCUS_LOG_DIR);
+        stop_privileged_helper();
+
+        return false;
+      }
+
+      pid_t* pids = (pid_t*)calloc(n_roots, sizeof(pid_t));
+      int32_t* result_fds = (int32_t*)calloc(n_roots, sizeof(int32_t));
+      char** log_paths = (char**)calloc(n_roots, sizeof(char*));
+
+      if (pids == NULL || result_fds == NULL || log_paths == NULL) {
+        fprintf(stderr, "%s< FAILED TO ALLOCATE ROOT TABLE >\n", KRED);
+
+        free(pids);
+        free(result_fds);
+        free(log_paths);
+        stop_privileged_helper();
+
+        return false;
+      }
+
+      int32_t next_root = 0;
+      int32_t running = 0;
+      pid_t slot_workers[ARCUS_STATUS_SLOTS] = { 0 };
+
+      begin_status(max_jobs, n_packages * n_roots);
+
+      active_groups = pids;
+      n_active_groups = n_roots;
+
+      while (next_root < n_roots || running > 0) {
+        while (next_root < n_roots && running < max_jobs && cancel_signal == 0) {
+          int32_t root_idx = next_root++;
+          int32_t fds[2];
+
+          log_paths[root_idx] = root_log_path(roots[root_idx], log_paths, root_idx);
+          pids[root_idx] = -1;
+
+          if (!pathexists(roots[root_idx])) {
+            fprintf(stderr, "%s< FAILED TO STAT ROOT : %s >\n", KRED, roots[root_idx]);
+            success = false;
+
+            continue;
+          }
+
+          if (log_paths[root_idx] == NULL || pipe(fds) != 0) {
+            fprintf(stderr, "%s< FAILED TO PREPARE ROOT : %s >\n", KRED, roots[root_idx]);
+            success = false;
+
+            continue;
+          }
+
+          fflush(stdout);
+          fflush(stderr);
+
+          // Roots beyond `ARCUS_STATUS_SLOTS` at once still count towards the totals, without a slot of their own
+          status_slot = -1;
+
+          for (int32_t slot_idx = 0; slot_idx < ARCUS_STATUS_SLOTS && status_slot == -1; ++slot_idx) {
+            if (slot_workers[slot_idx] == 0)
+              status_slot = slot_idx;
+          }
+
+          pid_t pid = fork();
+
+          if (pid == 0) {
+            setpgid(0, 0);
+            close(fds[0]);
+            run_root_worker(roots[root_idx], log_paths[root_idx], fds[1], ignore, n_ignore);
+          }
+
+          close(fds[1]);
+
+          if (pid > 0)
+            setpgid(pid, pid);
+
+          if (pid < 0) {
+            close(fds[0]);
+            fprintf(stderr, "%s< FAILED TO FORK WORKER FOR ROOT : %s >\n", KRED, roots[root_idx]);
+            success = false;
+
+            continue;
+          }
+
+          pids[root_idx] = pid;
+          result_fds[root_idx] = fds[0];
+          ++running;
+
+          if (status_slot >= 0)
+            slot_workers[status_slot] = pid;
+
+          if (cancel_signal != 0)
+            kill(-pid, cancel_signal);
+
+          printf("%s< STARTED : %s%s%s (log: %s) >\n", KBLU, KMAG, roots[root_idx], KBLU, log_paths[root_idx]);
+        }
+
+        if (running == 0)
+          break;
+
+        int32_t status = 0;
+        pid_t done = waitpid(-1, &status, 0);
+
+        if (done < 0) {
+          if (errno == EINTR)
+            continue;
+
+          break;
+        }
+
+        for (int32_t slot_idx = 0; slot_idx < ARCUS_STATUS_SLOTS; ++slot_idx) {
+          if (slot_workers[slot_idx] == done)
+            slot_workers[slot_idx] = 0;
+        }
+
+        for (int32_t root_idx = 0; root_idx < n_roots; ++root_idx) {
+          if (pids[root_idx] != done)
+            continue;
+
+          arcus_worker_report_t report = { { 0, 0, 0, 0, true }, 0, 0, 0, 0, 0, 0, 0 };
+          bool reported = read(result_fds[root_idx], &report, sizeof(report)) == (ssize_t)sizeof(report);
+          arcus_summary_t summary = report.summary;
+
+          close(result_fds[root_idx]);
+
+          if (reported) {
+            stats.freads += report.freads;
+            stats.bytes_read += report.bytes_read;
+            stats.allocations += report.allocations;
+            stats.bytes_allocated += report.bytes_allocated;
+            stats.children += report.children;
+            stats.worker_cpu_user_usec += report.cpu_user_usec;
+            stats.worker_cpu_system_usec += report.cpu_system_usec;
+          }
+          pids[root_idx] = -1;
+          --running;
+
+          if (!reported || summary.interrupted || !WIFEXITED(status)) {
+            printf(
+              "%s< CANCELLED : %s%s%s > %d installed, %d failed, %d ignored, %d cancelled (log: %s)\n",
+              KRED, KMAG, roots[root_idx], KRED,
+              summary.installed, summary.failed, summary.ignored, summary.cancelled, log_paths[root_idx]
+            );
+            success = false;
+          } else {
+            printf(
+              "%s< FINISHED : %s%s%s > %d installed, %d failed, %d ignored (log: %s)\n",
+              summary.failed == 0 ? KGRN : KRED, KMAG, roots[root_idx], summary.failed == 0 ? KGRN : KRED,
+              summary.installed, summary.failed, summary.ignored, log_paths[root_idx]
+            );
+
+            if (summary.failed != 0)
+              success = false;
+          }
+
+          break;
+        }
+      }
+
+      active_groups = NULL;
+      n_active_groups = 0;
+      end_status();
+
+      for (int32_t root_idx = next_root; root_idx < n_roots; ++root_idx)
+        printf("%s< NOT STARTED : %s%s%s >\n", KRED, KMAG, roots[root_idx], KRED);
+
+      if (next_root < n_roots)
+        success = false;
+
+      for (int32_t root_idx = 0; root_idx < n_roots; ++root_idx)
+        free(log_paths[root_idx]);
+
+      free(pids);
+      free(result_fds);
+      free(log_paths);
+    #else
+      (void)max_jobs;
+
+      init_env_args(false);
+
+      for (int32_t root_idx = 0; root_idx < n_roots; ++root_idx) {
+        set_env("ARCUS_ROOT", roots[root_idx]);
+
+        arcus_summary_t summary = run_packages(ignore, n_ignore);
+
+        printf(
+          "%s< FINISHED : %s%s%s > %d installed, %d failed, %d ignored\n",
+          summary.failed == 0 ? KGRN : KRED, KMAG, roots[root_idx], summary.failed == 0 ? KGRN : KRED,
+          summary.installed, summary.failed, summary.ignored
+        );
+
+        if (summary.failed != 0 || summary.interrupted)
+          success = false;
+
+        if (summary.interrupted)
+          break;
+      }
+
+      init_env_args(true);
+      unsetenv("ARCUS_PACKAGES");
+      unsetenv("ARCUS_ROOT");
+    #endif
+
+    stop_privileged_helper();
+    printf("\n");
+
+    return success;
+  }
+
+  bool
+  start_privileged_helper(void) {
+    #if defined(__unix__) || defined(__linux__)
+      char self_path[ARCUS_PATH_MAX] = "";
+      char launcher_path[ARCUS_PATH_MAX] = "";
+      char real_sudo[ARCUS_PATH_MAX] = "";
+      char cwd[ARCUS_PATH_MAX] = "";
+      const char* launcher = getenv("ARCUS_SUDO");
+
+      if (launcher == NULL || launcher[0] == '\0')
+        launcher = "sudo";
+
+      bool resolved = false;
+
+      #if defined(__linux__)
+        ssize_t self_len = readlink("/proc/self/exe", self_path, sizeof(self_path) - 1);
+
+        if (self_len > 0) {
+          self_path[self_len] = '\0';
+          resolved = true;
+        }
+      #endif
+
+      if (!resolved && (arcus_argv0 == NULL || realpath(arcus_argv0, self_path) == NULL)) {
+        fprintf(stderr, "%s< FAILED TO RESOLVE THE ARCUS EXECUTABLE FOR THE PRIVILEGED HELPER >\n", KRED);
+
+        return false;
+      }
+
+      if (!find_executable(launcher, launcher_path)) {
+        fprintf(stderr, "%s< FAILED TO FIND %s%s%s TO START THE PRIVILEGED HELPER >\n", KRED, KMAG, launcher, KRED);
+
+        return false;
+      }
+
+      if (!find_executable("sudo", real_sudo))
+        real_sudo[0] = '\0';
+
+      if (getcwd(cwd, sizeof(cwd)) == NULL || (!pathexists(ARCUS_LOG_DIR) && mkdir(ARCUS_LOG_DIR, 0755) != 0)) {
+        fprintf(stderr, "%s< FAILED TO CREATE LOG DIRECTORY : %s >\n", KRED, ARCUS_LOG_DIR);
+
+        return false;
+      }
+
+      const char* tmp_dir = getenv("TMPDIR");
+
+      snprintf(helper_dir, sizeof(helper_dir), "%s/arcus-helper-XXXXXX", tmp_dir != NULL && tmp_dir[0] == '/' && strlen(tmp_dir) < 64 ? tmp_dir : "/tmp");
+
+      if (mkdtemp(helper_dir) == NULL) {
+        fprintf(stderr, "%s< FAILED TO CREATE PRIVILEGED HELPER DIRECTORY : %s >\n", KRED, helper_dir);
+        helper_dir[0] = '\0';
+
+        return false;
+      }
+
+      char shim_path[ARCUS_PATH_MAX + 16];
+      char socket_path[ARCUS_PATH_MAX + 16];
+      char audit_path[ARCUS_PATH_MAX + 32];
+      char uid_arg[24];
+      char pid_arg[24];
+      int32_t control[2] = { -1, -1 };
+      int32_t ready[2] = { -1, -1 };
+
+      snprintf(shim_path, sizeof(shim_path), "%s/bin", helper_dir);
+      snprintf(socket_path, sizeof(socket_path), "%s/helper.sock", helper_dir);
+      snprintf(audit_path, sizeof(audit_path), "%s/%s/helper-audit.log", cwd, ARCUS_LOG_DIR);
+      snprintf(uid_arg, sizeof(uid_arg), "%lu", (unsigned long)getuid());
+      snprintf(pid_arg, sizeof(pid_arg), "%ld", (long)getpid());
+
+      int32_t audit_fd = open(audit_path, O_WRONLY | O_CREAT | O_APPEND, 0600);
+
+      if (audit_fd >= 0)
+        close(audit_fd);
+
+      if (
+        mkdir(shim_path, 0700) != 0 ||
+        strlen(socket_path) >= sizeof(((struct sockaddr_un*)0)->sun_path) ||
+        pipe(control) != 0 ||
+        pipe(ready) != 0
+      ) {
+        fprintf(stderr, "%s< FAILED TO PREPARE THE PRIVILEGED HELPER IN : %s >\n", KRED, helper_dir);
+
+        if (control[0] >= 0) {
+          close(control[0]);
+          close(control[1]);
+        }
+
+        stop_privileged_helper();
+
+        return false;
+      }
+
+      // Only this installation's Packages inherit the token, other processes of the same user can't reach the helper without it
+      unsigned char token_bytes[ARCUS_HELPER_TOKEN_SIZE];
+      int32_t random_fd = open("/dev/urandom", O_RDONLY | O_CLOEXEC);
+      bool have_token = random_fd >= 0 && read_exact(random_fd, (char*)token_bytes, sizeof(token_bytes));
+
+      if (random_fd >= 0)
+        close(random_fd);
+
+      if (!have_token) {
+        fprintf(stderr, "%s< FAILED TO GENERATE A SESSION TOKEN FOR THE PRIVILEGED HELPER >\n", KRED);
+        close(control[0]);
+        close(control[1]);
+        close(ready[0]);
+        close(ready[1]);
+        stop_privileged_helper();
+
+        return false;
+      }
+
+      for (int32_t byte_idx = 0; byte_idx < ARCUS_HELPER_TOKEN_SIZE; ++byte_idx)
+        snprintf(helper_token + byte_idx * 2, 3, "%02x", token_bytes[byte_idx]);
+
+      printf("%s< AUTHENTICATING PRIVILEGED HELPER WITH : %s%s%s >\n", KBLU, KMAG, launcher_path, KBLU);
+      fflush(stdout);
+      fflush(stderr);
+
+      helper_pid = fork();
+
+      if (helper_pid == 0) {
+        dup2(control[0], STDIN_FILENO);
+        dup2(ready[1], STDOUT_FILENO);
+        close(control[0]);
+        close(control[1]);
+        close(ready[0]);
+        close(ready[1]);
+
+        execl(launcher_path, launcher_path, self_path, "--privileged-helper", socket_path, uid_arg, audit_path, pid_arg, (char*)NULL);
+        _exit(127);
+      }
+
+      close(control[0]);
+      close(ready[1]);
+
+      char token_line[ARCUS_HELPER_TOKEN_SIZE * 2 + 16];
+      bool sent_token = helper_pid > 0 && helper_token[0] != '\0';
+
+      snprintf(token_line, sizeof(token_line), "TOKEN %s\n", helper_token);
+      sent_token = sent_token && write_all(control[1], token_line, strlen(token_line));
+
+      char line[64] = "";
+      bool started = sent_token && read_protocol_line(ready[0], line, sizeof(line)) && strcmp(line, ARCUS_HELPER_PROTOCOL " READY") == 0;
+
+      close(ready[0]);
+      helper_control_fd = control[1];
+      fcntl(helper_control_fd, F_SETFD, FD_CLOEXEC);
+
+      char shim_link[ARCUS_PATH_MAX + 32];
+
+      snprintf(shim_link, sizeof(shim_link), "%s/sudo", shim_path);
+
+      if (!started || symlink(self_path, shim_link) != 0) {
+        fprintf(stderr, "%s< PRIVILEGED HELPER FAILED TO START >\n", KRED);
+        stop_privileged_helper();
+
+        return false;
+      }
+
+      const char* path = getenv("PATH");
+      size_t path_len = strlen(shim_path) + (path != NULL ? strlen(path) : 0) + 2;
+      char* shim_search = (char*)calloc(path_len, sizeof(char));
+
+      helper_saved_path = path != NULL ? strdup(path) : NULL;
+
+      if (shim_search == NULL || (path != NULL && helper_saved_path == NULL)) {
+        fprintf(stderr, "%s< FAILED TO ALLOCATE PATH FOR THE PRIVILEGED HELPER >\n", KRED);
+        free(shim_search);
+        stop_privileged_helper();
+
+        return false;
+      }
+
+      snprintf(shim_search, path_len, "%s%s%s", shim_path, path != NULL ? ":" : "", path != NULL ? path : "");
+      setenv("PATH", shim_search, 1);
+      setenv("ARCUS_HELPER_SOCKET", socket_path, 1);
+      setenv("ARCUS_HELPER_TOKEN", helper_token, 1);
+
+      if (real_sudo[0] != '\0')
+        setenv("ARCUS_REAL_SUDO", real_sudo, 1);
+
+      free(shim_search);
+
+      printf("%s< PRIVILEGED HELPER READY, AUDIT LOG : %s%s%s >\n\n", KGRN, KMAG, audit_path, KGRN);
+
+      return true;
+    #else
+      fprintf(stderr, "%s< --elevate IS NOT SUPPORTED ON THIS PLATFORM >\n", KRED);
+
+      return false;
+    #endif
+  }
+
+  void
+  stop_privileged_helper(void) {
+    #if defined(__unix__) || defined(__linux__)
+      if (helper_control_fd >= 0) {
+        close(helper_control_fd);
+        helper_control_fd = -1;
+      }
+
+      if (helper_pid > 0) {
+        while (waitpid(helper_pid, NULL, 0) < 0 && errno == EINTR);
+
+        helper_pid = -1;
+      }
+
+      if (helper_dir[0] != '\0') {
+        char path[ARCUS_PATH_MAX + 32];
+
+        snprintf(path, sizeof(path), "%s/bin/sudo", helper_dir);
+        unlink(path);
+        snprintf(path, sizeof(path), "%s/bin", helper_dir);
+        rmdir(path);
+        // Owned by root when the helper was started through the real sudo, the helper unlinks it itself
+        snprintf(path, sizeof(path), "%s/helper.sock", helper_dir);
+        unlink(path);
+        rmdir(helper_dir);
+        helper_dir[0] = '\0';
+      }
+
+      if (getenv("ARCUS_HELPER_SOCKET") != NULL) {
+        if (helper_saved_path != NULL)
+          setenv("PATH", helper_saved_path, 1);
+        else
+          unsetenv("PATH");
+
+        unsetenv("ARCUS_HELPER_SOCKET");
+        unsetenv("ARCUS_HELPER_TOKEN");
+        unsetenv("ARCUS_REAL_SUDO");
+      }
+
+      memset(helper_token, 0, sizeof(helper_token));
+
+      free(helper_saved_path);
+      helper_saved_path = NULL;
+    #endif
+  }
+
+  int32_t
+  run_privileged_helper(
+    const char* socket_path,
+    const uint32_t uid,
+    const char* audit_path,
+    const pid_t installer
+  ) {
+    #if defined(__unix__) || defined(__linux__)
+      // Interrupts reach the installation through the terminal, the helper only ends once its control pipe closes
+      signal(SIGINT, SIG_IGN);
+      signal(SIGQUIT, SIG_IGN);
+      signal(SIGPIPE, SIG_IGN);
+      // Handing the terminal to a command and back happens from a background group
+      signal(SIGTTOU, SIG_IGN);
+      umask(077);
+
+      // The token never appears in argv (visible to every user), the installation sends it first over the control pipe
+      char token_line[ARCUS_HELPER_TOKEN_SIZE * 2 + 16];
+
+      if (
+        !read_protocol_line(STDIN_FILENO, token_line, sizeof(token_line)) ||
+        strncmp(token_line, "TOKEN ", 6) != 0 ||
+        strlen(token_line + 6) != ARCUS_HELPER_TOKEN_SIZE * 2
+      ) {
+        fprintf(stderr, "< PRIVILEGED HELPER RECEIVED NO SESSION TOKEN >\n");
+
+        return 1;
+      }
+
+      snprintf(helper_token, sizeof(helper_token), "%s", token_line + 6);
+      helper_installer = installer;
+
+      struct sockaddr_un address;
+      int32_t listen_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+
+      memset(&address, 0, sizeof(address));
+      address.sun_family = AF_UNIX;
+
+      if (listen_fd < 0 || strlen(socket_path) >= sizeof(address.sun_path)) {
+        fprintf(stderr, "< PRIVILEGED HELPER FAILED TO CREATE SOCKET : %s >\n", socket_path);
+
+        return 1;
+      }
+
+      memcpy(address.sun_path, socket_path, strlen(socket_path));
+      unlink(socket_path);
+
+      if (
+        bind(listen_fd, (struct sockaddr*)&address, sizeof(address)) != 0 ||
+        chown(socket_path, (uid_t)uid, (gid_t)-1) != 0 ||
+        chmod(socket_path, 0600) != 0 ||
+        listen(listen_fd, 16) != 0
+      ) {
+        fprintf(stderr, "< PRIVILEGED HELPER FAILED TO LISTEN ON : %s >\n", socket_path);
+        close(listen_fd);
+        unlink(socket_path);
+
+        return 1;
+      }
+
+      // The log lives in a directory the user controls, never follow a link there or append to a file that isn't theirs alone
+      int32_t audit_fd = open(audit_path, O_WRONLY | O_APPEND | O_NOFOLLOW | O_NOCTTY | O_NONBLOCK | O_CLOEXEC);
+      struct stat audit_info;
+      FILE* audit = NULL;
+
+      if (
+        audit_fd >= 0 &&
+        fstat(audit_fd, &audit_info) == 0 &&
+        S_ISREG(audit_info.st_mode) &&
+        audit_info.st_uid == (uid_t)uid &&
+        audit_info.st_nlink == 1
+      ) {
+        audit = fdopen(audit_fd, "a");
+      }
+
+      if (audit == NULL) {
+        fprintf(stderr, "< PRIVILEGED HELPER REFUSED AUDIT LOG : %s >\n", audit_path);
+
+        if (audit_fd >= 0)
+          close(audit_fd);
+      }
+
+      audit_request(audit, (int64_t)getuid(), (int64_t)getppid(), "START", NULL, NULL, 0);
+
+      printf(ARCUS_HELPER_PROTOCOL " READY\n");
+      fflush(stdout);
+
+      int32_t null_fd = open("/dev/null", O_WRONLY);
+
+      if (null_fd >= 0) {
+        dup2(null_fd, STDOUT_FILENO);
+        close(null_fd);
+      }
+
+      while (true) {
+        struct pollfd events[2] = { { listen_fd, POLLIN, 0 }, { STDIN_FILENO, POLLIN, 0 } };
+
+        while (waitpid(-1, NULL, WNOHANG) > 0);
+
+        if (poll(events, 2, 1000) < 0) {
+          if (errno == EINTR)
+            continue;
+
+          break;
+        }
+
+        if (events[1].revents != 0) {
+          char discard[64];
+
+          if (read(STDIN_FILENO, discard, sizeof(discard)) <= 0)
+            break;
+        }
+
+        if ((events[0].revents & POLLIN) == 0)
+          continue;
+
+        int32_t conn_fd = accept(listen_fd, NULL, NULL);
+
+        if (conn_fd < 0)
+          continue;
+
+        pid_t pid = fork();
+
+        if (pid == 0) {
+          close(listen_fd);
+          serve_helper_request(conn_fd, uid, audit);
+          close(conn_fd);
+
+          if (audit != NULL)
+            fclose(audit);
+
+          _exit(0);
+        }
+
+        close(conn_fd);
+      }
+
+      close(listen_fd);
+      unlink(socket_path);
+      audit_request(audit, (int64_t)getuid(), (int64_t)getppid(), "STOP", NULL, NULL, 0);
+
+      if (audit != NULL)
+        fclose(audit);
+
+      return 0;
+    #else
+      (void)socket_path;
+      (void)uid;
+      (void)audit_path;
+      (void)installer;
+
+      return 1;
+    #endif
+  }
+
+  int32_t
+  run_sudo_shim(
+    const int32_t argc,
+    const char** argv
+  ) {
+    #if defined(__unix__) || defined(__linux__)
+      const char* socket_path = getenv("ARCUS_HELPER_SOCKET");
+      const char* real_sudo = getenv("ARCUS_REAL_SUDO");
+      const char* token = getenv("ARCUS_HELPER_TOKEN");
+      struct sockaddr_un address;
+      int32_t conn_fd = -1;
+
+      memset(&address, 0, sizeof(address));
+      address.sun_family = AF_UNIX;
+
+      // Options (-u, -E, -v ...) and VAR=value assignments need the real sudo, only plain commands are forwarded
+      bool forward = argc >= 2 && argv[1][0] != '-' && strchr(argv[1], '=') == NULL && socket_path != NULL && token != NULL && strlen(socket_path) < sizeof(address.sun_path);
+
+      if (forward) {
+        memcpy(address.sun_path, socket_path, strlen(socket_path));
+        conn_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+
+        if (conn_fd >= 0 && connect(conn_fd, (struct sockaddr*)&address, sizeof(address)) != 0) {
+          fprintf(stderr, "arcus: privileged helper unavailable, falling back to sudo\n");
+          close(conn_fd);
+          conn_fd = -1;
+        }
+      }
+
+      if (conn_fd < 0) {
+        if (real_sudo != NULL && real_sudo[0] != '\0')
+          execv(real_sudo, (char* const*)argv);
+
+        fprintf(stderr, "arcus: no sudo to fall back to\n");
+
+        return 1;
+      }
+
+      signal(SIGPIPE, SIG_IGN);
+
+      const char magic[] = ARCUS_HELPER_PROTOCOL " EXEC\n";
+      int32_t fds[3] = { STDIN_FILENO, STDOUT_FILENO, STDERR_FILENO };
+      union {
+        struct cmsghdr align;
+        char buffer[CMSG_SPACE(sizeof(fds))];
+      } control;
+      struct iovec iov = { (void*)magic, sizeof(magic) - 1 };
+      struct msghdr message;
+
+      memset(&control, 0, sizeof(control));
+      memset(&message, 0, sizeof(message));
+      message.msg_iov = &iov;
+      message.msg_iovlen = 1;
+      message.msg_control = control.buffer;
+      message.msg_controllen = sizeof(control.buffer);
+
+      struct cmsghdr* cmsg = CMSG_FIRSTHDR(&message);
+
+      cmsg->cmsg_level = SOL_SOCKET;
+      cmsg->cmsg_type = SCM_RIGHTS;
+      cmsg->cmsg_len = CMSG_LEN(sizeof(fds));
+      memcpy(CMSG_DATA(cmsg), fds, sizeof(fds));
+
+      char cwd[ARCUS_PATH_MAX];
+      char line[64];
+      bool sent = sendmsg(conn_fd, &message, 0) == (ssize_t)(sizeof(magic) - 1) && getcwd(cwd, sizeof(cwd)) != NULL;
+
+      sent = sent && write_protocol_field(conn_fd, "TOKEN", token);
+      sent = sent && write_protocol_field(conn_fd, "CWD", cwd);
+      snprintf(line, sizeof(line), "ARGC %d\n", argc - 1);
+      sent = sent && write_all(conn_fd, line, strlen(line));
+
+      for (int32_t arg_idx = 1; sent && arg_idx < argc; ++arg_idx)
+        sent = write_protocol_field(conn_fd, "ARG", argv[arg_idx]);
+
+      sent = sent && write_all(conn_fd, "END\n", 4);
+
+      if (!sent || !read_protocol_line(conn_fd, line, sizeof(line))) {
+        fprintf(stderr, "arcus: privileged helper request failed\n");
+        close(conn_fd);
+
+        return 1;
+      }
+
+      close(conn_fd);
+
+      if (strncmp(line, "EXIT ", 5) != 0) {
+        fprintf(stderr, "arcus: privileged helper refused request (%s)\n", line);
+
+        return 1;
+      }
+
+      return (int32_t)strtol(line + 5, NULL, 10);
+    #else
+      (void)argc;
+      (void)argv;
+
+      return 1;
+    #endif
+  }
+
+  int32_t
+  run_daemon(const char* group) {
+    #if defined(__unix__) || defined(__linux__)
+      arcus_daemon_t daemon = { -1, NULL, 0, NULL, 0, NULL, false, -1, "", "" };
+      char socket_path[ARCUS_PATH_MAX];
+      struct sockaddr_un address;
+
+      daemon_socket_path(socket_path, sizeof(socket_path), getuid());
+
+      if (group != NULL && group[0] != '\0') {
+        struct group* entry = getgrnam(group);
+
+        if (entry == NULL) {
+          fprintf(stderr, "%s< arcusd GROUP DOES NOT EXIST : %s >\n", KRED, group);
+
+          return 1;
+        }
+
+        daemon.group = (int64_t)entry->gr_gid;
+      }
+
+      if (strlen(socket_path) >= sizeof(address.sun_path)) {
+        fprintf(stderr, "%s< arcusd SOCKET PATH IS TOO LONG : %s >\n", KRED, socket_path);
+
+        return 1;
+      }
+
+      if (realpath(config_dir, daemon.config_real) == NULL || !load_daemon_config(&daemon)) {
+        fprintf(stderr, "%s< arcusd FAILED TO LOAD CONFIGURATION FROM %s >\n", KRED, config_dir);
+        free(daemon.results);
+
+        return 1;
+      }
+
+      memset(&address, 0, sizeof(address));
+      address.sun_family = AF_UNIX;
+      memcpy(address.sun_path, socket_path, strlen(socket_path));
+
+      daemon.listen_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+
+      mode_t old_umask = umask(077);
+      bool bound = daemon.listen_fd >= 0 && bind(daemon.listen_fd, (struct sockaddr*)&address, sizeof(address)) == 0;
+      bool running = false;
+
+      // A socket nobody answers on was left behind by an arcusd that didn't exit cleanly
+      if (!bound && daemon.listen_fd >= 0 && errno == EADDRINUSE) {
+        int32_t probe_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        running = probe_fd >= 0 && connect(probe_fd, (struct sockaddr*)&address, sizeof(address)) == 0;
+
+        if (probe_fd >= 0)
+          close(probe_fd);
+
+        if (running)
+          fprintf(stderr, "%s< arcusd IS ALREADY RUNNING ON : %s >\n", KRED, socket_path);
+        else if (unlink(socket_path) == 0)
+          bound = bind(daemon.listen_fd, (struct sockaddr*)&address, sizeof(address)) == 0;
+      }
+
+      umask(old_umask);
+
+      // Members of the group may connect too, they can still only pick from the daemon's configuration
+      if (bound && daemon.group >= 0 && (chown(socket_path, (uid_t)-1, (gid_t)daemon.group) != 0 || chmod(socket_path, 0660) != 0)) {
+        int32_t share_errno = errno;
+
+        unlink(socket_path);
+        errno = share_errno;
+        bound = false;
+      }
+
+      if (!bound || listen(daemon.listen_fd, 16) != 0) {
+        if (!running)
+          fprintf(stderr, "%s< arcusd FAILED TO LISTEN ON : %s (%s) >\n", KRED, socket_path, strerror(errno));
+
+        if (daemon.listen_fd >= 0)
+          close(daemon.listen_fd);
+
+        free(daemon.results);
+        init_env_args(true);
+        free_config();
+
+        return 1;
+      }
+
+      fcntl(daemon.listen_fd, F_SETFD, FD_CLOEXEC);
+      signal(SIGPIPE, SIG_IGN);
+      install_cancel_handlers();
+
+      // Bodies can't prompt anybody, there is no terminal on the other end of the socket
+      int32_t null_fd = open("/dev/null", O_RDONLY);
+
+      if (null_fd >= 0) {
+        dup2(null_fd, STDIN_FILENO);
+        close(null_fd);
+      }
+
+      printf("%s< arcusd LISTENING ON %s%s%s FOR %s%s%s (%d PACKAGE(S)) >\n", KGRN, KMAG, socket_path, KGRN, KMAG, daemon.config_real, KGRN, n_packages);
+      fflush(stdout);
+
+      // A single table for as long as the daemon runs, its one slot follows the invocation of whichever client it serves
+      begin_status(1, 0);
+
+      int64_t window_end_ns = 0;
+
+      while (cancel_signal == 0) {
+        int32_t lead_idx = -1;
+
+        for (int32_t pkg_idx = 0; pkg_idx < n_packages && lead_idx == -1; ++pkg_idx) {
+          if (daemon.results[pkg_idx] == ARCUS_DAEMON_NOT_RUN && daemon_package_wanted(&daemon, pkg_idx))
+            lead_idx = pkg_idx;
+        }
+
+        // Once every client has its results, the next request starts a new batch
+        if (lead_idx == -1)
+          window_end_ns = 0;
+        else if (window_end_ns == 0)
+          window_end_ns = stats_now_ns() + (int64_t)ARCUS_DAEMON_COALESCE_MS * 1000000;
+
+        // A new batch waits briefly so requests arriving together share its invocations
+        int64_t window_ns = lead_idx == -1 ? -1 : window_end_ns - stats_now_ns();
+
+        if (lead_idx == -1 || window_ns > 0) {
+          struct pollfd* events = (struct pollfd*)calloc((size_t)daemon.n_requests + 1, sizeof(struct pollfd));
+          int32_t timeout_ms = lead_idx == -1 ? -1 : (int32_t)(window_ns / 1000000) + 1;
+
+          if (events == NULL)
+            break;
+
+          // Pending requests must still be checked against their deadline
+          if (daemon.n_requests > 0 && (timeout_ms < 0 || timeout_ms > 1000))
+            timeout_ms = 1000;
+
+          nfds_t n_sockets = poll_daemon_sockets(&daemon, events);
+          int32_t ready = poll(events, n_sockets, timeout_ms);
+
+          if (ready >= 0)
+            serve_daemon_sockets(&daemon, events, n_sockets);
+
+          free(events);
+
+          continue;
+        }
+
+        run_daemon_batch(&daemon, lead_idx, true);
+        fflush(stdout);
+      }
+
+      printf("%s< arcusd STOPPING >\n", KYEL);
+      end_status();
+
+      while (daemon.n_clients > 0)
+        drop_daemon_client(&daemon, daemon.n_clients - 1, "DISCONNECTED");
+
+      while (daemon.n_requests > 0)
+        drop_daemon_request(&daemon, daemon.n_requests - 1, "STOPPING");
+
+      close(daemon.listen_fd);
+      unlink(socket_path);
+      free(daemon.clients);
+      free(daemon.requests);
+      free(daemon.results);
+      init_env_args(true);
+      free_config();
+
+      return 0;
+    #else
+      (void)group;
+      fprintf(stderr, "%s< arcusd IS NOT SUPPORTED ON THIS PLATFORM >\n", KRED);
+
+      return 1;
+    #endif
+  }
+
+  bool
+  lock_packages(
+    const char** ignore,
+    const int32_t n_ignore
+  ) {
+    #if defined(__unix__) || defined(__linux__)
+      char cache[ARCUS_PATH_MAX];
+      char lock_path[ARCUS_PATH_MAX];
+      char tmp_path[ARCUS_PATH_MAX + 32];
+
+      snprintf(lock_path, sizeof(lock_path), "%s/" ARCUS_LOCK_FILE, config_dir);
+      snprintf(tmp_path, sizeof(tmp_path), "%s.tmp", lock_path);
+
+      if (!lock_cache_path(cache, sizeof(cache))) {
+        fprintf(stderr, "%s< FAILED TO RESOLVE THE PACKAGE CACHE : " ARCUS_LOCK_CACHE_DIR " >\n", KRED);
+
+        return false;
+      }
+
+      if ((!pathexists(ARCUS_CACHE_DIR) && mkdir(ARCUS_CACHE_DIR, 0755) != 0) || (!pathexists(ARCUS_LOCK_CACHE_DIR) && mkdir(ARCUS_LOCK_CACHE_DIR, 0755) != 0)) {
+        fprintf(stderr, "%s< FAILED TO CREATE THE PACKAGE CACHE : %s >\n", KRED, cache);
+
+        return false;
+      }
+
+      arcus_lock_entry_t* entries = NULL;
+      int32_t n_entries = 0;
+      int32_t n_locked = 0;
+      size_t names_size = 1;
+      bool locked_all = true;
+
+      for (int32_t pkg_idx = 0; pkg_idx < n_packages; ++pkg_idx) {
+        const char* pkg_name = packages[pkg_idx][0];
+        arcus_manager_t manager = package_manager_at(pkg_idx);
+
+        if (is_ignored(pkg_name, ignore, n_ignore) || (manager != ARCUS_MANAGER_PACMAN && manager != ARCUS_MANAGER_YAY))
+          continue;
+
+        char* targets = lock_targets(pkg_idx);
+
+        if (targets == NULL) {
+          fprintf(stderr, "%s< %s%s%s ISN'T A SINGLE PACMAN/YAY COMMAND, LEAVING IT UNLOCKED >\n", KYEL, KMAG, pkg_name, KYEL);
+          locked_all = false;
+
+          continue;
+        }
+
+        size_t command_size = strlen(targets) + 64;
+        char* command = (char*)calloc(command_size, sizeof(char));
+        bool valid = targets[0] != '\0' && command != NULL;
+
+        if (valid)
+          snprintf(command, command_size, "pacman -Sp --print-format '%%n %%v %%f' --");
+
+        for (char* target = valid ? strtok(targets, "\n") : NULL; target != NULL && valid; target = strtok(NULL, "\n")) {
+          valid = lock_token_valid(target);
+          snprintf(command + strlen(command), command_size - strlen(command), " %s", target);
+        }
+
+        int32_t status = -1;
+        char* resolved = valid ? capture_command(command, pkg_name, &status) : NULL;
+        int32_t n_before = n_entries;
+
+        free(targets);
+        free(command);
+
+        for (char* line = resolved != NULL && status == 0 ? strtok(resolved, "\n") : NULL; line != NULL; line = strtok(NULL, "\n")) {
+          char* version = strchr(line, ' ');
+          char* file = version != NULL ? strchr(version + 1, ' ') : NULL;
+
+          if (file == NULL)
+            continue;
+
+          *version++ = '\0';
+          *file++ = '\0';
+
+          arcus_lock_entry_t* re_alloc = (arcus_lock_entry_t*)realloc(entries, (n_entries + 1) * sizeof(arcus_lock_entry_t));
+
+          if (!lock_token_valid(line) || !lock_token_valid(version) || !lock_token_valid(file) || re_alloc == NULL) {
+            fprintf(stderr, "%s< UNEXPECTED OUTPUT FROM pacman -Sp FOR %s : %s %s %s >\n", KRED, pkg_name, line, version, file);
+
+            if (re_alloc != NULL)
+              entries = re_alloc;
+
+            continue;
+          }
+
+          entries = re_alloc;
+          entries[n_entries] = (arcus_lock_entry_t){ pkg_idx, strdup(line), strdup(version), strdup(file), "" };
+          names_size += strlen(line) + 1;
+          ++n_entries;
+        }
+
+        free(resolved);
+
+        if (n_entries == n_before) {
+          fprintf(stderr, "%s< COULD NOT RESOLVE %s%s%s, LEAVING IT UNLOCKED >\n", KYEL, KMAG, pkg_name, KYEL);
+          locked_all = false;
+        } else
+          ++n_locked;
+      }
+
+      const char* pacman = getenv("ARCUS_LOCKFILE_PACMAN_CMD") != NULL ? getenv("ARCUS_LOCKFILE_PACMAN_CMD") : ARCUS_LOCKFILE_PACMAN;
+      size_t command_size = strlen(pacman) + strlen(cache) + names_size + 64;
+      char* command = (char*)calloc(command_size, sizeof(char));
+      int32_t status = 0;
+      bool written = command != NULL;
+
+      if (written && n_entries > 0) {
+        snprintf(command, command_size, "%s -Sw --noconfirm --cachedir '%s' --", pacman, cache);
+
+        for (int32_t entry_idx = 0; entry_idx < n_entries; ++entry_idx)
+          snprintf(command + strlen(command), command_size - strlen(command), " %s", entries[entry_idx].name);
+
+        printf("%s< DOWNLOADING %d PACKAGE FILE(S) INTO %s%s%s >\n", KBLU, n_entries, KMAG, cache, KBLU);
+
+        pid_t group = 0;
+        bool foreground = false;
+        pid_t pid = spawn_package(-1, command, -1, &group, &foreground);
+
+        status = pid < 0 ? -1 : wait_package(pid, &group, foreground);
+        written = status == 0;
+
+        if (!written)
+          fprintf(stderr, "%s< FAILED TO DOWNLOAD THE PACKAGE FILES (STATUS %d) >\n", KRED, status);
+      }
+
+      for (int32_t entry_idx = 0; entry_idx < n_entries && written; ++entry_idx) {
+        char path[2 * ARCUS_PATH_MAX];
+
+        snprintf(path, sizeof(path), "%s/%s", cache, entries[entry_idx].file);
+        written = sha256_file(path, entries[entry_idx].sha256);
+
+        if (!written)
+          fprintf(stderr, "%s< DOWNLOADED FILE IS MISSING : %s%s%s >\n", KRED, KMAG, path, KRED);
+      }
+
+      FILE* out = written ? fopen(tmp_path, "wb") : NULL;
+
+      if (written && out == NULL)
+        fprintf(stderr, "%s< FAILED TO OPEN FILE : %s >\n", KRED, tmp_path);
+
+      if (out != NULL) {
+        written = fprintf(out, ARCUS_LOCK_MAGIC "\n") > 0;
+
+        for (int32_t entry_idx = 0; entry_idx < n_entries && written; ++entry_idx) {
+          const arcus_lock_entry_t* entry = &entries[entry_idx];
+          char body_hash[65];
+
+          package_leaf_hash(entry->pkg_idx, body_hash);
+          written = fprintf(out, "%s\t%s\t%s\t%s\t%s\t%s\n", packages[entry->pkg_idx][0], entry->name, entry->version, entry->file, entry->sha256, body_hash) > 0;
+        }
+
+        if (fclose(out) != 0 || !written || rename(tmp_path, lock_path) != 0) {
+          fprintf(stderr, "%s< FAILED TO WRITE FILE : %s >\n", KRED, lock_path);
+          remove(tmp_path);
+          written = false;
+        }
+      }
+
+      if (written)
+        printf("%s< LOCKED %d FILE(S) FOR %d PACKAGE(S)%s : %s%s%s >\n", KGRN, n_entries, n_locked, locked_all ? "" : ", SOME LEFT UNLOCKED", KMAG, lock_path, KGRN);
+
+      for (int32_t entry_idx = 0; entry_idx < n_entries; ++entry_idx) {
+        free(entries[entry_idx].name);
+        free(entries[entry_idx].version);
+        free(entries[entry_idx].file);
+      }
+
+      free(entries);
+      free(command);
+
+      return written;
+    #else
+      (void)ignore;
+      (void)n_ignore;
+
+      fprintf(stderr, "%s< LOCKING PACKAGES IS NOT SUPPORTED ON THIS PLATFORM >\n", KRED);
+
+      return false;
+    #endif
+  }
+
+  bool
+  load_lock(void) {
+    char lock_path[ARCUS_PATH_MAX];
+
+    snprintf(lock_path, sizeof(lock_path), "%s/" ARCUS_LOCK_FILE, config_dir);
+
+    FILE* file = fopen(lock_path, "rb");
+
+    if (file == NULL) {
+      fprintf(stderr, "%s< NO " ARCUS_LOCK_FILE " IN %s, RUN \"arcus lock\" FIRST >\n", KRED, config_dir);
+
+      return false;
+    }
+
+    char* line = NULL;
+    int32_t line_size = 0;
+    int32_t line_no = 1;
+    int32_t stale_idx = -1;
+    bool valid = (line = arcus_getline(&line_size, true, '\n', file)) != NULL && strcmp(line, ARCUS_LOCK_MAGIC) == 0;
+
+    // Older locks don't record the bodies they were taken from, so there's no telling whether they still apply
+    if (!valid && line != NULL && strncmp(line, "arcus-lock v", 12) == 0) {
+      fprintf(stderr, "%s< %s WAS WRITTEN BY AN OLDER arcus, RUN \"arcus lock\" AGAIN >\n", KRED, lock_path);
+      free(line);
+      fclose(file);
+
+      return false;
+    }
+
+    free(line);
+
+    while (valid && (line = arcus_getline(&line_size, true, '\n', file)) != NULL) {
+      if (line_size <= 0) {
+        free(line);
+
+        break;
+      }
+
+      char* fields[6] = { line, NULL, NULL, NULL, NULL, NULL };
+      char body_hash[65];
+
+      ++line_no;
+
+      for (int32_t field_idx = 1; field_idx < 6 && fields[field_idx - 1] != NULL; ++field_idx) {
+        fields[field_idx] = strchr(fields[field_idx - 1], '\t');
+
+        if (fields[field_idx] != NULL)
+          *fields[field_idx]++ = '\0';
+      }
+
+      valid = fields[5] != NULL && sha256_hex_valid(fields[4]) && sha256_hex_valid(fields[5]);
+
+      for (int32_t field_idx = 1; field_idx < 4 && valid; ++field_idx)
+        valid = lock_token_valid(fields[field_idx]);
+
+      int32_t pkg_idx = 0;
+
+      while (valid && pkg_idx < n_packages && strcmp(packages[pkg_idx][0], fields[0]) != 0)
+        ++pkg_idx;
+
+      if (valid && pkg_idx < n_packages)
+        package_leaf_hash(pkg_idx, body_hash);
+
+      if (valid && pkg_idx == n_packages)
+        fprintf(stderr, "%s< " ARCUS_LOCK_FILE " PINS A PACKAGE THAT NO LONGER EXISTS, SKIPPING : %s%s%s >\n", KYEL, KMAG, fields[0], KYEL);
+      else if (valid && strcmp(body_hash, fields[5]) != 0) {
+        // The pinned files were resolved from a body that has since been edited, so run the body as it is now
+        if (stale_idx != pkg_idx)
+          fprintf(stderr, "%s< " ARCUS_LOCK_FILE " IS STALE, THE BODY CHANGED SINCE \"arcus lock\", RUNNING IT INSTEAD : %s%s%s >\n", KYEL, KMAG, fields[0], KYEL);
+
+        stale_idx = pkg_idx;
+      } else if (valid) {
+        arcus_lock_entry_t* re_alloc = (arcus_lock_entry_t*)realloc(lock_entries, (n_lock_entries + 1) * sizeof(arcus_lock_entry_t));
+
+        valid = re_alloc != NULL;
+
+        if (valid) {
+          lock_entries = re_alloc;
+          lock_entries[n_lock_entries] = (arcus_lock_entry_t){ pkg_idx, strdup(fields[1]), strdup(fields[2]), strdup(fields[3]), "" };
+          memcpy(lock_entries[n_lock_entries].sha256, fields[4], 65);
+          ++n_lock_entries;
+        }
+      }
+
+      free(line);
+    }
+
+    fclose(file);
+
+    if (!valid) {
+      fprintf(stderr, "%s< MALFORMED LINE %d IN %s >\n", KRED, line_no, lock_path);
+      free_lock();
+    }
+
+    return valid;
+  }
+
+  void
+  free_lock(void) {
+    for (int32_t entry_idx = 0; entry_idx < n_lock_entries; ++entry_idx) {
+      free(lock_entries[entry_idx].name);
+      free(lock_entries[entry_idx].version);
+      free(lock_entries[entry_idx].file);
+    }
+
+    free(lock_entries);
+    lock_entries = NULL;
+    n_lock_entries = 0;
+
+    free(lock_results);
+    lock_results = NULL;
+  }
+
+  bool
+  print_fingerprint(void) {
+    arcus_fingerprint_t fingerprint;
+
+    if (!fingerprint_config(&fingerprint))
+      return false;
+
+    printf(ARCUS_FINGERPRINT_MAGIC "\nroot\t%s\n", fingerprint.root);
+
+    for (int32_t leaf_idx = 0; leaf_idx < fingerprint.n_leaves; ++leaf_idx)
+      printf("%s\t%s\n", fingerprint.hashes[leaf_idx], fingerprint.names[leaf_idx]);
+
+    free_fingerprint(&fingerprint);
+
+    return fflush(stdout) == 0 && !ferror(stdout);
+  }
+
+  int32_t
+  diff_fingerprint(
+    const char* reference,
+    const char* compared
+  ) {
+    arcus_fingerprint_t expected;
+    arcus_fingerprint_t actual;
+
+    // Both roots are compared before any Package hash of a file is read, matching fleets cost two lines per host
+    if (!read_fingerprint(reference, true, &expected))
+      return 2;
+
+    if (compared != NULL ? !read_fingerprint(compared, true, &actual) : !fingerprint_config(&actual))
+      return 2;
+
+    if (strcmp(expected.root, actual.root) == 0) {
+      printf("%s< NO DRIFT : ROOT HASHES MATCH (%.12s) >\n", KGRN, actual.root);
+      free_fingerprint(&actual);
+
+      return 0;
+    }
+
+    if ((compared != NULL && !read_fingerprint(compared, false, &actual)) || !read_fingerprint(reference, false, &expected)) {
+      free_fingerprint(&actual);
+
+      return 2;
+    }
+
+    bool* matched = expected.n_leaves > 0 ? (bool*)calloc(expected.n_leaves, sizeof(bool)) : NULL;
+    int32_t added = 0;
+    int32_t removed = 0;
+    int32_t changed = 0;
+
+    if (expected.n_leaves > 0 && matched == NULL) {
+      free_fingerprint(&expected);
+      free_fingerprint(&actual);
+
+      return 2;
+    }
+
+    // Packages are matched by header, a header listed more than once pairs up in order of appearance
+    for (int32_t leaf_idx = 0; leaf_idx < actual.n_leaves; ++leaf_idx) {
+      int32_t match_idx = 0;
+
+      // Drifted configurations rarely reorder, so the same position is tried before scanning
+      if (leaf_idx < expected.n_leaves && !matched[leaf_idx] && strcmp(expected.names[leaf_idx], actual.names[leaf_idx]) == 0)
+        match_idx = leaf_idx;
+
+      while (match_idx < expected.n_leaves && (matched[match_idx] || strcmp(expected.names[match_idx], actual.names[leaf_idx]) != 0))
+        ++match_idx;
+
+      if (match_idx == expected.n_leaves) {
+        printf("%s< ADDED : %s%s%s >\n", KGRN, KMAG, actual.names[leaf_idx], KGRN);
+        ++added;
+
+        continue;
+      }
+
+      matched[match_idx] = true;
+
+      if (strcmp(expected.hashes[match_idx], actual.hashes[leaf_idx]) != 0) {
+        printf("%s< CHANGED : %s%s%s >\n", KYEL, KMAG, actual.names[leaf_idx], KYEL);
+        ++changed;
+      }
+    }
+
+    for (int32_t leaf_idx = 0; leaf_idx < expected.n_leaves; ++leaf_idx) {
+      if (!matched[leaf_idx]) {
+        printf("%s< REMOVED : %s%s%s >\n", KRED, KMAG, expected.names[leaf_idx], KRED);
+        ++removed;
+      }
+    }
+
+    if (added == 0 && removed == 0 && changed == 0)
+      printf("%s< DRIFT : SAME PACKAGES IN A DIFFERENT ORDER >\n", KYEL);
+    else
+      printf("%s< DRIFT : %d ADDED, %d REMOVED, %d CHANGED >\n", KYEL, added, removed, changed);
+
+    free(matched);
+    free_fingerprint(&expected);
+    free_fingerprint(&actual);
+
+    return 1;
+  }
+
+  bool
+  check_packages(
+    const char** roots,
+    const int32_t n_roots,
+    const char** ignore,
+    const int32_t n_ignore
+  ) {
+    #if defined(__unix__) || defined(__linux__)
+      int64_t start_ns = stats_now_ns();
+      char** syntax_errors = n_packages > 0 ? (char**)calloc(n_packages, sizeof(char*)) : NULL;
+      int32_t n_errors = 0;
+      int32_t n_warnings = 0;
+      int32_t n_checked = 0;
+      bool uses_sudo = false;
+
+      if (n_packages > 0 && syntax_errors == NULL)
+        return false;
+
+      // The shells run whilst nothing else happens here, everything else is string work on the loaded bodies
+      if (!check_syntax(ignore, n_ignore, syntax_errors)) {
+        printf("%s< ERROR : FAILED TO START sh -n FOR EVERY PACKAGE >\n", KRED);
+        ++n_errors;
+      }
+
+      for (int32_t pkg_idx = 0; pkg_idx < n_packages; ++pkg_idx) {
+        if (is_ignored(packages[pkg_idx][0], ignore, n_ignore))
+          continue;
+
+        const char* body = package_body(pkg_idx);
+
+        ++n_checked;
+        n_errors += check_body_variables(pkg_idx, body);
+        n_errors += check_body_commands(pkg_idx, body, ignore, n_ignore);
+
+        if (syntax_errors[pkg_idx] != NULL) {
+          printf("%s< ERROR : %s%s%s : SYNTAX : %s >\n", KRED, KMAG, packages[pkg_idx][0], KRED, syntax_errors[pkg_idx]);
+          ++n_errors;
+        }
+
+        free(syntax_errors[pkg_idx]);
+
+        if (!uses_sudo) {
+          char* expanded = expand_check_command(pkg_idx, body, strlen(body));
+
+          uses_sudo = expanded != NULL && strstr(expanded, "sudo") != NULL;
+          free(expanded);
+        }
+      }
+
+      free(syntax_errors);
+
+      // `sudo -n` never prompts, so a failure means the run would stop for a password (or fail without a terminal) partway through
+      if (uses_sudo && geteuid() != 0 && !elevate) {
+        int32_t status = -1;
+        char* output = capture_command("sudo -n true 2>/dev/null", NULL, &status);
+
+        free(output);
+
+        if (status != 0) {
+          printf("%s< WARNING : sudo NEEDS A PASSWORD, THE RUN WILL PROMPT FOR IT (SEE --elevate) >\n", KYEL);
+          ++n_warnings;
+        }
+      }
+
+      const char* default_roots[] = { "/" };
+      const char* workspaces[2];
+      int32_t n_workspaces = 0;
+
+      workspaces[n_workspaces++] = ".";
+
+      if (scratch_max_bytes > 0)
+        workspaces[n_workspaces++] = scratch_base();
+
+      const char** targets = n_roots > 0 ? roots : default_roots;
+      int32_t n_targets = n_roots > 0 ? n_roots : 1;
+
+      // Roots the Packages install into, then where Arcus itself writes (logs, caches, workspaces), each filesystem once
+      for (int32_t target_idx = 0; target_idx < n_targets + n_workspaces; ++target_idx) {
+        const char* target = target_idx < n_targets ? targets[target_idx] : workspaces[target_idx - n_targets];
+        struct stat info;
+        struct statvfs space;
+
+        if (stat(target, &info) != 0 || statvfs(target, &space) != 0) {
+          printf("%s< ERROR : CANNOT READ FREE SPACE OF %s%s%s >\n", KRED, KMAG, target, KRED);
+          ++n_errors;
+
+          continue;
+        }
+
+        bool seen = false;
+
+        for (int32_t earlier_idx = 0; earlier_idx < target_idx && !seen; ++earlier_idx) {
+          struct stat earlier;
+
+          seen = stat(earlier_idx < n_targets ? targets[earlier_idx] : workspaces[earlier_idx - n_targets], &earlier) == 0 && earlier.st_dev == info.st_dev;
         }
-        
-        void
-        disable_ansi(void) {
-          // ANSI \Esc[0m (Normal)
-          printf("\x1b[0m");	
-        
-          if(!SetConsoleMode(stdout_handle, outmode_init))
-            exit(GetLastError());
+
+        int64_t free_mb = (int64_t)space.f_bavail * (int64_t)space.f_frsize / (1024 * 1024);
+
+        if (!seen && free_mb < ARCUS_CHECK_MIN_FREE_MB) {
+          printf("%s< ERROR : ONLY %lld MB FREE ON %s%s%s (LESS THAN %d MB) >\n", KRED, (long long)free_mb, KMAG, target, KRED, ARCUS_CHECK_MIN_FREE_MB);
+          ++n_errors;
         }
-      #else
-        void
-        enable_ansi(void) {}
-        
-        void
-        disable_ansi(void) {
-            // ANSI \Esc[0m (Normal)
-            printf("\x1b[0m");
+      }
+
+      int64_t elapsed_ms = (stats_now_ns() - start_ns) / 1000000;
+
+      if (n_errors > 0)
+        printf("%s< CHECK FAILED : %d ERROR(S), %d WARNING(S) IN %d PACKAGE(S), %lldms >\n", KRED, n_errors, n_warnings, n_checked, (long long)elapsed_ms);
+      else
+        printf("%s< CHECK PASSED : %d PACKAGE(S), %d WARNING(S), %lldms >\n", KGRN, n_checked, n_warnings, (long long)elapsed_ms);
+
+      fflush(stdout);
+
+      return n_errors == 0;
+    #else
+      (void)roots;
+      (void)n_roots;
+      (void)ignore;
+      (void)n_ignore;
+
+      fprintf(stderr, "%s< arcus check IS NOT SUPPORTED ON THIS PLATFORM >\n", KRED);
+
+      return false;
+    #endif
+  }
+
+  int32_t
+  print_status(void) {
+    #if defined(__unix__) || defined(__linux__)
+      char dir[ARCUS_PATH_MAX];
+      int32_t n_running = 0;
+
+      status_dir_path(dir, sizeof(dir));
+
+      DIR* entries = opendir(dir);
+      struct dirent* entry;
+
+      while (entries != NULL && (entry = readdir(entries)) != NULL) {
+        char* end = NULL;
+        long pid = strtol(entry->d_name, &end, 10);
+
+        if (end == entry->d_name || strcmp(end, ".status") != 0)
+          continue;
+
+        char path[ARCUS_PATH_MAX + 288];
+        struct stat info;
+
+        snprintf(path, sizeof(path), "%s/%s", dir, entry->d_name);
+
+        int32_t fd = open(path, O_RDONLY | O_CLOEXEC | O_NOFOLLOW);
+
+        if (fd < 0)
+          continue;
+
+        // A read-only view of the installer's own pages, nothing is sent to it and nothing it does waits on this
+        const arcus_status_t* table = fstat(fd, &info) == 0 && info.st_size == (off_t)sizeof(arcus_status_t)
+          ? (const arcus_status_t*)mmap(NULL, sizeof(arcus_status_t), PROT_READ, MAP_SHARED, fd, 0)
+          : (const arcus_status_t*)MAP_FAILED;
+
+        close(fd);
+
+        if ((const void*)table == MAP_FAILED)
+          continue;
+
+        if (strncmp(table->magic, ARCUS_STATUS_MAGIC, sizeof(table->magic)) != 0 || table->pid != (int64_t)pid) {
+          munmap((void*)table, sizeof(arcus_status_t));
+
+          continue;
         }
-      #endif
-      /* Source-End */
 
-      int32_t setenv(const char* name, const char* value, int32_t overwrite) {   
-        int32_t errcode = 0;
-        
-        if (!overwrite) {
-          size_t envsize = 0;
-          errcode = getenv_s(&envsize, NULL, 0, name);
-          
-          if (errcode || envsize)
-            return errcode;
+        if (kill((pid_t)pid, 0) != 0 && errno == ESRCH) {
+          printf("%s< STALE STATUS : %s%s%s (PID %ld IS NO LONGER RUNNING) >\n", KYEL, KMAG, path, KYEL, pid);
+          munmap((void*)table, sizeof(arcus_status_t));
+
+          continue;
+        }
+
+        int64_t now = (int64_t)time(NULL);
+        int64_t elapsed = now - table->started_at;
+        int32_t installed = __atomic_load_n(&table->installed, __ATOMIC_ACQUIRE);
+        int32_t failed = __atomic_load_n(&table->failed, __ATOMIC_ACQUIRE);
+        int32_t ignored = __atomic_load_n(&table->ignored, __ATOMIC_ACQUIRE);
+        int32_t cancelled = __atomic_load_n(&table->cancelled, __ATOMIC_ACQUIRE);
+        int32_t done = installed + failed + ignored + cancelled;
+        char total[32] = "";
+
+        if (table->total > 0)
+          snprintf(total, sizeof(total), " of %d", table->total);
+
+        printf(
+          "%s< RUN : %s%s%s (PID %ld), %s FOR %lldm%02llds >\n",
+          KBLU, KMAG, table->run_id, KBLU, pid,
+          __atomic_load_n(&table->finished, __ATOMIC_ACQUIRE) != 0 ? "FINISHED AFTER" : "RUNNING",
+          (long long)(elapsed / 60), (long long)(elapsed % 60)
+        );
+        printf("%sProgress:%s %d%s (%d installed, %d failed, %d ignored, %d cancelled)\n", KCYN, KNRM, done, total, installed, failed, ignored, cancelled);
+
+        for (int32_t slot_idx = 0; slot_idx < table->n_slots && slot_idx < ARCUS_STATUS_SLOTS; ++slot_idx) {
+          const arcus_status_slot_t* shared = &table->slots[slot_idx];
+          arcus_status_slot_t slot;
+          bool consistent = false;
+
+          // Seqlock read: the copy only counts if no write was in progress or happened during it
+          for (int32_t attempt = 0; attempt < 1000 && !consistent; ++attempt) {
+            uint32_t before = __atomic_load_n(&shared->sequence, __ATOMIC_ACQUIRE);
+
+            if ((before & 1) != 0)
+              continue;
+
+            memcpy(&slot, (const void*)shared, sizeof(slot));
+            __atomic_thread_fence(__ATOMIC_ACQUIRE);
+            consistent = __atomic_load_n(&shared->sequence, __ATOMIC_RELAXED) == before;
+          }
+
+          if (!consistent || (slot.number == 0 && slot.last_package[0] == '\0'))
+            continue;
+
+          slot.root[sizeof(slot.root) - 1] = '\0';
+          slot.package[sizeof(slot.package) - 1] = '\0';
+          slot.last_package[sizeof(slot.last_package) - 1] = '\0';
+
+          printf("%s[%s]:%s ", KCYN, slot.root[0] != '\0' ? slot.root : "/", KNRM);
+
+          if (slot.number > 0)
+            printf("%sinstalling %s%s%s (#%d, for %llds)", KGRN, KMAG, slot.package, KGRN, slot.number, (long long)(now - slot.started_at));
+          else
+            printf("%sidle", KYEL);
+
+          if (slot.last_package[0] != '\0')
+            printf("%s, last: %s%s%s (exit %d)", KNRM, KMAG, slot.last_package, KNRM, slot.last_exit);
+
+          printf("%s\n", KNRM);
+        }
+
+        munmap((void*)table, sizeof(arcus_status_t));
+        ++n_running;
+      }
+
+      if (entries != NULL)
+        closedir(entries);
+
+      if (n_running == 0)
+        printf("%s< NO INSTALLATION IS RUNNING (%s) >\n", KYEL, dir);
+
+      return n_running;
+    #else
+      fprintf(stderr, "%s< arcus status IS NOT SUPPORTED ON THIS PLATFORM >\n", KRED);
+
+      return 0;
+    #endif
+  }
+
+  bool
+  simulate_packages(
+    const char* durations_path,
+    const int32_t* jobs,
+    const int32_t n_jobs,
+    const char** ignore,
+    const int32_t n_ignore
+  ) {
+    #if defined(__unix__) || defined(__linux__)
+      int64_t start_ns = stats_now_ns();
+      int32_t n_durations = 0;
+      arcus_duration_t* durations = read_durations(durations_path, &n_durations);
+
+      if (durations == NULL)
+        return false;
+
+      int32_t max_jobs = 1;
+
+      for (int32_t jobs_idx = 0; jobs_idx < n_jobs; ++jobs_idx) {
+        if (jobs[jobs_idx] > max_jobs)
+          max_jobs = jobs[jobs_idx];
+      }
+
+      // One copy of the tasks per order, the scratch arrays are shared by every schedule
+      int32_t slots = n_packages > 0 ? n_packages : 1;
+      arcus_sim_task_t* orders[3] = {
+        (arcus_sim_task_t*)malloc((size_t)slots * sizeof(arcus_sim_task_t)),
+        (arcus_sim_task_t*)malloc((size_t)slots * sizeof(arcus_sim_task_t)),
+        (arcus_sim_task_t*)malloc((size_t)slots * sizeof(arcus_sim_task_t))
+      };
+      const char* order_names[3] = { "file", "longest", "shortest" };
+      int32_t* queue = (int32_t*)malloc((size_t)slots * sizeof(int32_t));
+      int32_t* running = (int32_t*)malloc((size_t)max_jobs * sizeof(int32_t));
+      int32_t* blockers = (int32_t*)malloc((size_t)slots * sizeof(int32_t));
+      double* finishes = (double*)malloc((size_t)slots * sizeof(double));
+      bool simulated = orders[0] != NULL && orders[1] != NULL && orders[2] != NULL && queue != NULL && running != NULL && blockers != NULL && finishes != NULL;
+      int32_t n_tasks = 0;
+      int32_t n_measured = 0;
+      double measured = 0.0;
+
+      for (int32_t pkg_idx = 0; simulated && pkg_idx < n_packages; ++pkg_idx) {
+        if (is_ignored(packages[pkg_idx][0], ignore, n_ignore))
+          continue;
+
+        arcus_duration_t key = { packages[pkg_idx][0], 0.0, 0, 0 };
+        arcus_duration_t* duration = n_durations > 0 ? (arcus_duration_t*)bsearch(&key, durations, n_durations, sizeof(arcus_duration_t), compare_durations) : NULL;
+
+        orders[0][n_tasks].pkg_idx = pkg_idx;
+        orders[0][n_tasks].seconds = duration != NULL ? duration->seconds : -1.0;
+        orders[0][n_tasks].locks = duration != NULL && duration->locks >= 0 ? duration->locks : lock_groups(package_body(pkg_idx));
+
+        if (duration != NULL) {
+          measured += duration->seconds;
+          ++n_measured;
+        }
+
+        ++n_tasks;
+      }
+
+      free_durations(durations, n_durations);
+
+      if (simulated && n_measured == 0) {
+        fprintf(stderr, "%s< NO SELECTED PACKAGE HAS A DURATION IN %s >\n", KRED, durations_path);
+        simulated = false;
+      }
+
+      double mean = n_measured > 0 ? measured / n_measured : 0.0;
+      double total = 0.0;
+      double locked[2] = { 0.0, 0.0 };
+      double longest = 0.0;
+
+      for (int32_t task_idx = 0; simulated && task_idx < n_tasks; ++task_idx) {
+        arcus_sim_task_t* task = &orders[0][task_idx];
+
+        if (task->seconds < 0.0) {
+          printf("%s< WARNING : NO DURATION FOR %s%s%s, ASSUMING THE MEAN OF %.1fs >\n", KYEL, KMAG, packages[task->pkg_idx][0], KYEL, mean);
+          task->seconds = mean;
+        }
+
+        total += task->seconds;
+
+        if ((task->locks & ARCUS_LOCK_PACMAN) != 0)
+          locked[0] += task->seconds;
+
+        if ((task->locks & ARCUS_LOCK_FLATPAK) != 0)
+          locked[1] += task->seconds;
+
+        if (task->seconds > longest)
+          longest = task->seconds;
+      }
+
+      if (simulated) {
+        memcpy(orders[1], orders[0], (size_t)n_tasks * sizeof(arcus_sim_task_t));
+        memcpy(orders[2], orders[0], (size_t)n_tasks * sizeof(arcus_sim_task_t));
+        qsort(orders[1], n_tasks, sizeof(arcus_sim_task_t), compare_longest);
+        qsort(orders[2], n_tasks, sizeof(arcus_sim_task_t), compare_shortest);
+
+        printf("%s< SIMULATING %d PACKAGE(S), %.1fs OF WORK (%d MEASURED) >\n", KBLU, n_tasks, total, n_measured);
+        printf("%s%-10s %-9s %6s %12s %12s %6s%s\n", KCYN, "SCHEDULE", "ORDER", "JOBS", "MAKESPAN", "UTILIZATION", "PATH", KNRM);
+      }
+
+      double serial = total;
+      double best = 0.0;
+      int32_t best_order = 0;
+      int32_t best_jobs = 1;
+      bool best_batched = false;
+      int32_t n_schedules = 0;
+
+      // Serial once (every order takes the same time), then batched and workers for every order and worker count
+      for (int32_t row = -1; simulated && row < 2 * 3 * n_jobs; ++row) {
+        int32_t order = row < 0 ? 0 : row / (2 * n_jobs);
+        int32_t run_jobs = row < 0 ? 1 : jobs[(row / 2) % n_jobs];
+        bool batched = row >= 0 && row % 2 == 0;
+        double makespan = simulate_schedule(orders[order], n_tasks, run_jobs, batched, queue, running, blockers, finishes);
+        int32_t last = 0;
+        int32_t path = 0;
+
+        for (int32_t task_idx = 1; task_idx < n_tasks; ++task_idx) {
+          if (finishes[task_idx] > finishes[last])
+            last = task_idx;
+        }
+
+        for (int32_t task_idx = n_tasks > 0 ? last : -1; task_idx >= 0; task_idx = blockers[task_idx])
+          ++path;
+
+        if (row < 0)
+          serial = makespan;
+
+        if (row < 0 || makespan < best || (makespan == best && run_jobs < best_jobs)) {
+          best = makespan;
+          best_order = order;
+          best_jobs = run_jobs;
+          best_batched = batched;
+        }
+
+        printf(
+          "%-10s %-9s %6d %11.1fs %11.1f%% %6d\n",
+          row < 0 ? "serial" : (batched ? "batched" : "workers"), row < 0 ? "any" : order_names[order], run_jobs,
+          makespan, makespan > 0.0 ? 100.0 * total / (run_jobs * makespan) : 100.0, path
+        );
+        ++n_schedules;
+      }
+
+      if (simulated) {
+        printf(
+          "%sBest:%s %s, %s order, %d job(s) : %.1fs (%.2fx faster than serial)\n",
+          KCYN, KNRM, best_jobs == 1 ? "serial" : (best_batched ? "batched" : "workers"), order_names[best_order], best_jobs,
+          best, best > 0.0 ? serial / best : 1.0
+        );
+
+        // The critical path is the chain of Packages whose completion started the next one, ending with the last to finish
+        simulate_schedule(orders[best_order], n_tasks, best_jobs, best_batched, queue, running, blockers, finishes);
+
+        int32_t last = 0;
+        int32_t path = 0;
+
+        for (int32_t task_idx = 1; task_idx < n_tasks; ++task_idx) {
+          if (finishes[task_idx] > finishes[last])
+            last = task_idx;
+        }
+
+        // `queue` is free again, so it holds the path from its first Package
+        for (int32_t task_idx = last; task_idx >= 0; task_idx = blockers[task_idx])
+          queue[path++] = task_idx;
+
+        printf("%sCritical Path:%s", KCYN, KNRM);
+
+        for (int32_t path_idx = path - 1; path_idx >= 0 && path_idx >= path - ARCUS_SIMULATE_PATH_SHOWN; --path_idx) {
+          const arcus_sim_task_t* task = &orders[best_order][queue[path_idx]];
+
+          printf("%s %s%s%s (%.1fs)", path_idx == path - 1 ? "" : " ->", KMAG, packages[task->pkg_idx][0], KNRM, task->seconds);
+        }
+
+        if (path > ARCUS_SIMULATE_PATH_SHOWN)
+          printf(" -> +%d more", path - ARCUS_SIMULATE_PATH_SHOWN);
+
+        printf("\n");
+        printf(
+          "%sLower Bounds:%s longest package %.1fs, %.1fs on %d job(s), pacman lock %.1fs, flatpak lock %.1fs\n",
+          KCYN, KNRM, longest, total / max_jobs, max_jobs, locked[0], locked[1]
+        );
+        printf("%s< SIMULATED %d SCHEDULE(S) IN %lldms >\n", KGRN, n_schedules, (long long)((stats_now_ns() - start_ns) / 1000000));
+        fflush(stdout);
+      }
+
+      for (int32_t order = 0; order < 3; ++order)
+        free(orders[order]);
+
+      free(queue);
+      free(running);
+      free(blockers);
+      free(finishes);
+
+      return simulated;
+    #else
+      (void)durations_path;
+      (void)jobs;
+      (void)n_jobs;
+      (void)ignore;
+      (void)n_ignore;
+
+      fprintf(stderr, "%s< arcus simulate IS NOT SUPPORTED ON THIS PLATFORM >\n", KRED);
+
+      return false;
+    #endif
+  }
+
+  bool
+  start_log_run(
+    const int32_t keep,
+    const int64_t max_bytes
+  ) {
+    #if defined(__unix__) || defined(__linux__)
+      if (!pathexists(ARCUS_LOG_DIR) && mkdir(ARCUS_LOG_DIR, 0755) != 0) {
+        fprintf(stderr, "%s< FAILED TO CREATE LOG DIRECTORY : %s >\n", KRED, ARCUS_LOG_DIR);
+
+        return false;
+      }
+
+      char stamp[32];
+      time_t now = time(NULL);
+
+      strftime(stamp, sizeof(stamp), "%Y%m%d-%H%M%S", localtime(&now));
+      snprintf(log_run_dir, sizeof(log_run_dir), ARCUS_LOG_DIR "/run-%s-%d", stamp, (int32_t)getpid());
+
+      if (mkdir(log_run_dir, 0755) != 0) {
+        fprintf(stderr, "%s< FAILED TO CREATE LOG DIRECTORY : %s >\n", KRED, log_run_dir);
+        log_run_dir[0] = '\0';
+
+        return false;
+      }
+
+      prune_log_runs(log_run_dir, keep, max_bytes);
+
+      return true;
+    #else
+      (void)keep;
+      (void)max_bytes;
+
+      fprintf(stderr, "%s< PER-PACKAGE LOGGING IS NOT SUPPORTED ON THIS PLATFORM >\n", KYEL);
+
+      return false;
+    #endif
+  }
+
+  /**
+   * @author https://github.com/SigmaEG/Arcus
+   * @brief `qsort(...)` comparator for C-Style Strings
+  */
+  static
+  int
+  compare_strings(
+    const void* lhs,
+    const void* rhs
+  ) {
+    return strcmp(*(const char* const*)lhs, *(const char* const*)rhs);
+  }
+
+  int32_t
+  prune_log_runs(
+    const char* current,
+    const int32_t keep,
+    const int64_t max_bytes
+  ) {
+    int32_t removed = 0;
+
+    #if defined(__unix__) || defined(__linux__)
+      DIR* dir = opendir(ARCUS_LOG_DIR);
+
+      if (dir == NULL)
+        return 0;
+
+      char** runs = NULL;
+      int32_t n_runs = 0;
+      struct dirent* entry = NULL;
+
+      while ((entry = readdir(dir)) != NULL) {
+        if (strncmp(entry->d_name, "run-", 4) != 0)
+          continue;
+
+        size_t path_len = strlen(ARCUS_LOG_DIR "/") + strlen(entry->d_name) + 1;
+        char** re_alloc = (char**)realloc(runs, (n_runs + 1) * sizeof(char*));
+        char* path = (char*)calloc(path_len, sizeof(char));
+
+        if (re_alloc == NULL || path == NULL) {
+          if (re_alloc != NULL)
+            runs = re_alloc;
+
+          free(path);
+
+          break;
+        }
+
+        snprintf(path, path_len, ARCUS_LOG_DIR "/%s", entry->d_name);
+        runs = re_alloc;
+        runs[n_runs++] = path;
+      }
+
+      closedir(dir);
+
+      if (runs == NULL)
+        return 0;
+
+      qsort(runs, n_runs, sizeof(char*), compare_strings);
+
+      int64_t total = 0;
+      int64_t* sizes = (int64_t*)calloc(n_runs, sizeof(int64_t));
+
+      if (sizes != NULL && max_bytes > 0) {
+        for (int32_t run_idx = 0; run_idx < n_runs; ++run_idx) {
+          sizes[run_idx] = tree_size(runs[run_idx]);
+          total += sizes[run_idx];
+        }
+      }
+
+      for (int32_t run_idx = 0; run_idx < n_runs && sizes != NULL; ++run_idx) {
+        if (current != NULL && strcmp(runs[run_idx], current) == 0)
+          continue;
+
+        if (n_runs - removed <= keep && (max_bytes <= 0 || total <= max_bytes))
+          break;
+
+        if (remove_tree(runs[run_idx])) {
+          total -= sizes[run_idx];
+          ++removed;
         }
+      }
+
+      for (int32_t run_idx = 0; run_idx < n_runs; ++run_idx)
+        free(runs[run_idx]);
+
+      free(runs);
+      free(sizes);
+    #else
+      (void)current;
+      (void)keep;
+      (void)max_bytes;
+    #endif
+
+    return removed;
+  }
+
+  void
+  display_help(void) {
+    printf(
+      "%susage:%s arcus %s<operation> [...]%s\n"
+      "%soperations:%s\n"
+      "\tarcus %s{-h --help}%s\n"
+      "\tarcus %s{-V --version}%s\n"
+      "\tarcus list %s{--ignore ...}%s %s(arguments after --ignore are listed as ignored packages, separated by a whitespace)%s\n"
+      "\tarcus show %s<package>%s %s(prints the body and metadata of a single package)%s\n"
+      "\tarcus convert %s<from> <to>%s %s(converts an Arcus file between the brace format and the " ARCUS_LINES_EXT " line format, by extension)%s\n"
+      "\tarcus daemon %s{--config DIR} {--group NAME}%s %s(runs arcusd, which serializes installs from every client and runs each package once per batch, members of NAME may connect too)%s\n"
+      "\tarcus fingerprint %s{> FILE}%s %s(prints a SHA-256 of every package, formatting aside, and a root hash over all of them)%s\n"
+      "\tarcus diff %s<fingerprint> [<fingerprint>]%s %s(lists packages added, removed or changed since the first fingerprint, in the configuration or the second fingerprint)%s\n"
+      "\tarcus lock %s{--ignore ...}%s %s(resolves every pacman/yay package to exact versions, downloads them into arcus_cache/pkg and records their SHA-256 in arcus.lock)%s\n"
+      "\tarcus status%s%s %s(shows what every running installation of this user is doing, read from its status table in /tmp/arcus-status-<uid> without contacting it)%s\n"
+      "\tarcus check %s{--ignore ...} {--root ...}%s %s(validates every package in parallel without running it: undefined ${VARS}, commands missing from PATH, sh -n syntax, sudo and free disk space)%s\n"
+      "\tarcus simulate %s<durations> {--jobs N ...} {--ignore ...}%s %s(predicts the makespan, worker utilization and critical path of serial, batched and N-worker runs in file, longest-first and shortest-first order from measured package durations)%s\n"
+      "\tarcus install %s{--ignore ...}%s %s(may require root permissions, arguments after --ignore are listed as ignored packages, separated by a whitespace)%s\n"
+      "\tarcus install %s{--root ...} {--jobs N}%s %s(installs into each target root in parallel, N at a time, exported to packages as ${ARCUS_ROOT})%s\n"
+      "\tarcus install %s{--log} {--log-keep N} {--log-max-size MB}%s %s(captures each package's output into arcus_logs/run-*/, retaining the newest N runs within MB megabytes)%s\n"
+      "\tarcus install %s{--prefetch N} {--prefetch-jobs J}%s %s(downloads the next N packages in the background, J at a time, whilst the current one installs)%s\n"
+      "\tarcus install %s{--elevate}%s %s(authenticates once up front, a privileged helper then runs every sudo command of the installation, audited to arcus_logs/helper-audit.log)%s\n"
+      "\tarcus install %s{--no-daemon}%s %s(installs in-process even when arcusd is running)%s\n"
+      "\tarcus install %s{--scratch} {--scratch-size MB} {--keep-scratch}%s %s(runs each package in its own scratch directory on tmpfs, capped at MB megabytes, kept for debugging if it fails)%s\n"
+      "\tarcus install %s{--no-git-cache}%s %s(runs git clone bodies as written instead of cloning through the bare mirrors in arcus_cache/git)%s\n"
+      "\tarcus install %s{--from-stdin}%s %s(installs packages defined on stdin in the brace format as each entry arrives, without prompting)%s\n"
+      "\tarcus install %s{--locked}%s %s(verifies and installs the package files pinned by arcus.lock in one pacman transaction, then the remaining packages as usual)%s\n"
+      "\tarcus install %s{--no-check}%s %s(skips the checks of arcus check, which otherwise run before the installation and abort it on errors)%s\n"
+
+      "%soptions:%s\n"
+      "\t%s{--config DIR}%s %s(reads arcus.pkgs and arcus.envs from DIR instead of arcus_config, overrides an embedded configuration)\n"
+      "\t%s{--stats}%s %s(prints Arcus's own parse time, reads, allocations, child processes and wait time to stderr on exit)\n\n",
+      KYEL, KMAG, KCYN, KMAG,
+      KYEL, KMAG,
+      KCYN, KMAG,
+      KCYN, KMAG,
+      KCYN, KMAG, KYEL, KMAG,
+      KCYN, KMAG, KYEL, KMAG,
+      KCYN, KMAG, KYEL, KMAG,
+      KCYN, KMAG, KYEL, KMAG,
+      KCYN, KMAG, KYEL, KMAG,
+      KCYN, KMAG, KYEL, KMAG,
+      KCYN, KMAG, KYEL, KMAG,
+      KCYN, KMAG, KYEL, KMAG,
+      KCYN, KMAG, KYEL, KMAG,
+      KCYN, KMAG, KYEL, KMAG,
+      KCYN, KMAG, KYEL, KMAG,
+      KCYN, KMAG, KYEL, KMAG,
+      KCYN, KMAG, KYEL, KMAG,
+      KCYN, KMAG, KYEL, KMAG,
+      KCYN, KMAG, KYEL, KMAG,
+      KCYN, KMAG, KYEL, KMAG,
+      KCYN, KMAG, KYEL, KMAG,
+      KCYN, KMAG, KYEL, KMAG,
+      KCYN, KMAG, KYEL, KMAG,
+      KCYN, KMAG, KYEL, KMAG,
+      KCYN, KMAG, KYEL, KMAG,
+      KYEL, KMAG,
+      KCYN, KMAG, KYEL,
+      KCYN, KMAG, KYEL
+    );
+  }
 
-        return _putenv_s(name, value);
-      }
+  void
+  display_ver(void) {
+    printf(
+      "%s  Arcus %s" ARCUS_VER "\n"
+      "  Copyright (C) 2015 - 2024 SigmaTech\n\n"
+      "  %sThis program may be freely redistributed under the terms of the GNU General Public License.\n%s"
+      SIGMA_SYMBOL_ASCII,
+      KMAG, KYEL, KBLU, KMAG
+    );
+  }
 
-      int32_t unsetenv(const char* name) {
-        return setenv(name, "", 1);
-      }
+  char***
+  parse_pkgs(int32_t* size_out) {
+    char* path = package_path;
 
-      int32_t isatty(int32_t fd) {
-        return _isatty(fd);
-      }
-    #endif
+    if (!pathexists(config_dir)) {
+      fprintf(stderr, KRED "< FAILED TO STAT DIRECTORY : %s >", config_dir);
 
-  #pragma endregion OS-SPECIFIC DECLARATIONS
+      return NULL;
+    }
 
-  char*
-  arcus_getline(
-    int32_t* size_out,
-    const bool remove_delim,
-    const char delimiter,
-    FILE* fstream
-  ) {
-    char* line = (char*)malloc(8 * sizeof(char));
-    int32_t line_sz = 8;
+    if (!resolve_config_file("arcus.pkgs", path, sizeof(package_path)))
+      return NULL;
+
+    if (!pathexists(path)) {
+      fprintf(stderr, KRED "< FAILED TO STAT PACKAGES FILE : %s >", path);
 
-    if (line == NULL) {
-      *size_out = 0;
       return NULL;
     }
 
-    char character;
-    int32_t read_count = 0;
+    package_lines = is_lines_file(path);
 
-    while (fread(&character, 1, sizeof(char), fstream) > 0) {
-      if ((read_count + 1) == line_sz) {
-        char* line_realloc = (char*)realloc(line, (line_sz * 2) * sizeof(char));
+    return parse_file(path, size_out);
+  }
 
-        if (line_realloc == NULL)
-          break;
+  char***
+  index_pkgs(int32_t* size_out) {
+    char* path = package_path;
+    char index_path[ARCUS_PATH_MAX + 8];
+    char signature[128];
+    struct stat info;
 
-        line = line_realloc;
-        line_sz *= 2;
+    if (!resolve_config_file("arcus.pkgs", path, sizeof(package_path)))
+      return NULL;
 
-        line[line_sz - 1] = '\0';
+    package_lines = is_lines_file(path);
+    snprintf(index_path, sizeof(index_path), "%s.idx", path);
 
-        if (size_out != NULL)
-          *size_out = line_sz - 1;
-      }
-    
-      ++read_count;
-      line[read_count - 1] = character;
+    if (stat(path, &info) != 0) {
+      fprintf(stderr, KRED "< FAILED TO STAT PACKAGES FILE : %s >", path);
 
-      if (character == delimiter)
-        break;
+      return NULL;
     }
 
-    if (read_count == 1) {
-      free(line);
-      line = NULL;
+    #if defined(__linux__)
+      long mtime_nsec = info.st_mtim.tv_nsec;
+    #else
+      long mtime_nsec = 0;
+    #endif
 
-      if (size_out != NULL)
-        *size_out = 0;
+    snprintf(signature, sizeof(signature), ARCUS_INDEX_MAGIC " %lld %lld %ld\n", (long long)info.st_size, (long long)info.st_mtime, mtime_nsec);
 
-      return NULL;
-    }
+    int64_t start_ns = stats.enabled ? stats_now_ns() : 0;
+    int64_t bytes_before = stats.bytes_read;
+    int32_t n_headers = 0;
+    char*** headers = read_index(index_path, signature, &package_index, &n_headers);
 
-    if (!remove_delim)
-      read_count += 1;
+    if (headers != NULL)
+      record_parse(index_path, start_ns, bytes_before);
 
-    if (read_count != line_sz) {
-      char* line_realloc = (char*)realloc(line, line_sz * sizeof(char));
+    if (headers == NULL) {
+      FILE* file = fopen(path, "rb");
 
-      if (line_realloc != NULL)
-        line = line_realloc;
-    }
+      if (file == NULL)
+        return NULL;
 
-    line_sz = read_count;
-    line[line_sz - 1] = '\0';
+      int64_t data_len = 0;
+      char* data = read_stream(file, &data_len);
+
+      fclose(file);
+
+      if (data == NULL)
+        return NULL;
+
+      if (package_lines)
+        headers = scan_lines(data, data_len, path, &package_index, &n_headers);
+      else
+        headers = scan_pkgs(data, data_len, &package_index, &n_headers);
+
+      free(data);
+
+      record_parse(path, start_ns, bytes_before);
+
+      if (headers != NULL)
+        write_index(index_path, signature, headers, package_index, n_headers);
+    }
 
     if (size_out != NULL)
-      *size_out = line_sz;
+      *size_out = n_headers;
 
-    return line;
+    return headers;
   }
 
-  bool
-  set_env(
-    const char* name,
-    const char* value
-  ) {
-    #if defined(__unix__) || defined(__linux__)
-      if (has_lolcat()) {
-        char* lolcat = (char*)calloc(strlen("echo \"< ALLOCATING TEMPORARY ENVIRONMENT VARIABLE :  =  >\" | lolcat") + strlen(name) + strlen(value) + 1, sizeof(char));
-        sprintf(lolcat, "echo \"< ALLOCATING TEMPORARY ENVIRONMENT VARIABLE : %s=%s >\" | lolcat", name, value);
+  char***
+  parse_envs(int32_t* size_out) {
+    char path[ARCUS_PATH_MAX];
 
-        system(lolcat);
-        free(lolcat);
-      } else
-        printf("%s< ALLOCATING TEMPORARY ENVIRONMENT VARIABLE : %s%s=%s%s >\n", KBLU, KMAG, name, value, KBLU);
-    #else
-      printf("%s< ALLOCATING TEMPORARY ENVIRONMENT VARIABLE : %s%s=%s%s >\n", KBLU, KMAG, name, value, KBLU);
-    #endif
+    if (!pathexists(config_dir)) {
+      fprintf(stderr, KRED "< FAILED TO STAT DIRECTORY : %s >", config_dir);
 
-    if (setenv(name, value, 1) == 1) {
-      fprintf(stderr, "%s< FAILED TO ALLOCATE TEMPORARY ENVIRONMENT VARIABLE %s\"%s\"%s >\n", KRED, KMAG, name, KBLU);
+      return NULL;
+    }
 
-      return false;
+    if (!resolve_config_file("arcus.envs", path, sizeof(path)))
+      return NULL;
+
+    if (!pathexists(path)) {
+      fprintf(stderr, KRED "< FAILED TO STAT ENVIRONMENT VARIABLES FILE : %s >", path);
+
+      return NULL;
     }
-    
-    #if defined(__unix__) || defined(__linux__)
-      if (has_lolcat()) {
-        char* lolcat = (char*)calloc(strlen("echo \"< SUCCESSFULLY ALLOCATED TEMPORARY ENVIRONMENT VARIABLE :  =  >\" | lolcat") + strlen(name) + strlen(value) + 1, sizeof(char));
-        sprintf(lolcat, "echo \"< SUCCESSFULLY ALLOCATED TEMPORARY ENVIRONMENT VARIABLE : %s=%s >\" | lolcat", name, value);
 
-        system(lolcat);
-        free(lolcat);
+    return parse_file(path, size_out);
+  }
+
+  void
+  load_config(const bool lazy) {
+    #if defined(ARCUS_EMBEDDED)
+      if (!config_overridden) {
+        packages = (char***)arcus_embedded_pkg_rows;
+        n_packages = ARCUS_EMBEDDED_N_PKGS;
+        env_args = (char***)arcus_embedded_env_rows;
+        n_env_args = ARCUS_EMBEDDED_N_ENVS;
+        config_embedded = true;
+
+        return;
       }
-      else
-        printf("%s< SUCCESSFULLY ALLOCATED TEMPORARY ENVIRONMENT VARIABLE : %s%s=%s%s >\n", KGRN, KMAG, name, value, KGRN);
-    #else
-        printf("%s< SUCCESSFULLY ALLOCATED TEMPORARY ENVIRONMENT VARIABLE : %s%s=%s%s >\n", KGRN, KMAG, name, value, KGRN);
     #endif
 
+    packages = lazy ? index_pkgs(&n_packages) : parse_pkgs(&n_packages);
+    env_args = parse_envs(&n_env_args);
+    config_embedded = false;
+  }
 
-    return true;
+  void
+  load_envs(void) {
+    #if defined(ARCUS_EMBEDDED)
+      if (!config_overridden) {
+        env_args = (char***)arcus_embedded_env_rows;
+        n_env_args = ARCUS_EMBEDDED_N_ENVS;
+        config_embedded = true;
+
+        return;
+      }
+    #endif
+
+    env_args = parse_envs(&n_env_args);
+    config_embedded = false;
   }
 
   void
-  init_env_args(const bool remove) {
-    for (int32_t arg_idx = 0; arg_idx < n_env_args; ++arg_idx) {
-      if (!remove) {
-        if (!set_env(env_args[arg_idx][0], env_args[arg_idx][1])) {
-          fprintf(stderr, KRED "< ERROR : QUITTING ARCUS >\n");
-          exit(1);
-        }
-      } else
-        unsetenv(env_args[arg_idx][0]);
+  free_config(void) {
+    free_limits();
+
+    if (config_embedded) {
+      packages = NULL;
+      n_packages = 0;
+      env_args = NULL;
+      n_env_args = 0;
+
+      return;
+    }
+
+    free_char_2d(packages, &n_packages);
+    free_char_2d(env_args, &n_env_args);
+    packages = NULL;
+    env_args = NULL;
+
+    free(package_index);
+    package_index = NULL;
+
+    if (package_file != NULL) {
+      fclose(package_file);
+      package_file = NULL;
     }
   }
 
   bool
-   is_ignored(
-    const char* package,
-    const char** ignore,
-    const int32_t n_ignore
-  ) {
-    for (int32_t ignore_idx = 0; ignore_idx < n_ignore; ++ignore_idx) {
-      if (strcmp(package, ignore[ignore_idx]) == 0)
-        return true;
-    }
+  load_limits(void) {
+    char path[ARCUS_PATH_MAX];
 
-    return false;
-  }
+    if (!resolve_config_file("arcus.limits", path, sizeof(path)))
+      return false;
 
-  void
-  list_packages(
-    const char** ignore,
-    const int32_t n_ignore
-  ) {
-    printf("%sPackages to Install:\n", KGRN);
+    if (!pathexists(path))
+      return true;
 
-    for (int32_t pkg_idx = 0; pkg_idx < n_packages; ++pkg_idx) {
-      const char* pkg_name = packages[pkg_idx][0];
-      char* pkg_how = NULL;
-      bool ignored = is_ignored(pkg_name, ignore, n_ignore);
+    #if defined(__unix__) || defined(__linux__)
+      int32_t n_entries = 0;
+      char*** entries = parse_file(path, &n_entries);
+      arcus_limits_t defaults;
+      bool valid = true;
+
+      // Streamed Packages aren't known yet, the entries are kept for `select_limits(...)` once each one arrives
+      if (packages == NULL) {
+        for (int32_t entry_idx = 0; entry_idx < n_entries; ++entry_idx) {
+          clear_limits(&defaults);
+          valid = parse_limit_settings(entries[entry_idx][0], entries[entry_idx][1], &defaults) && valid;
+        }
 
-      if (strstr(packages[pkg_idx][1], "PACMAN") != NULL)
-        pkg_how = "PACMAN";
-      else if (strstr(packages[pkg_idx][1], "YAY") != NULL)
-        pkg_how = "YAY-AUR";
-      else if (strstr(packages[pkg_idx][1], "flatpak install") != NULL)
-        pkg_how = "FLATPAK";
-      else if (strstr(packages[pkg_idx][1], "git clone") != NULL || strstr(packages[pkg_idx][1], "github") != NULL)
-        pkg_how = "GITHUB";
-      else
-        pkg_how = "SELF-DEFINED";
+        limit_entries = entries;
+        n_limit_entries = n_entries;
 
-      printf("%s[%s]:%s %s%s%s%s\n", KCYN, pkg_how, KNRM, KMAG, pkg_name, KYEL, ignored ? " [IGNORED]" : "");
-    }
+        if (!valid)
+          free_limits();
 
-    printf("%s\n%d Package%s Ignored%s\n", KYEL, n_ignore, n_ignore == 1 ? "" : "(s)", n_ignore == 0 ? ", See \"arcus {-h --help}\"" : "");
-  }
+        return valid;
+      }
 
-  void
-  install_packages(
-    const char** ignore,
-    const int32_t n_ignore
-  ) {
-    list_packages(ignore, n_ignore);
+      if (n_packages > 0)
+        package_limits = (arcus_limits_t*)calloc(n_packages, sizeof(arcus_limits_t));
 
-    printf("%s\nAre you sure you'd like to continue to installation? (%sY%s/%sn%s):%s ", KBLU, KGRN, KBLU, KRED, KBLU, KGRN);
+      if (package_limits == NULL) {
+        free_char_2d(entries, &n_entries);
 
-    char* confirmation = arcus_getline(NULL, true, '\n', stdin);
+        return n_packages == 0;
+      }
 
-    if (confirmation != NULL) {
-      if (tolower(confirmation[0]) != 'y') {
-        printf("%s\n< INSTALLATION CANCELED >\n", KRED);
-        free(ignore);
+      clear_limits(&defaults);
 
-        exit(0);
+      for (int32_t entry_idx = 0; entry_idx < n_entries; ++entry_idx) {
+        if (strcmp(entries[entry_idx][0], ARCUS_LIMITS_DEFAULT) == 0)
+          valid = parse_limit_settings(entries[entry_idx][0], entries[entry_idx][1], &defaults) && valid;
       }
 
-      free(confirmation);
-    }
+      for (int32_t pkg_idx = 0; pkg_idx < n_packages; ++pkg_idx)
+        package_limits[pkg_idx] = defaults;
 
-    printf("%sBeginning installation...\n\n", KGRN);
+      for (int32_t entry_idx = 0; entry_idx < n_entries; ++entry_idx) {
+        if (strcmp(entries[entry_idx][0], ARCUS_LIMITS_DEFAULT) == 0)
+          continue;
 
-    init_env_args(false);
+        int32_t pkg_idx = 0;
 
-    printf("\n");
+        while (pkg_idx < n_packages && strcmp(packages[pkg_idx][0], entries[entry_idx][0]) != 0)
+          ++pkg_idx;
 
-    for (int32_t pkg_idx = 0; pkg_idx < n_packages; ++pkg_idx) {
-      const char* pkg_name = packages[pkg_idx][0];
-      bool ignored = is_ignored(pkg_name, ignore, n_ignore);
+        if (pkg_idx == n_packages) {
+          fprintf(stderr, "%s< UNKNOWN PACKAGE IN %s : %s%s%s >\n", KRED, path, KMAG, entries[entry_idx][0], KRED);
+          valid = false;
 
-      if (ignored) {
-        printf("%s< IGNORING : %s >\n", KYEL, pkg_name);
+          continue;
+        }
 
-        continue;
+        valid = parse_limit_settings(entries[entry_idx][0], entries[entry_idx][1], &package_limits[pkg_idx]) && valid;
       }
 
-      set_env("ARCUS_PACKAGES", pkg_name);
+      for (int32_t pkg_idx = 0; pkg_idx < n_packages; ++pkg_idx)
+        update_limits_active(&package_limits[pkg_idx]);
 
-      int32_t ret = system(packages[pkg_idx][1]);
-      if (ret == 130 || ret == 2 || ret == 33280) {
-        printf("%s\n< INSTALLATION INTERRUPTED >\n\n", KRED);
-        free(ignore);
+      free_char_2d(entries, &n_entries);
 
-        exit(2);
-      }
-    }
+      if (!valid)
+        free_limits();
 
-    init_env_args(true);
-    unsetenv("ARCUS_PACKAGES");
+      return valid;
+    #else
+      fprintf(stderr, "%s< RESOURCE LIMITS ARE NOT SUPPORTED ON THIS PLATFORM, IGNORING : %s >\n", KYEL, path);
 
-    printf("\n");
+      return true;
+    #endif
   }
 
   void
-  display_help(void) {
-    printf(
-      "%susage:%s arcus %s<operation> [...]%s\n"
-      "%soperations:%s\n"
-      "\tarcus %s{-h --help}%s\n"
-      "\tarcus %s{-V --version}%s\n"
-      "\tarcus list %s{--ignore ...}%s %s(arguments after --ignore are listed as ignored packages, separated by a whitespace)%s\n"
-      "\tarcus install %s{--ignore ...}%s %s(may require root permissions, arguments after --ignore are listed as ignored packages, separated by a whitespace)\n\n",
-      KYEL, KMAG, KCYN, KMAG, KYEL, KMAG, KCYN, KMAG, KCYN, KMAG, KCYN, KMAG, KYEL, KMAG, KCYN, KMAG, KYEL
-    );
+  free_limits(void) {
+    free(package_limits);
+    package_limits = NULL;
+
+    free_char_2d(limit_entries, &n_limit_entries);
+    limit_entries = NULL;
   }
 
-  void
-  display_ver(void) {
-    printf(
-      "%s  Arcus %s" ARCUS_VER "\n"
-      "  Copyright (C) 2015 - 2024 SigmaTech\n\n"
-      "  %sThis program may be freely redistributed under the terms of the GNU General Public License.\n%s"
-      SIGMA_SYMBOL_ASCII,
-      KMAG, KYEL, KBLU, KMAG
+  bool
+  embed_config(FILE* out) {
+    int32_t n_pkgs = 0;
+    int32_t n_envs = 0;
+    char*** pkgs = parse_pkgs(&n_pkgs);
+    char*** envs = parse_envs(&n_envs);
+
+    if (pkgs == NULL || envs == NULL) {
+      free_char_2d(pkgs, &n_pkgs);
+      free_char_2d(envs, &n_envs);
+
+      return false;
+    }
+
+    fprintf(
+      out,
+      "/**\n"
+      " * @name Arcus\n"
+      " * @note Generated by build-embedded.sh from %s, DO NOT EDIT\n"
+      " */\n\n"
+      "#define ARCUS_EMBEDDED_N_PKGS %d\n"
+      "#define ARCUS_EMBEDDED_N_ENVS %d\n\n",
+      config_dir, n_pkgs, n_envs
     );
+
+    for (int32_t table_idx = 0; table_idx < 2; ++table_idx) {
+      char*** table = table_idx == 0 ? pkgs : envs;
+      int32_t n_rows = table_idx == 0 ? n_pkgs : n_envs;
+      const char* name = table_idx == 0 ? "pkg" : "env";
+
+      fprintf(out, "static const char* const arcus_embedded_%ss[][2] = {\n", name);
+
+      if (n_rows == 0)
+        fprintf(out, "  { \"\", \"\" }\n");
+
+      for (int32_t row_idx = 0; row_idx < n_rows; ++row_idx) {
+        fprintf(out, "  { ");
+
+        for (int32_t data_idx = 0; data_idx < 2; ++data_idx) {
+          write_c_string(out, table[row_idx][data_idx]);
+          fprintf(out, data_idx == 0 ? ", " : " }");
+        }
+
+        fprintf(out, "%s\n", row_idx + 1 < n_rows ? "," : "");
+      }
+
+      fprintf(out, "};\n\nstatic const char* const* const arcus_embedded_%s_rows[] = {\n", name);
+
+      if (n_rows == 0)
+        fprintf(out, "  NULL\n");
+
+      for (int32_t row_idx = 0; row_idx < n_rows; ++row_idx)
+        fprintf(out, "  arcus_embedded_%ss[%d]%s\n", name, row_idx, row_idx + 1 < n_rows ? "," : "");
+
+      fprintf(out, "};\n\n");
+    }
+
+    free_char_2d(pkgs, &n_pkgs);
+    free_char_2d(envs, &n_envs);
+
+    return true;
   }
 
-  char***
-  parse_pkgs(int32_t* size_out) {
-    if (!pathexists("arcus_config")) {
-      fprintf(stderr, KRED "< FAILED TO STAT DIRECTORY : arcus_config >");
+  bool
+  convert_config(
+    const char* from_path,
+    const char* to_path
+  ) {
+    if (!pathexists(from_path)) {
+      fprintf(stderr, "%s< FAILED TO STAT FILE : %s >\n", KRED, from_path);
 
-      return NULL;
+      return false;
     }
 
-    if (!pathexists("arcus_config/arcus.pkgs")) {
-      fprintf(stderr, KRED "< FAILED TO STAT PACKAGES FILE : arcus_config/arcus.pkgs >");
+    int32_t n_entries = 0;
+    char*** entries = parse_file(from_path, &n_entries);
 
-      return NULL;
+    if (entries == NULL) {
+      fprintf(stderr, "%s< FAILED TO PARSE : %s >\n", KRED, from_path);
+
+      return false;
     }
 
-    FILE* file = fopen("arcus_config/arcus.pkgs", "r");
+    bool to_lines = is_lines_file(to_path);
+    bool converted = true;
 
-    if (file == NULL)
-      return NULL;
+    for (int32_t entry_idx = 0; entry_idx < n_entries && !to_lines; ++entry_idx) {
+      if (!brace_representable(entries[entry_idx][0], entries[entry_idx][1])) {
+        fprintf(stderr, "%s< ENTRY CANNOT BE REPRESENTED IN THE BRACE FORMAT : %s%s%s >\n", KRED, KMAG, entries[entry_idx][0], KRED);
+        converted = false;
+      }
+    }
 
-    return parse(file, size_out);
-  }
+    char tmp_path[ARCUS_PATH_MAX + 32];
+    FILE* out = NULL;
 
-  char***
-  parse_envs(int32_t* size_out) {
-    if (!pathexists("arcus_config")) {
-      fprintf(stderr, KRED "< FAILED TO STAT DIRECTORY : arcus_config >");
+    snprintf(tmp_path, sizeof(tmp_path), "%s.tmp", to_path);
 
-      return NULL;
+    if (converted && (out = fopen(tmp_path, "wb")) == NULL) {
+      fprintf(stderr, "%s< FAILED TO OPEN FILE : %s >\n", KRED, tmp_path);
+      converted = false;
+    }
+
+    for (int32_t entry_idx = 0; entry_idx < n_entries && out != NULL; ++entry_idx) {
+      if (to_lines) {
+        write_escaped(out, entries[entry_idx][0]);
+        fputc('\t', out);
+        write_escaped(out, entries[entry_idx][1]);
+        fputc('\n', out);
+      } else {
+        fprintf(out, "{\n  \"%s\",\n  \"%s\"\n}%s\n", entries[entry_idx][0], entries[entry_idx][1], entry_idx + 1 < n_entries ? "," : "");
+      }
     }
 
-    if (!pathexists("arcus_config/arcus.envs")) {
-      fprintf(stderr, KRED "< FAILED TO STAT ENVIRONMENT VARIABLES FILE : arcus_config/arcus.envs >");
+    if (out != NULL) {
+      bool written = ferror(out) == 0;
 
-      return NULL;
+      if (fclose(out) != 0 || !written || rename(tmp_path, to_path) != 0) {
+        fprintf(stderr, "%s< FAILED TO WRITE FILE : %s >\n", KRED, to_path);
+        remove(tmp_path);
+        converted = false;
+      }
     }
 
-    FILE* file = fopen("arcus_config/arcus.envs", "r");
+    if (converted)
+      printf("%s< CONVERTED %d ENTR%s : %s -> %s >\n", KGRN, n_entries, n_entries == 1 ? "Y" : "IES", from_path, to_path);
 
-    if (file == NULL)
-      return NULL;
+    free_char_2d(entries, &n_entries);
+
+    return converted;
+  }
+
+  void
+  print_stats(void) {
+    int64_t wall_ns = stats_now_ns() - stats.start_ns;
+    int64_t own_ns = wall_ns - stats.child_wait_ns - stats.input_wait_ns;
+
+    fflush(stdout);
+    fprintf(stderr, "\n%s< ARCUS STATISTICS >\n", KCYN);
+
+    for (int32_t file_idx = 0; file_idx < stats.n_files; ++file_idx) {
+      fprintf(
+        stderr,
+        "%sParsed:%s %s in %.3fms (%lld byte(s))\n",
+        KCYN, KNRM,
+        stats.files[file_idx].path,
+        stats.files[file_idx].elapsed_ns / 1e6,
+        (long long)stats.files[file_idx].bytes_read
+      );
+    }
+
+    fprintf(stderr, "%sRead:%s %lld byte(s) in %lld fread(...) call(s)\n", KCYN, KNRM, (long long)stats.bytes_read, (long long)stats.freads);
+    fprintf(stderr, "%sAllocated:%s %lld byte(s) in %lld allocation(s)\n", KCYN, KNRM, (long long)stats.bytes_allocated, (long long)stats.allocations);
+    fprintf(stderr, "%sSpawned:%s %lld child process(es)\n", KCYN, KNRM, (long long)stats.children);
+    fprintf(
+      stderr,
+      "%sWall Time:%s %.3fms (%.3fms waiting on children, %.3fms waiting for input, %.3fms in Arcus)\n",
+      KCYN, KNRM,
+      wall_ns / 1e6,
+      stats.child_wait_ns / 1e6,
+      stats.input_wait_ns / 1e6,
+      own_ns / 1e6
+    );
+
+    #if defined(__unix__) || defined(__linux__)
+      struct rusage usage;
+
+      if (getrusage(RUSAGE_SELF, &usage) == 0) {
+        fprintf(
+          stderr,
+          "%sCPU Time:%s %.3fms user, %.3fms system (Arcus only)\n",
+          KCYN, KNRM,
+          usage.ru_utime.tv_sec * 1e3 + usage.ru_utime.tv_usec / 1e3 + stats.worker_cpu_user_usec / 1e3,
+          usage.ru_stime.tv_sec * 1e3 + usage.ru_stime.tv_usec / 1e3 + stats.worker_cpu_system_usec / 1e3
+        );
+      }
+    #endif
 
-    return parse(file, size_out);
+    fprintf(stderr, "%s", KNRM);
   }
 
   int32_t
@@ -773,7 +11018,6 @@
       return NULL; // Invalid Command to Parse
 
     const char** arg_params = NULL;
-    int32_t n_arg_params = 0;
     bool dynamic = false;
 
     if (n_expected_params > 0) {
@@ -805,81 +11049,388 @@
     int32_t params_read = 0;
 
     for (int32_t param_idx = 0; param_idx < n_max_argv; ++param_idx) {
-      if (!dynamic && params_read == n_arg_params)
+      if (!dynamic && params_read == n_expected_params)
         break;
 
       const char* param = argv[param_idx];
 
       if (!arg_found) {
-        if (strcmp(param, arg_name) == 0) {
+        if (strcmp(param, arg_name) == 0)
           arg_found = true;
-          continue;
+
+        continue;
+      }
+
+      if (parse_command(param) == -1) {
+        // Parsing Valid Parameter (non-command)
+
+        if (dynamic) {
+          const char** re_alloc = (char const**)realloc(arg_params, (params_read + 1) * sizeof(const char*));
+
+          if (re_alloc != NULL) {
+            arg_params = re_alloc;
+
+            if (n_params_out != NULL)
+              *n_params_out = params_read + 1;
+          }
+          else {
+            fprintf(stderr, KRED "< FAILED TO ALLOCATE %zu byte(s) FOR ARG_PARAMS >\n", sizeof(char*));
+            
+            break;
+          }
+        }
+
+        ++params_read;
+        arg_params[params_read - 1] = param;
+      }
+      else
+        break;
+    }
+
+    if (n_params_out != NULL)
+      *n_params_out = params_read;
+
+    return arg_params;
+  }
+
+  const char**
+  parse_repeated_arguments(
+    const char** argv,
+    const int32_t n_max_argv,
+    const char* arg_name,
+    int32_t* n_params_out
+  ) {
+    const char** merged = NULL;
+    int32_t n_merged = 0;
+
+    for (int32_t arg_idx = 0; arg_idx < n_max_argv; ++arg_idx) {
+      if (strcmp(argv[arg_idx], arg_name) != 0)
+        continue;
+
+      int32_t n_params = 0;
+      const char** params = parse_arguments(
+        argv + arg_idx,
+        n_max_argv - arg_idx,
+        arg_name,
+        -1,
+        &n_params
+      );
+
+      if (params == NULL)
+        continue;
+
+      if (n_params > 0) {
+        const char** re_alloc = (const char**)realloc(merged, (n_merged + n_params) * sizeof(const char*));
+
+        if (re_alloc == NULL) {
+          fprintf(stderr, KRED "< FAILED TO ALLOCATE %zu byte(s) FOR ARG_PARAMS >\n", (n_merged + n_params) * sizeof(const char*));
+          free(params);
+
+          break;
+        }
+
+        merged = re_alloc;
+        memcpy(merged + n_merged, params, n_params * sizeof(const char*));
+        n_merged += n_params;
+      }
+
+      free(params);
+      arg_idx += n_params;
+    }
+
+    if (n_params_out != NULL)
+      *n_params_out = n_merged;
+
+    return merged;
+  }
+
+#pragma endregion FUNCTION DECLARATIONS
+
+int32_t main(
+  int32_t argc,
+  const char** argv
+) {
+  arcus_argv0 = argv[0];
+
+  #if defined(__unix__) || defined(__linux__)
+    const char* invoked_as = strrchr(argv[0], '/');
+
+    if (strcmp(invoked_as != NULL ? invoked_as + 1 : argv[0], "sudo") == 0)
+      return run_sudo_shim(argc, argv);
+
+    if (argc == 6 && strcmp(argv[1], "--privileged-helper") == 0)
+      return run_privileged_helper(argv[2], (uint32_t)strtoul(argv[3], NULL, 10), argv[4], (pid_t)strtol(argv[5], NULL, 10));
+  #endif
+
+  const char* daemon_group = getenv("ARCUS_DAEMON_GROUP");
+
+  for (int32_t arg_idx = 1; arg_idx < argc; ++arg_idx) {
+    if (strcmp(argv[arg_idx], "--group") == 0 && arg_idx + 1 < argc)
+      daemon_group = argv[arg_idx + 1];
+
+    if (strcmp(argv[arg_idx], "--config") == 0 && arg_idx + 1 < argc) {
+      config_dir = argv[arg_idx + 1];
+      config_overridden = true;
+    }
+
+    if (strcmp(argv[arg_idx], "--stats") == 0 && !stats.enabled) {
+      stats.enabled = true;
+      stats.start_ns = stats_now_ns();
+      atexit(print_stats);
+    }
+  }
+
+  #if defined(ARCUS_EMBED_GENERATOR)
+    return embed_config(stdout) ? 0 : 1;
+  #endif
+
+  #if defined(__unix__) || defined(__linux__)
+    if (strcmp(invoked_as != NULL ? invoked_as + 1 : argv[0], "arcusd") == 0 || (argc >= 2 && strcmp(argv[1], "daemon") == 0))
+      return run_daemon(daemon_group);
+  #else
+    if (argc >= 2 && strcmp(argv[1], "daemon") == 0)
+      return run_daemon(daemon_group);
+  #endif
+
+  #if defined(_WIN32)
+    enable_ansi();
+  #endif
+
+  const char* init_arg = NULL;
+
+  if (argc >= 2)
+    init_arg = argv[1];
+
+  if (init_arg != NULL) {
+    if (strcmp(init_arg, "-V") == 0 || strcmp(init_arg, "--version") == 0) {
+      display_ver();
+
+      #if defined(_WIN32)
+        disable_ansi();
+      #else
+        printf("%s\n", KNRM);
+      #endif
+
+      exit(0);
+    }
+
+    if (strcmp(init_arg, "show") == 0 && argc >= 3 && parse_command(argv[2]) == -1) {
+      load_config(true);
+
+      if (packages == NULL || env_args == NULL) {
+        printf(
+          "%s< FAILED TO PARSE %s%s%s >",
+          KRED,
+          packages == NULL ? "PACKAGES" : "",
+          packages == NULL && env_args == NULL ? " AND " : "",
+          env_args == NULL ? "ENVIRONMENT VARIABLES" : ""
+        );
+
+        #if defined(_WIN32)
+          disable_ansi();
+        #else
+          printf("%s\n", KNRM);
+        #endif
+
+        exit(1);
+      }
+
+      bool found = show_package(argv[2]);
+
+      free_config();
+
+      #if defined(_WIN32)
+        disable_ansi();
+      #else
+        printf("%s", KNRM);
+      #endif
+
+      exit(found ? 0 : 1);
+    }
+
+    if (strcmp(init_arg, "convert") == 0 && argc >= 4) {
+      bool converted = convert_config(argv[2], argv[3]);
+
+      #if defined(_WIN32)
+        disable_ansi();
+      #else
+        printf("%s", KNRM);
+      #endif
+
+      exit(converted ? 0 : 1);
+    }
+
+    if (strcmp(init_arg, "list") == 0) {
+      load_config(true);
+
+      if (packages == NULL || env_args == NULL) {
+        printf(
+          "%s< FAILED TO PARSE %s%s%s >",
+          KRED,
+          packages == NULL ? "PACKAGES" : "",
+          packages == NULL && env_args == NULL ? " AND " : "",
+          env_args == NULL ? "ENVIRONMENT VARIABLES" : ""
+        );
+
+        #if defined(_WIN32)
+          disable_ansi();
+        #else
+          printf("%s\n", KNRM);
+        #endif
+
+        exit(1);
+      }
+
+      const char** ignore_list = NULL;
+      int32_t ignores = 0;
+
+      if (argc >= 4) {
+        ignore_list = parse_arguments(
+          argv + 2,
+          argc - 2,
+          "--ignore",
+          -1,
+          &ignores
+        );
+      }
+
+      list_packages(
+        (const char**)ignore_list,
+        ignores
+      );
+
+      free(ignore_list);
+      free_config();
+
+      printf("%s\nRun \"%sarcus%s install {--ignore ...}%s\" to install packages\n", KBLU, KMAG, KCYN, KBLU);
+
+      #if defined(_WIN32)
+        disable_ansi();
+      #else
+        printf("%s\n", KNRM);
+      #endif
+
+      exit(0);
+    }
+
+    if (strcmp(init_arg, "fingerprint") == 0) {
+      load_config(false);
+
+      if (packages == NULL) {
+        fprintf(stderr, "%s< FAILED TO PARSE PACKAGES >%s\n", KRED, KNRM);
+
+        exit(1);
+      }
+
+      // The fingerprint is data meant to be redirected, so nothing but it is written to stdout
+      bool printed = print_fingerprint();
+
+      free_config();
+
+      exit(printed ? 0 : 1);
+    }
+
+    if (strcmp(init_arg, "diff") == 0 && argc >= 3 && parse_command(argv[2]) == -1) {
+      const char* compared = argc >= 4 && parse_command(argv[3]) == -1 ? argv[3] : NULL;
+
+      if (compared == NULL) {
+        load_config(false);
+
+        if (packages == NULL) {
+          printf("%s< FAILED TO PARSE PACKAGES >", KRED);
+
+          #if defined(_WIN32)
+            disable_ansi();
+          #else
+            printf("%s\n", KNRM);
+          #endif
+
+          exit(2);
         }
       }
 
-      if (parse_command(param) == -1) {
-        // Parsing Valid Parameter (non-command)
+      int32_t drift = diff_fingerprint(argv[2], compared);
+
+      free_config();
+
+      #if defined(_WIN32)
+        disable_ansi();
+      #else
+        printf("%s", KNRM);
+      #endif
+
+      exit(drift);
+    }
+
+    if (strcmp(init_arg, "lock") == 0) {
+      load_config(false);
+
+      if (packages == NULL || env_args == NULL) {
+        printf(
+          "%s< FAILED TO PARSE %s%s%s >",
+          KRED,
+          packages == NULL ? "PACKAGES" : "",
+          packages == NULL && env_args == NULL ? " AND " : "",
+          env_args == NULL ? "ENVIRONMENT VARIABLES" : ""
+        );
 
-        if (dynamic) {
-          const char** re_alloc = (char const**)realloc(arg_params, (params_read + 1) * sizeof(const char*));
+        #if defined(_WIN32)
+          disable_ansi();
+        #else
+          printf("%s\n", KNRM);
+        #endif
 
-          if (re_alloc != NULL) {
-            arg_params = re_alloc;
+        exit(1);
+      }
 
-            if (n_params_out != NULL)
-              *n_params_out = params_read + 1;
-          }
-          else {
-            fprintf(stderr, KRED "< FAILED TO ALLOCATE %zu byte(s) FOR ARG_PARAMS >\n", sizeof(char*));
-            
-            break;
-          }
-        }
+      const char** ignore_list = NULL;
+      int32_t ignores = 0;
 
-        ++params_read;
-        arg_params[params_read - 1] = param;
+      if (argc >= 4) {
+        ignore_list = parse_arguments(
+          argv + 2,
+          argc - 2,
+          "--ignore",
+          -1,
+          &ignores
+        );
       }
-      else
-        break;
-    }
 
-    if (n_params_out != NULL)
-      *n_params_out = params_read;
+      init_env_args(false);
 
-    return arg_params;
-  }
+      bool locked_packages = lock_packages(
+        (const char**)ignore_list,
+        ignores
+      );
 
-#pragma endregion FUNCTION DECLARATIONS
+      init_env_args(true);
 
-int32_t main(
-  int32_t argc,
-  const char** argv
-) {
-  #if defined(_WIN32)
-    enable_ansi();
-  #endif
+      free(ignore_list);
+      free_config();
 
-  const char* init_arg = NULL;
+      #if defined(_WIN32)
+        disable_ansi();
+      #else
+        printf("%s\n", KNRM);
+      #endif
 
-  if (argc >= 2)
-    init_arg = argv[1];
+      exit(locked_packages ? 0 : 1);
+    }
 
-  if (init_arg != NULL) {
-    if (strcmp(init_arg, "-V") == 0 || strcmp(init_arg, "--version") == 0) {
-      display_ver();
+    if (strcmp(init_arg, "status") == 0) {
+      int32_t running = print_status();
 
       #if defined(_WIN32)
         disable_ansi();
       #else
-        printf("%s\n", KNRM);
+        printf("%s", KNRM);
       #endif
 
-      exit(0);
+      exit(running > 0 ? 0 : 1);
     }
 
-    if (strcmp(init_arg, "list") == 0) {
-      packages = parse_pkgs(&n_packages);
-      env_args = parse_envs(&n_env_args);
+    if (strcmp(init_arg, "check") == 0) {
+      load_config(false);
 
       if (packages == NULL || env_args == NULL) {
         printf(
@@ -900,7 +11451,9 @@ int32_t main(
       }
 
       const char** ignore_list = NULL;
+      const char** root_list = NULL;
       int32_t ignores = 0;
+      int32_t roots = 0;
 
       if (argc >= 4) {
         ignore_list = parse_arguments(
@@ -910,18 +11463,25 @@ int32_t main(
           -1,
           &ignores
         );
+
+        root_list = parse_repeated_arguments(
+          argv + 2,
+          argc - 2,
+          "--root",
+          &roots
+        );
       }
 
-      list_packages(
+      bool checked = check_packages(
+        root_list,
+        roots,
         (const char**)ignore_list,
         ignores
       );
 
+      free(root_list);
       free(ignore_list);
-      free_char_2d(packages, &n_packages);
-      free_char_2d(env_args, &n_env_args);
-
-      printf("%s\nRun \"%sarcus%s install {--ignore ...}%s\" to install packages\n", KBLU, KMAG, KCYN, KBLU);
+      free_config();
 
       #if defined(_WIN32)
         disable_ansi();
@@ -929,16 +11489,16 @@ int32_t main(
         printf("%s\n", KNRM);
       #endif
 
-      exit(0);
+      exit(checked ? 0 : 1);
     }
 
-    if (strcmp(init_arg, "install") == 0) {
-      packages = parse_pkgs(&n_packages);
-      env_args = parse_envs(&n_env_args);
+    if (strcmp(init_arg, "simulate") == 0 && argc >= 3 && parse_command(argv[2]) == -1) {
+      load_config(false);
 
       if (packages == NULL || env_args == NULL) {
         printf(
-          KRED "< FAILED TO PARSE %s%s%s >",
+          "%s< FAILED TO PARSE %s%s%s >",
+          KRED,
           packages == NULL ? "PACKAGES" : "",
           packages == NULL && env_args == NULL ? " AND " : "",
           env_args == NULL ? "ENVIRONMENT VARIABLES" : ""
@@ -953,6 +11513,110 @@ int32_t main(
         exit(1);
       }
 
+      const char** ignore_list = NULL;
+      const char** jobs_list = NULL;
+      int32_t ignores = 0;
+      int32_t n_jobs_list = 0;
+
+      if (argc >= 5) {
+        ignore_list = parse_arguments(
+          argv + 3,
+          argc - 3,
+          "--ignore",
+          -1,
+          &ignores
+        );
+
+        jobs_list = parse_arguments(
+          argv + 3,
+          argc - 3,
+          "--jobs",
+          -1,
+          &n_jobs_list
+        );
+      }
+
+      int32_t default_jobs[] = { 2, 4, 8 };
+      int32_t* jobs = n_jobs_list > 0 ? (int32_t*)malloc((size_t)n_jobs_list * sizeof(int32_t)) : NULL;
+      bool simulated = n_jobs_list == 0 || jobs != NULL;
+
+      for (int32_t jobs_idx = 0; simulated && jobs_idx < n_jobs_list; ++jobs_idx) {
+        char* end = NULL;
+        long value = strtol(jobs_list[jobs_idx], &end, 10);
+
+        if (end == jobs_list[jobs_idx] || *end != '\0' || value < 1 || value > ARCUS_SIMULATE_JOBS_MAX) {
+          printf("%s< INVALID --jobs VALUE : %s%s%s (EXPECTED 1 TO %d) >", KRED, KMAG, jobs_list[jobs_idx], KRED, ARCUS_SIMULATE_JOBS_MAX);
+          simulated = false;
+        } else {
+          jobs[jobs_idx] = (int32_t)value;
+        }
+      }
+
+      if (simulated) {
+        simulated = simulate_packages(
+          argv[2],
+          n_jobs_list > 0 ? jobs : default_jobs,
+          n_jobs_list > 0 ? n_jobs_list : (int32_t)(sizeof(default_jobs) / sizeof(default_jobs[0])),
+          (const char**)ignore_list,
+          ignores
+        );
+      }
+
+      free(jobs);
+      free(jobs_list);
+      free(ignore_list);
+      free_config();
+
+      #if defined(_WIN32)
+        disable_ansi();
+      #else
+        printf("%s\n", KNRM);
+      #endif
+
+      exit(simulated ? 0 : 1);
+    }
+
+    if (strcmp(init_arg, "install") == 0) {
+      bool from_stdin = false;
+
+      for (int32_t arg_idx = 2; arg_idx < argc; ++arg_idx) {
+        if (strcmp(argv[arg_idx], "--from-stdin") == 0)
+          from_stdin = true;
+      }
+
+      // Streamed Packages are read (and their budgets selected) as they arrive, only the Environment Variables are loaded up front
+      if (from_stdin)
+        load_envs();
+      else
+        load_config(false);
+
+      if ((from_stdin || packages != NULL) && env_args != NULL && !load_limits()) {
+        printf("%s< FAILED TO PARSE RESOURCE LIMITS >", KRED);
+        free_config();
+        printf("%s\n", KNRM);
+
+        exit(1);
+      }
+
+      bool packages_missing = !from_stdin && packages == NULL;
+
+      if (packages_missing || env_args == NULL) {
+        printf(
+          KRED "< FAILED TO PARSE %s%s%s >",
+          packages_missing ? "PACKAGES" : "",
+          packages_missing && env_args == NULL ? " AND " : "",
+          env_args == NULL ? "ENVIRONMENT VARIABLES" : ""
+        );
+
+        #if defined(_WIN32)
+          disable_ansi();
+        #else
+          printf("%s\n", KNRM);
+        #endif
+
+        exit(1);
+      }
+
       const char** ignore_list = NULL;
       int32_t ignores = 0;
 
@@ -966,13 +11630,221 @@ int32_t main(
         );
       }
 
-      install_packages(
-        (const char**)ignore_list,
-        ignores
-      );
+      const char** root_list = NULL;
+      int32_t roots = 0;
+      int32_t root_jobs = ARCUS_DEFAULT_ROOT_JOBS;
+
+      if (argc >= 4) {
+        root_list = parse_repeated_arguments(
+          argv + 2,
+          argc - 2,
+          "--root",
+          &roots
+        );
+
+        int64_t value = 0;
+
+        if (parse_integer_argument(argv + 2, argc - 2, "--jobs", &value)) {
+          if (value <= 0 || value > INT32_MAX) {
+            fprintf(stderr, "%s< INVALID VALUE FOR --jobs, EXPECTED A POSITIVE INTEGER >", KRED);
+            printf("%s\n", KNRM);
+
+            exit(1);
+          }
+
+          root_jobs = (int32_t)value;
+        }
+      }
+
+      for (int32_t arg_idx = 2; arg_idx < argc; ++arg_idx) {
+        if (strcmp(argv[arg_idx], "--log") == 0)
+          log_keep = ARCUS_DEFAULT_LOG_KEEP;
+
+        if (strcmp(argv[arg_idx], "--elevate") == 0)
+          elevate = true;
+
+        if (strcmp(argv[arg_idx], "--no-daemon") == 0)
+          no_daemon = true;
+
+        if (strcmp(argv[arg_idx], "--locked") == 0)
+          locked = true;
+
+        if (strcmp(argv[arg_idx], "--no-git-cache") == 0)
+          no_git_cache = true;
+
+        if (strcmp(argv[arg_idx], "--no-check") == 0)
+          no_check = true;
+
+        if (strcmp(argv[arg_idx], "--scratch") == 0 || strcmp(argv[arg_idx], "--keep-scratch") == 0)
+          scratch_max_bytes = (int64_t)ARCUS_DEFAULT_SCRATCH_MB * 1024 * 1024;
+
+        if (strcmp(argv[arg_idx], "--keep-scratch") == 0)
+          keep_scratch = true;
+      }
+
+      int64_t scratch_value = 0;
+
+      if (parse_integer_argument(argv + 2, argc - 2, "--scratch-size", &scratch_value)) {
+        if (scratch_value <= 0 || scratch_value > INT64_MAX / (1024 * 1024)) {
+          fprintf(stderr, "%s< INVALID VALUE FOR --scratch-size, EXPECTED A SIZE IN MEGABYTES >", KRED);
+          printf("%s\n", KNRM);
+
+          exit(1);
+        }
+
+        scratch_max_bytes = scratch_value * 1024 * 1024;
+      }
+
+      int64_t log_value = 0;
+
+      if (parse_integer_argument(argv + 2, argc - 2, "--log-keep", &log_value)) {
+        if (log_value <= 0 || log_value > INT32_MAX) {
+          fprintf(stderr, "%s< INVALID VALUE FOR --log-keep, EXPECTED A POSITIVE INTEGER >", KRED);
+          printf("%s\n", KNRM);
+
+          exit(1);
+        }
+
+        log_keep = (int32_t)log_value;
+      }
+
+      int64_t prefetch_value = 0;
+
+      if (parse_integer_argument(argv + 2, argc - 2, "--prefetch", &prefetch_value)) {
+        // -1 is a bare --prefetch, anything else that isn't a non-negative integer is rejected
+        if (prefetch_value < -1 || prefetch_value > INT32_MAX) {
+          fprintf(stderr, "%s< INVALID VALUE FOR --prefetch, EXPECTED A NON-NEGATIVE INTEGER >", KRED);
+          printf("%s\n", KNRM);
+
+          exit(1);
+        }
+
+        prefetch_depth = prefetch_value < 0 ? ARCUS_DEFAULT_PREFETCH_DEPTH : (int32_t)prefetch_value;
+      }
+
+      if (parse_integer_argument(argv + 2, argc - 2, "--prefetch-jobs", &prefetch_value)) {
+        if (prefetch_value <= 0 || prefetch_value > INT32_MAX) {
+          fprintf(stderr, "%s< INVALID VALUE FOR --prefetch-jobs, EXPECTED A POSITIVE INTEGER >", KRED);
+          printf("%s\n", KNRM);
+
+          exit(1);
+        }
+
+        prefetch_jobs = (int32_t)prefetch_value;
+
+        if (prefetch_depth == 0)
+          prefetch_depth = ARCUS_DEFAULT_PREFETCH_DEPTH;
+      }
+
+      if (parse_integer_argument(argv + 2, argc - 2, "--log-max-size", &log_value)) {
+        if (log_value < 0 || log_value > INT64_MAX / (1024 * 1024)) {
+          fprintf(stderr, "%s< INVALID VALUE FOR --log-max-size, EXPECTED A SIZE IN MEGABYTES >", KRED);
+          printf("%s\n", KNRM);
+
+          exit(1);
+        }
+
+        log_max_bytes = log_value * 1024 * 1024;
+
+        if (log_keep == 0)
+          log_keep = ARCUS_DEFAULT_LOG_KEEP;
+      }
+
+      if (from_stdin && (roots > 0 || prefetch_depth > 0)) {
+        fprintf(stderr, "%s< --from-stdin CANNOT BE COMBINED WITH --root OR --prefetch >", KRED);
+        printf("%s\n", KNRM);
+
+        exit(1);
+      }
+
+      if (locked && (from_stdin || roots > 0)) {
+        fprintf(stderr, "%s< --locked CANNOT BE COMBINED WITH --from-stdin OR --root >", KRED);
+        printf("%s\n", KNRM);
+
+        exit(1);
+      }
+
+      if (locked && !load_lock()) {
+        free(root_list);
+        free(ignore_list);
+        free_config();
+        printf("%s\n", KNRM);
+
+        exit(1);
+      }
+
+      #if defined(__unix__) || defined(__linux__)
+        // Before the confirmation prompt, so a configuration that can't succeed is rejected before anything is asked or run
+        if (!from_stdin && !no_check) {
+          if (!check_packages(root_list, roots, (const char**)ignore_list, ignores)) {
+            printf("%s< INSTALLATION ABORTED, FIX THE ERRORS ABOVE OR PASS --no-check >", KRED);
+            free(root_list);
+            free(ignore_list);
+            free_config();
+            free_lock();
+            printf("%s\n", KNRM);
+
+            exit(1);
+          }
+
+          printf("\n");
+        }
+      #endif
+
+      if (roots > 0) {
+        bool roots_succeeded = install_roots(
+          root_list,
+          roots,
+          root_jobs,
+          (const char**)ignore_list,
+          ignores
+        );
+
+        free(root_list);
+        free(ignore_list);
+        free_config();
+
+        if (cancel_signal != 0)
+          printf("%s< INSTALLATION CANCELLED, SEE LOGS ABOVE >\n", KRED);
+        else
+          printf("%s< %s >\n", roots_succeeded ? KGRN : KRED, roots_succeeded ? "ALL ROOTS INSTALLED SUCCESSFULLY" : "ONE OR MORE ROOTS FAILED, SEE LOGS ABOVE");
+
+        #if defined(_WIN32)
+          disable_ansi();
+        #else
+          printf("%s\n", KNRM);
+        #endif
+
+        exit(cancel_signal != 0 ? 128 + cancel_signal : roots_succeeded ? 0 : 1);
+      }
+
+      free(root_list);
+
+      if (from_stdin) {
+        install_stream(
+          (const char**)ignore_list,
+          ignores
+        );
+      } else {
+        install_packages(
+          (const char**)ignore_list,
+          ignores
+        );
+      }
+
       free(ignore_list);
-      free_char_2d(packages, &n_packages);
-      free_char_2d(env_args, &n_env_args);
+      free_config();
+      free_lock();
+
+      if (cancel_signal != 0) {
+        #if defined(_WIN32)
+          disable_ansi();
+        #else
+          printf("%s\n", KNRM);
+        #endif
+
+        exit(128 + cancel_signal);
+      }
 
       bool PRINTED_INS_SUCC = false;
 
@@ -1002,8 +11874,7 @@ int32_t main(
 
   display_help();
 
-  free_char_2d(packages, &n_packages);
-  free_char_2d(env_args, &n_env_args);
+  free_config();
 
   #if defined(_WIN32)
     disable_ansi();
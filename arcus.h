@@ -6,6 +6,10 @@
  */
 
 #pragma region INCLUDES
+  #if defined(__linux__)
+    #define _GNU_SOURCE
+  #endif
+
   #define _POSIX_C_SOURCE 200112L
 
   #include <stdlib.h>
@@ -14,10 +18,31 @@
   #include <stdint.h>
   #include <string.h>
   #include <ctype.h>
+  #include <time.h>
+  #include <signal.h>
   #include <sys/stat.h>
 
   #if defined(__unix__) || defined(__linux__)
     #include <unistd.h>
+    #include <errno.h>
+    #include <sys/resource.h>
+    #include <fcntl.h>
+    #include <dirent.h>
+    #include <poll.h>
+    #include <sys/types.h>
+    #include <sys/wait.h>
+    #include <sys/socket.h>
+    #include <sys/un.h>
+    #include <grp.h>
+    #include <sys/file.h>
+    #include <sys/statvfs.h>
+    #include <sys/mman.h>
+  #endif
+
+  #if defined(__linux__)
+    #include <sys/syscall.h>
+    #include <sys/mount.h>
+    #include <sys/vfs.h>
   #endif
 
   #if defined(_WIN32)
@@ -62,6 +87,71 @@
   #define ARCUS_VER "v1.1.2"
   #define LOLCAT_SUPPORT false
 
+  #define ARCUS_DEFAULT_CONFIG_DIR "arcus_config"
+  #define ARCUS_INDEX_MAGIC "arcus-index v2"
+  #define ARCUS_LINES_EXT ".tsv"
+  #define ARCUS_PATH_MAX 4096
+
+  #define ARCUS_LOG_DIR "arcus_logs"
+  #define ARCUS_DEFAULT_ROOT_JOBS 4
+  #define ARCUS_DEFAULT_LOG_KEEP 10
+  #define ARCUS_RELAY_CHUNK 65536
+
+  #define ARCUS_CACHE_DIR "arcus_cache"
+  #define ARCUS_DEFAULT_PREFETCH_DEPTH 3
+  #define ARCUS_DEFAULT_PREFETCH_JOBS 2
+
+  #define ARCUS_PREFETCH_IDLE 0
+  #define ARCUS_PREFETCH_DONE -1
+  #define ARCUS_PREFETCH_FAILED -2
+  #define ARCUS_PREFETCH_UNSUPPORTED -3
+
+  #define ARCUS_LOCK_PACMAN 1
+  #define ARCUS_LOCK_FLATPAK 2
+
+  #define ARCUS_CANCEL_GRACE 5
+
+  #define ARCUS_DEFAULT_SCRATCH_MB 4096
+  #define ARCUS_SCRATCH_PREFIX "arcus-scratch"
+
+  #define ARCUS_LIMIT_UNSET -1
+  #define ARCUS_LIMITS_DEFAULT "default"
+  #define ARCUS_CGROUP_ROOT "/sys/fs/cgroup"
+  #define ARCUS_CGROUP_DIR "arcus"
+
+  #define ARCUS_HELPER_PROTOCOL "ARCUS-HELPER/2"
+  #define ARCUS_HELPER_TOKEN_SIZE 32
+  #define ARCUS_HELPER_MAX_ARGS 256
+  #define ARCUS_HELPER_MAX_FIELD 65536
+
+  #define ARCUS_STATS_MAX_FILES 8
+
+  #define ARCUS_DAEMON_PROTOCOL "ARCUS-DAEMON/1"
+  #define ARCUS_DAEMON_SOCKET "/tmp/arcusd-%lu.sock"
+  #define ARCUS_DAEMON_COALESCE_MS 250
+  #define ARCUS_DAEMON_IO_TIMEOUT 10
+  #define ARCUS_DAEMON_MAX_REQUEST (1 << 20)
+  #define ARCUS_DAEMON_NOT_RUN INT32_MIN
+
+  #define ARCUS_LOCK_FILE "arcus.lock"
+  #define ARCUS_LOCK_MAGIC "arcus-lock v2"
+  #define ARCUS_LOCK_CACHE_DIR ARCUS_CACHE_DIR "/pkg"
+  #define ARCUS_LOCKFILE_PACMAN "sudo pacman"
+  #define ARCUS_LOCK_UNCOVERED INT32_MIN
+
+  #define ARCUS_FINGERPRINT_MAGIC "arcus-fingerprint v1"
+
+  #define ARCUS_CHECK_JOBS 32
+  #define ARCUS_CHECK_MIN_FREE_MB 1024
+
+  #define ARCUS_STATUS_MAGIC "arcus-status v1"
+  #define ARCUS_STATUS_DIR "/tmp/arcus-status-%lu"
+  #define ARCUS_STATUS_SLOTS 16
+  #define ARCUS_STATUS_NAME 128
+
+  #define ARCUS_SIMULATE_JOBS_MAX 4096
+  #define ARCUS_SIMULATE_PATH_SHOWN 10
+
   // Source: https://manytools.org/hacker-tools/convert-images-to-ascii-art/go/
   #define SIGMA_SYMBOL_ASCII \
   "                                             \n" \
@@ -91,18 +181,321 @@
 static const char* commands[] = {
   "list",
   "install",
+  "show",
+  "convert",
+  "daemon",
   "-h",
   "--help",
   "-V",
   "--version",
-  "--ignore"
+  "--ignore",
+  "--root",
+  "--jobs",
+  "--config",
+  "--log",
+  "--log-keep",
+  "--log-max-size",
+  "--prefetch",
+  "--prefetch-jobs",
+  "--elevate",
+  "--stats",
+  "--no-daemon",
+  "--from-stdin",
+  "lock",
+  "--locked",
+  "fingerprint",
+  "diff",
+  "--no-git-cache",
+  "--scratch",
+  "--scratch-size",
+  "--keep-scratch",
+  "check",
+  "--no-check",
+  "status",
+  "simulate"
 };
 static const int32_t n_commands = sizeof(commands) / sizeof(commands[0]);
 
+/**
+ * @author https://github.com/SigmaEG/Arcus
+ * @brief Outcome of a single run over the Package database
+*/
+typedef struct arcus_summary {
+  int32_t installed;
+  int32_t failed;
+  int32_t ignored;
+  int32_t cancelled;
+  bool interrupted;
+} arcus_summary_t;
+
+/**
+ * @author https://github.com/SigmaEG/Arcus
+ * @brief What a `--root` worker writes to its result pipe: its summary and the `--stats` counters it added, as its own exit skips `print_stats`
+*/
+typedef struct arcus_worker_report {
+  arcus_summary_t summary;
+  int64_t freads;
+  int64_t bytes_read;
+  int64_t allocations;
+  int64_t bytes_allocated;
+  int64_t children;
+  int64_t cpu_user_usec;
+  int64_t cpu_system_usec;
+} arcus_worker_report_t;
+
+/**
+ * @author https://github.com/SigmaEG/Arcus
+ * @brief Package manager a Package body installs with, as tagged by `arcus list`
+*/
+typedef enum arcus_manager {
+  ARCUS_MANAGER_PACMAN,
+  ARCUS_MANAGER_YAY,
+  ARCUS_MANAGER_FLATPAK,
+  ARCUS_MANAGER_GIT,
+  ARCUS_MANAGER_SELF
+} arcus_manager_t;
+
+/**
+ * @author https://github.com/SigmaEG/Arcus
+ * @brief Location of a Package body inside `arcus.pkgs`, as persisted in `arcus.pkgs.idx`
+*/
+typedef struct arcus_index_entry {
+  int64_t offset;
+  int32_t length;
+  arcus_manager_t manager;
+} arcus_index_entry_t;
+
+/**
+ * @author https://github.com/SigmaEG/Arcus
+ * @brief Resource budget of a Package, as configured in `arcus.limits` (`ARCUS_LIMIT_UNSET` for settings left alone)
+*/
+typedef struct arcus_limits {
+  bool active;
+  int32_t nice;
+  int32_t io_class;
+  int32_t io_level;
+  int64_t address_space;
+  int64_t processes;
+  int64_t cpu_seconds;
+  int64_t cpu_max_percent;
+  int64_t memory_max;
+} arcus_limits_t;
+
+/**
+ * @author https://github.com/SigmaEG/Arcus
+ * @brief Time spent parsing a single Arcus file and the bytes read doing so, as reported by `--stats`
+*/
+typedef struct arcus_file_stats {
+  char path[ARCUS_PATH_MAX];
+  int64_t elapsed_ns;
+  int64_t bytes_read;
+} arcus_file_stats_t;
+
+/**
+ * @author https://github.com/SigmaEG/Arcus
+ * @brief Arcus's own counters for a single run, as reported by `--stats`
+*/
+typedef struct arcus_stats {
+  bool enabled;
+  int64_t start_ns;
+  arcus_file_stats_t files[ARCUS_STATS_MAX_FILES];
+  int32_t n_files;
+  int64_t freads;
+  int64_t bytes_read;
+  int64_t allocations;
+  int64_t bytes_allocated;
+  int64_t children;
+  int64_t child_wait_ns;
+  int64_t input_wait_ns;
+  int64_t worker_cpu_user_usec;
+  int64_t worker_cpu_system_usec;
+} arcus_stats_t;
+
+/**
+ * @author https://github.com/SigmaEG/Arcus
+ * @brief An `arcus install` connected to `arcusd`, waiting on the Packages it still wants
+*/
+typedef struct arcus_daemon_client {
+  int32_t fd;
+  int64_t pid;
+  bool* wanted;
+  int32_t pending;
+  bool attached;
+} arcus_daemon_client_t;
+
+/**
+ * @author https://github.com/SigmaEG/Arcus
+ * @brief A connection to `arcusd` whose request hasn't fully arrived yet, read without blocking whenever it becomes readable
+*/
+typedef struct arcus_daemon_request {
+  int32_t fd;
+  int64_t pid;
+  char* data;
+  size_t used;
+  int64_t deadline_ns;
+} arcus_daemon_request_t;
+
+/**
+ * @author https://github.com/SigmaEG/Arcus
+ * @brief State of `arcusd`, `results` holds the wait status of the invocation whose results are being sent (`ARCUS_DAEMON_NOT_RUN` otherwise) and `group` the group whose members may connect (`-1` for none)
+*/
+typedef struct arcus_daemon {
+  int32_t listen_fd;
+  arcus_daemon_client_t* clients;
+  int32_t n_clients;
+  arcus_daemon_request_t* requests;
+  int32_t n_requests;
+  int32_t* results;
+  bool installing;
+  int64_t group;
+  char config_real[ARCUS_PATH_MAX];
+  char signature[3 * (ARCUS_PATH_MAX + 64)];
+} arcus_daemon_t;
+
+/**
+ * @author https://github.com/SigmaEG/Arcus
+ * @brief Running state of a SHA-256 digest
+*/
+typedef struct arcus_sha256 {
+  uint32_t state[8];
+  uint64_t length;
+  uint8_t block[64];
+  size_t used;
+} arcus_sha256_t;
+
+/**
+ * @author https://github.com/SigmaEG/Arcus
+ * @brief A package file pinned by `arcus lock` for a Package, as recorded in `arcus.lock`
+*/
+typedef struct arcus_lock_entry {
+  int32_t pkg_idx;
+  char* name;
+  char* version;
+  char* file;
+  char sha256[65];
+} arcus_lock_entry_t;
+
+/**
+ * @author https://github.com/SigmaEG/Arcus
+ * @brief Per-Package content hashes of a configuration and the root hash over all of them, as written by `arcus fingerprint`
+*/
+typedef struct arcus_fingerprint {
+  char root[65];
+  char** names;
+  char (*hashes)[65];
+  int32_t n_leaves;
+} arcus_fingerprint_t;
+
+/**
+ * @author https://github.com/SigmaEG/Arcus
+ * @brief What a single worker of a run is doing, as published in its status table
+ * @note Only its worker writes a slot. `sequence` is odd whilst it does, readers copy the slot and retry if `sequence` was odd or changed meanwhile.
+*/
+typedef struct arcus_status_slot {
+  uint32_t sequence;
+  int32_t number;
+  int64_t started_at;
+  int32_t last_exit;
+  char root[ARCUS_STATUS_NAME];
+  char package[ARCUS_STATUS_NAME];
+  char last_package[ARCUS_STATUS_NAME];
+} arcus_status_slot_t;
+
+/**
+ * @author https://github.com/SigmaEG/Arcus
+ * @brief Status table of a running installation, mapped from `ARCUS_STATUS_DIR/<pid>.status` by the installer and by `arcus status`
+ * @note Everything before `installed` is written once before the file is published. The counters are only changed with atomic adds, `total` is 0 when unknown ({--from-stdin}).
+*/
+typedef struct arcus_status {
+  char magic[24];
+  int64_t pid;
+  int64_t started_at;
+  char run_id[64];
+  int32_t total;
+  int32_t n_slots;
+  int32_t installed;
+  int32_t failed;
+  int32_t ignored;
+  int32_t cancelled;
+  int32_t finished;
+  arcus_status_slot_t slots[ARCUS_STATUS_SLOTS];
+} arcus_status_t;
+
+/**
+ * @author https://github.com/SigmaEG/Arcus
+ * @brief Measured duration of a Package, as read from the durations file of `arcus simulate`
+*/
+typedef struct arcus_duration {
+  char* name;
+  double seconds;
+  int32_t locks;
+  int32_t line_no;
+} arcus_duration_t;
+
+/**
+ * @author https://github.com/SigmaEG/Arcus
+ * @brief A Package as scheduled by `arcus simulate`, `locks` is a bitmask of `ARCUS_LOCK_*` it holds for its whole duration
+*/
+typedef struct arcus_sim_task {
+  int32_t pkg_idx;
+  double seconds;
+  int32_t locks;
+} arcus_sim_task_t;
+
 static char*** packages = NULL;
 static int32_t n_packages = 0;
 static char*** env_args = NULL;
 static int32_t n_env_args = 0;
+static const char* config_dir = ARCUS_DEFAULT_CONFIG_DIR;
+static bool config_overridden = false;
+static bool config_embedded = false;
+static arcus_index_entry_t* package_index = NULL;
+static FILE* package_file = NULL;
+static char package_path[ARCUS_PATH_MAX] = "";
+static bool package_lines = false;
+static char log_run_dir[ARCUS_PATH_MAX] = "";
+static arcus_limits_t* package_limits = NULL;
+static char*** limit_entries = NULL;
+static int32_t n_limit_entries = 0;
+static char cgroup_parent[ARCUS_PATH_MAX] = "";
+static char package_cgroup[ARCUS_PATH_MAX + 32] = "";
+static char package_scratch[ARCUS_PATH_MAX] = "";
+static bool scratch_mounted = false;
+static int64_t scratch_max_bytes = 0;
+static bool keep_scratch = false;
+static int32_t cgroup_state = 0;
+static int32_t log_keep = 0;
+static int64_t log_max_bytes = 0;
+static int32_t prefetch_depth = 0;
+static int32_t prefetch_jobs = ARCUS_DEFAULT_PREFETCH_JOBS;
+static const char* arcus_argv0 = NULL;
+static bool elevate = false;
+static bool no_daemon = false;
+static bool no_git_cache = false;
+static bool locked = false;
+static bool no_check = false;
+static arcus_lock_entry_t* lock_entries = NULL;
+static int32_t n_lock_entries = 0;
+static int32_t* lock_results = NULL;
+static volatile sig_atomic_t cancel_signal = 0;
+static int32_t cancel_grace = ARCUS_CANCEL_GRACE;
+static arcus_stats_t stats = { 0 };
+
+#if defined(__unix__) || defined(__linux__)
+  static pid_t helper_pid = -1;
+  static int32_t helper_control_fd = -1;
+  static char helper_dir[ARCUS_PATH_MAX] = "";
+  static char* helper_saved_path = NULL;
+  static char helper_token[ARCUS_HELPER_TOKEN_SIZE * 2 + 1] = "";
+  static pid_t helper_installer = -1;
+  static pid_t interrupt_target = -1;
+  static int32_t helper_wake_fds[2] = { -1, -1 };
+  static pid_t* volatile active_groups = NULL;
+  static volatile int32_t n_active_groups = 0;
+  static arcus_status_t* status_table = NULL;
+  static int32_t status_slot = 0;
+  static char status_path[ARCUS_PATH_MAX] = "";
+#endif
 
 #pragma endregion GLOBAL DEFINITIONS
 
@@ -221,6 +614,61 @@ static int32_t n_env_args = 0;
     const int32_t n_ignore
   );
 
+  /**
+   * @author https://github.com/SigmaEG/Arcus
+   * @brief Determines which package manager a Package body installs with
+   * 
+   * @param body > Commands of the Package
+   * 
+   * @return `arcus_manager_t` - > The package manager, `ARCUS_MANAGER_SELF` if none is recognized
+  */
+  arcus_manager_t
+  package_manager(const char* body);
+
+  /**
+   * @author https://github.com/SigmaEG/Arcus
+   * @brief Names a package manager as tagged by `arcus list`
+   * 
+   * @param manager > Package manager to name
+   * 
+   * @return `const char*` - > e.g `PACMAN`, `YAY-AUR`, `SELF-DEFINED`
+  */
+  const char*
+  manager_name(const arcus_manager_t manager);
+
+  /**
+   * @author https://github.com/SigmaEG/Arcus
+   * @brief Determines which package manager the Package at `pkg_idx` installs with, without loading its body if it was indexed
+   * 
+   * @param pkg_idx > Index of the Package in `packages`
+   * 
+   * @return `arcus_manager_t` - > The package manager, `ARCUS_MANAGER_SELF` if none is recognized
+  */
+  arcus_manager_t
+  package_manager_at(const int32_t pkg_idx);
+
+  /**
+   * @author https://github.com/SigmaEG/Arcus
+   * @brief Returns the body of the Package at `pkg_idx`, reading and stripping it from `arcus.pkgs` on first access if it was indexed
+   * 
+   * @param pkg_idx > Index of the Package in `packages`
+   * 
+   * @return `const char*` - > The body of the Package (an empty string if it can't be read)
+  */
+  const char*
+  package_body(const int32_t pkg_idx);
+
+  /**
+   * @author https://github.com/SigmaEG/Arcus
+   * @brief Prints a single Package's body and metadata
+   * 
+   * @param pkg_name > Name (header) of the Package to show
+   * 
+   * @return `bool` - > Whether the Package exists
+  */
+  bool
+  show_package(const char* pkg_name);
+
   /**
    * @author https://github.com/SigmaEG/Arcus
    * @brief Lists packages to be installed, tagged with [IGNORED] if specified by {--ignore ...} switch
@@ -244,6 +692,7 @@ static int32_t n_env_args = 0;
    * @param n_ignore > Number of ignored packages (size of `ignore`)
    * 
    * @return `void`
+   * @note When the installation is cancelled (SIGINT/SIGTERM) `cancel_signal` is set on return, the caller should exit with `128 + cancel_signal`
   */
   void
   install_packages(
@@ -251,6 +700,303 @@ static int32_t n_env_args = 0;
     const int32_t n_ignore
   );
 
+  /**
+   * @author https://github.com/SigmaEG/Arcus
+   * @brief Runs every Package that isn't marked by the {--ignore ...} switch, without prompting.
+   * 
+   * @param ignore > The ignore list to query
+   * @param n_ignore > Number of ignored packages (size of `ignore`)
+   * 
+   * @return `arcus_summary_t` - > Counts of installed, failed, ignored and cancelled Packages
+   * @note Environment Variables must already be initialized with `init_env_args(false)`
+   * @note When {--prefetch N} was specified, downloads for the next N Packages run in the background whilst the current one installs
+   * @note Every Package runs in its own process group. A SIGINT/SIGTERM is forwarded to it, escalating to SIGKILL after `ARCUS_CANCEL_GRACE` seconds, and the partial results are written out before returning
+  */
+  arcus_summary_t
+  run_packages(
+    const char** ignore,
+    const int32_t n_ignore
+  );
+
+  /**
+   * @author https://github.com/SigmaEG/Arcus
+   * @brief Installs the Packages defined on stdin by the {--from-stdin} switch, without prompting, as each definition arrives.
+   * 
+   * @param ignore > The ignore list to query
+   * @param n_ignore > Number of ignored packages (size of `ignore`)
+   * 
+   * @return `void`
+   * @note Package bodies get the terminal (or `/dev/null`) as their stdin, so they can't consume definitions that haven't been read yet
+   * @note When the installation is cancelled (SIGINT/SIGTERM) `cancel_signal` is set on return, the caller should exit with `128 + cancel_signal`
+  */
+  void
+  install_stream(
+    const char** ignore,
+    const int32_t n_ignore
+  );
+
+  /**
+   * @author https://github.com/SigmaEG/Arcus
+   * @brief Reads Package definitions in the brace format from a stream and runs each one that isn't marked by the {--ignore ...} switch as soon as its entry is complete.
+   * 
+   * @param stream > Stream to read definitions from, up to its closing brace, an empty line or its end
+   * @param ignore > The ignore list to query
+   * @param n_ignore > Number of ignored packages (size of `ignore`)
+   * 
+   * @return `arcus_summary_t` - > Counts of installed, failed, ignored and cancelled Packages
+   * @note Only the Package being installed is held in memory, whatever the length of the stream. Budgets from `arcus.limits` are selected by name as each Package arrives.
+   * @note Environment Variables must already be initialized with `init_env_args(false)`
+  */
+  arcus_summary_t
+  run_stream(
+    FILE* stream,
+    const char** ignore,
+    const int32_t n_ignore
+  );
+
+  /**
+   * @author https://github.com/SigmaEG/Arcus
+   * @brief Installs packages into each target root specified by the {--root ...} switch, `max_jobs` roots at a time.
+   * 
+   * @param roots > Target root directories, exported to each run as `ARCUS_ROOT`
+   * @param n_roots > Number of target roots (size of `roots`)
+   * @param max_jobs > Maximum amount of roots to install into concurrently
+   * @param ignore > The ignore list to query
+   * @param n_ignore > Number of ignored packages (size of `ignore`)
+   * 
+   * @return `bool` - > Whether every root installed without failures
+   * @note Each root logs to `ARCUS_LOG_DIR/<root>.log` after its canonical path, suffixed when two roots would share a log
+   * @note A SIGINT/SIGTERM stops starting new roots and is forwarded to every running worker, which cancels its Package
+  */
+  bool
+  install_roots(
+    const char** roots,
+    const int32_t n_roots,
+    const int32_t max_jobs,
+    const char** ignore,
+    const int32_t n_ignore
+  );
+
+  /**
+   * @author https://github.com/SigmaEG/Arcus
+   * @brief Creates a new run directory under `ARCUS_LOG_DIR` that receives one log per Package, pruning older runs.
+   * 
+   * @param keep > Maximum amount of run directories to retain (including the new one)
+   * @param max_bytes > Maximum combined size of retained run directories, 0 for unlimited
+   * 
+   * @return `bool` - > Whether per-package logging was enabled
+  */
+  bool
+  start_log_run(
+    const int32_t keep,
+    const int64_t max_bytes
+  );
+
+  /**
+   * @author https://github.com/SigmaEG/Arcus
+   * @brief Removes the oldest run directories under `ARCUS_LOG_DIR` until at most `keep` remain within `max_bytes`.
+   * 
+   * @param current > Run directory that is never pruned (may be NULL)
+   * @param keep > Maximum amount of run directories to retain
+   * @param max_bytes > Maximum combined size of retained run directories, 0 for unlimited
+   * 
+   * @return `int32_t` - > Amount of run directories removed
+  */
+  int32_t
+  prune_log_runs(
+    const char* current,
+    const int32_t keep,
+    const int64_t max_bytes
+  );
+
+  /**
+   * @author https://github.com/SigmaEG/Arcus
+   * @brief Authenticates with `sudo` (or `$ARCUS_SUDO`) once and starts a privileged helper that runs every `sudo` command of the installation.
+   * 
+   * @return `bool` - > Whether the helper authenticated and is accepting requests
+   * @note A `sudo` shim (Arcus itself) is prepended to `PATH` that forwards its argv, working directory and stdio to the helper over a Unix socket. Invocations using `sudo` options fall back to the real `sudo`.
+  */
+  bool
+  start_privileged_helper(void);
+
+  /**
+   * @author https://github.com/SigmaEG/Arcus
+   * @brief Stops the privileged helper started by `start_privileged_helper()` and removes its `sudo` shim.
+   * 
+   * @return `void`
+  */
+  void
+  stop_privileged_helper(void);
+
+  /**
+   * @author https://github.com/SigmaEG/Arcus
+   * @brief Runs as the privileged helper (invoked as `arcus --privileged-helper <socket> <uid> <audit-log> <installer-pid>` through `sudo`) until its stdin is closed.
+   * 
+   * @param socket_path > Unix socket to accept requests on
+   * @param uid > Only user (besides root) allowed to send requests
+   * @param audit_path > File every request (accepted or rejected) is appended to, created by the installation beforehand and only used if it is a regular file of `uid` reached without following a link
+   * @param installer > Installation the helper serves, on Linux only its descendants may send requests
+   * 
+   * @return `int32_t` - > Exit status of the helper
+   * @note The first line on stdin is `TOKEN <hex>`, the session token the installation exports to its Packages as `$ARCUS_HELPER_TOKEN`. Requests without it are rejected, so other processes of the same user can't use the helper.
+   * @note Protocol (client to helper): `ARCUS-HELPER/2 EXEC\n` carrying stdin/stdout/stderr as `SCM_RIGHTS`, `TOKEN <len>\n<bytes>`, `CWD <len>\n<bytes>`, `ARGC <n>\n`, n * `ARG <len>\n<bytes>`, `END\n`. Reply: `EXIT <status>\n` or `ERROR <reason>\n`. The argv is executed directly, never through a shell, in its own process group.
+  */
+  int32_t
+  run_privileged_helper(
+    const char* socket_path,
+    const uint32_t uid,
+    const char* audit_path,
+    const pid_t installer
+  );
+
+  /**
+   * @author https://github.com/SigmaEG/Arcus
+   * @brief Runs as the `sudo` shim, forwarding `sudo <command> [args...]` to the privileged helper at `$ARCUS_HELPER_SOCKET`.
+   * 
+   * @param argc > Passed from `int32_t main(int32_t argc, ...)`
+   * @param argv > Passed from `int32_t main(..., const char** argv)`
+   * 
+   * @return `int32_t` - > Exit status of the command
+  */
+  int32_t
+  run_sudo_shim(
+    const int32_t argc,
+    const char** argv
+  );
+
+  /**
+   * @author https://github.com/SigmaEG/Arcus
+   * @brief Runs as `arcusd` (`arcus daemon`, or Arcus invoked as `arcusd`), installing Packages on behalf of every `arcus install` that connects to `$ARCUS_DAEMON_SOCKET` (default `/tmp/arcusd-<uid>.sock`).
+   * 
+   * @param group > Group whose members may connect besides the daemon's own user and root (`--group`, else `$ARCUS_DAEMON_GROUP`), `NULL` or empty to serve only them
+   * 
+   * @return `int32_t` - > Exit status of the daemon
+   * @note The configuration is parsed once and reloaded whenever it changes between batches. Requests arriving whilst a batch runs join it in configuration order, Packages of the same manager with identical bodies using `${ARCUS_PACKAGES}` run as a single invocation, and each client receives the output of the Packages it asked for and the result of each. A result is shared only with the clients waiting when its invocation finishes, a later request runs the Package again.
+   * @note Protocol (client to daemon): `ARCUS-DAEMON/1 INSTALL\n`, `CONFIG <len>\n<bytes>`, `IGNORES <n>\n`, n * `IGNORE <len>\n<bytes>`, `END\n`. Reply: `ACCEPT <n>\n` or `ERROR <reason>\n`, then `START`, `OUTPUT` and `RESULT` fields (`<status>\t<ran|shared>\t<package>`) and finally `DONE\n`.
+  */
+  int32_t
+  run_daemon(const char* group);
+
+  /**
+   * @author https://github.com/SigmaEG/Arcus
+   * @brief Pins the exact version of every `pacman`/`yay` Package that isn't marked by the {--ignore ...} switch, downloading its package files into `ARCUS_LOCK_CACHE_DIR` and recording them in `arcus.lock`.
+   * 
+   * @param ignore > The ignore list to query
+   * @param n_ignore > Number of ignored packages (size of `ignore`)
+   * 
+   * @return `bool` - > Whether `arcus.lock` was written
+   * @note Environment Variables must already be initialized with `init_env_args(false)`
+   * @note Targets are the non-option arguments of the body's `${ARCUS_SU_PACMAN}`/`${ARCUS_YAY}` command, resolved (with their missing dependencies) through `pacman -Sp` and downloaded with `$ARCUS_LOCKFILE_PACMAN_CMD -Sw` (default `ARCUS_LOCKFILE_PACMAN`). Packages that can't be resolved, such as AUR packages, are left unlocked.
+   * @note Each line of `arcus.lock` is `<package>\t<name>\t<version>\t<file>\t<sha256>\t<body sha256>`, after an `ARCUS_LOCK_MAGIC` header. `<body sha256>` is the Package's leaf hash as printed by `arcus fingerprint`
+  */
+  bool
+  lock_packages(
+    const char** ignore,
+    const int32_t n_ignore
+  );
+
+  /**
+   * @author https://github.com/SigmaEG/Arcus
+   * @brief Loads `arcus.lock` into `lock_entries` for {--locked}.
+   * 
+   * @return `bool` - > Whether `arcus.lock` exists and is well-formed
+   * @note Entries of Packages that are no longer in `packages`, or whose header or body changed since `arcus lock` (their leaf hash differs), are skipped with a warning, so those Packages run their bodies
+  */
+  bool
+  load_lock(void);
+
+  /**
+   * @author https://github.com/SigmaEG/Arcus
+   * @brief Releases `lock_entries` and `lock_results`.
+   * 
+   * @return `void`
+  */
+  void
+  free_lock(void);
+
+  /**
+   * @author https://github.com/SigmaEG/Arcus
+   * @brief Prints the fingerprint of the loaded configuration to stdout: the SHA-256 of every Package and a root hash over all of them.
+   * 
+   * @return `bool` - > Whether the fingerprint was written in full
+   * @note Each Package is hashed as `<header>\n<body>` after the stripping `parse(...)` applies, so re-indenting or converting `arcus.pkgs` doesn't change it. The root is the SHA-256 of the Package hashes (as hex) in configuration order.
+   * @note Output is `ARCUS_FINGERPRINT_MAGIC`, `root\t<sha256>`, then `<sha256>\t<package>` per Package
+  */
+  bool
+  print_fingerprint(void);
+
+  /**
+   * @author https://github.com/SigmaEG/Arcus
+   * @brief Compares a configuration against the fingerprint in `reference`, reporting added, removed and changed Packages.
+   * 
+   * @param reference > Fingerprint file to compare against (e.g of the golden configuration)
+   * @param compared > Fingerprint file to compare, or NULL for the loaded configuration
+   * 
+   * @return `int32_t` - > 0 if the root hashes match, 1 if the configurations drifted, 2 if a fingerprint couldn't be read
+   * @note Only the header of `reference` is read when the root hashes match
+  */
+  int32_t
+  diff_fingerprint(
+    const char* reference,
+    const char* compared
+  );
+
+  /**
+   * @author https://github.com/SigmaEG/Arcus
+   * @brief Validates every Package that isn't marked by the {--ignore ...} switch without running any of them, reporting each problem found.
+   * 
+   * @param roots > Target roots specified by the {--root ...} switch, checked for free space (`/` when there are none)
+   * @param n_roots > Number of target roots (size of `roots`)
+   * @param ignore > The ignore list to query
+   * @param n_ignore > Number of ignored packages (size of `ignore`)
+   * 
+   * @return `bool` - > Whether no errors were found, warnings don't count
+   * @note Errors: `${VAR}` references that are in neither `arcus.envs`, the environment, the variables Arcus exports nor assigned by the body, commands that resolve to no builtin, function or executable on `PATH` (unless a selected Package of that name runs first or `ARCUS_CHECK_ALLOW` lists them), bodies rejected by `sh -n` and less than `ARCUS_CHECK_MIN_FREE_MB` free on a root, the working directory or the {--scratch} base
+   * @note Warnings: `sudo` is used and would prompt for a password
+   * @note The `sh -n` checks run `ARCUS_CHECK_JOBS` at a time, skipping bodies made only of plain words and `${VAR}` references, and checking identical bodies once
+  */
+  bool
+  check_packages(
+    const char** roots,
+    const int32_t n_roots,
+    const char** ignore,
+    const int32_t n_ignore
+  );
+
+  /**
+   * @author https://github.com/SigmaEG/Arcus
+   * @brief Prints what every installation running as the current user is doing, as published in its status table.
+   * 
+   * @return `int32_t` - > Number of running installations found
+   * @note Tables are read from `$ARCUS_STATUS_DIR` (default `ARCUS_STATUS_DIR` of the current user) without contacting the installers, tables of installers that are no longer running are reported as stale
+  */
+  int32_t
+  print_status(void);
+
+  /**
+   * @author https://github.com/SigmaEG/Arcus
+   * @brief Predicts how long installing every Package that isn't marked by the {--ignore ...} switch takes under different schedules, from measured durations, without running anything.
+   * 
+   * @param durations_path > File of `<package>\t<seconds>[\t<locks>]` lines, `<locks>` being `pacman`, `flatpak`, both joined by `,` or `none`
+   * @param jobs > Worker counts to simulate
+   * @param n_jobs > Number of worker counts (size of `jobs`)
+   * @param ignore > The ignore list to query
+   * @param n_ignore > Number of ignored packages (size of `ignore`)
+   * 
+   * @return `bool` - > Whether the durations file was read and matched at least one Package
+   * @note Schedules: serial, batched (N Packages at a time, each batch waiting for its slowest) and N workers (each free worker takes the next Package), in file, longest-first and shortest-first order. Packages sharing a package manager lock never overlap, the lock is inferred from the body like for {--prefetch} when `<locks>` is omitted.
+   * @note Packages without a duration are assumed to take the mean of the others, a Package listed more than once takes its last line. Reports the makespan, worker utilization and critical path of every schedule.
+   * @note The schedules are hypothetical, `arcus install` runs the Packages of a root serially in file order and its {--jobs N} only parallelises {--root} targets
+  */
+  bool
+  simulate_packages(
+    const char* durations_path,
+    const int32_t* jobs,
+    const int32_t n_jobs,
+    const char** ignore,
+    const int32_t n_ignore
+  );
+
   /**
    * @author https://github.com/SigmaEG/Arcus
    * @brief Displays Arcus Help Information.
@@ -280,6 +1026,19 @@ static int32_t n_env_args = 0;
   char***
   parse_pkgs(int32_t* size_out);
 
+  /**
+   * @author https://github.com/SigmaEG/Arcus
+   * @brief Loads only the headers of the Package database, using (and refreshing) the offset index `arcus.pkgs.idx`.
+   * 
+   * @param size_out > If not NULL, sets the pointer to the amount of elements in `return`
+   * 
+   * @return `char***` - > Returns a 2D C-Style String Array containing the Package headers, with bodies left NULL until `package_body(...)` loads them.
+   * @note A fresh index is read with a single `fread(...)` and `arcus.pkgs` isn't opened at all until a body is accessed.
+   * @note The index of `arcus.pkgs.tsv` is kept in `arcus.pkgs.tsv.idx` and its bodies are unescaped on access.
+  */
+  char***
+  index_pkgs(int32_t* size_out);
+
   /**
    * @author https://github.com/SigmaEG/Arcus
    * @brief Parses the Environment Variable database from an external file into a usable 2D C-Array.
@@ -291,6 +1050,96 @@ static int32_t n_env_args = 0;
   char***
   parse_envs(int32_t* size_out);
 
+  /**
+   * @author https://github.com/SigmaEG/Arcus
+   * @brief Loads the Package and Environment Variable databases into `packages` and `env_args`.
+   * 
+   * @param lazy > Whether Package bodies should only be loaded once accessed through `package_body(...)` (see `index_pkgs(...)`)
+   * 
+   * @return `void`
+   * @note Builds compiled with `ARCUS_EMBEDDED` point both databases at the tables generated by `build-embedded.sh` (no file I/O, no allocation), unless {--config ...} was specified.
+  */
+  void
+  load_config(const bool lazy);
+
+  /**
+   * @author https://github.com/SigmaEG/Arcus
+   * @brief Loads only the Environment Variable database into `env_args`, for installations whose Packages don't come from `arcus.pkgs`.
+   * 
+   * @return `void`
+   * @note Released by `free_config()` like a database loaded by `load_config(...)`
+  */
+  void
+  load_envs(void);
+
+  /**
+   * @author https://github.com/SigmaEG/Arcus
+   * @brief Releases the Package and Environment Variable databases loaded by `load_config()`.
+   * 
+   * @return `void`
+  */
+  void
+  free_config(void);
+
+  /**
+   * @author https://github.com/SigmaEG/Arcus
+   * @brief Loads the optional per-Package resource budgets from `arcus.limits` into `package_limits`.
+   * 
+   * @return `bool` - > Whether `arcus.limits` is absent or every entry is valid
+   * @note Entries are `{ "<package>", "<setting>=<value> ..." }`, an entry named `default` applies to every Package and is overridden setting by setting
+   * @note Settings: `nice=N`, `ionice=idle|best-effort[:N]|realtime[:N]`, `as=SIZE`, `nproc=N`, `cpu=SECONDS`, `cpu.max=PERCENT`, `memory.max=SIZE` (sizes take a K, M, G or T suffix)
+   * @note Always read from the configuration directory at runtime, even when the Packages are embedded, so budgets can be tuned per host
+   * @note With no Packages loaded ({--from-stdin}) the entries are validated and kept in `limit_entries` instead, each budget is selected once its Package arrives
+  */
+  bool
+  load_limits(void);
+
+  /**
+   * @author https://github.com/SigmaEG/Arcus
+   * @brief Releases the resource budgets loaded by `load_limits()`.
+   * 
+   * @return `void`
+  */
+  void
+  free_limits(void);
+
+  /**
+   * @author https://github.com/SigmaEG/Arcus
+   * @brief Writes the parsed Package and Environment Variable databases as C source containing static tables.
+   * 
+   * @param out > Stream to write the generated source to (included by `ARCUS_EMBEDDED` builds as `arcus_embedded.h`)
+   * 
+   * @return `bool` - > Whether both databases were parsed and written
+  */
+  bool
+  embed_config(FILE* out);
+
+  /**
+   * @author https://github.com/SigmaEG/Arcus
+   * @brief Converts an Arcus file between the brace format and the line-oriented `header<TAB>body` format, detected by the `ARCUS_LINES_EXT` extension of each path.
+   * 
+   * @param from_path > File to read
+   * @param to_path > File to write, atomically replaced
+   * 
+   * @return `bool` - > Whether every entry was converted, nothing is written otherwise
+   * @note Entries that the brace format cannot represent exactly (e.g bodies containing a newline) are reported and fail the conversion instead of being altered.
+  */
+  bool
+  convert_config(
+    const char* from_path,
+    const char* to_path
+  );
+
+  /**
+   * @author https://github.com/SigmaEG/Arcus
+   * @brief Prints Arcus's own counters for the run (parse time per file, `fread(...)` calls, heap allocations, child processes and where the time went) to stderr.
+   * 
+   * @return `void`
+   * @note Registered with `atexit(...)` when `--stats` is passed, so it covers every operation and exit path.
+  */
+  void
+  print_stats(void);
+
   /**
    * @author https://github.com/SigmaEG/Arcus
    * @brief Determines whether a command is valid and is of two categories, a BASE or SUB command.
@@ -324,4 +1173,24 @@ static int32_t n_env_args = 0;
     int32_t* n_params_out
   );
 
+  /**
+   * @author https://github.com/SigmaEG/Arcus
+   * @brief Parses every occurrence of a repeatable argument (command) and merges their parameters.
+   * 
+   * @param argv > Passed from `int32_t main(..., const char** argv)`
+   * @param n_max_argv > Passed from `int32_t main(int32_t argc, ...)`
+   * @param arg_name > Name of the Command to Parse
+   * @param n_params_out > Pointer to an external `int32_t` that stores the size of the list on success.
+   * 
+   * @return `const char**` - > Returns a list `const char**` of parameters on success or NULL
+   * @note ON freeing the returned list, DO NOT free its children as they are constant pointers to argv variables.
+  */
+  const char**
+  parse_repeated_arguments(
+    const char** argv,
+    const int32_t n_max_argv,
+    const char* arg_name,
+    int32_t* n_params_out
+  );
+
 #pragma endregion FUNCTION DECLARATIONS
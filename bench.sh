@@ -0,0 +1,242 @@
+#!/usr/bin/bash
+
+# End-to-end benchmark of `arcus install` against stand-in package managers, nothing on the system is touched.
+#
+# usage: bash bench.sh [-n PACKAGES] [-l LATENCY_MS] [-o LINES] [-f FAIL_PCT] [-r RUNS] [-- ARCUS_ARGS...]
+#
+#   -n  Packages in the generated arcus_config (default 200), cycling pacman, yay, flatpak and git bodies
+#   -l  Latency of every stand-in invocation in milliseconds (default 0)
+#   -o  Lines of output printed by every stand-in invocation (default 20)
+#   -f  Percentage of stand-in invocations that fail (default 0)
+#   -r  Runs to average (default 3)
+#   --  Anything after is passed to `arcus install` (e.g. -- --log --prefetch 4)
+#
+# Results are appended to arcus_bench/results.tsv, one row per invocation, keyed by commit so runs can be compared.
+# The per-package overhead is only computed for serial runs: with --prefetch or --root, children run concurrently and
+# their time overlaps, so wall time minus child time means nothing and the column is left as "-".
+
+set -e -o pipefail
+
+PACKAGES=200
+LATENCY_MS=0
+LINES=20
+FAIL_PCT=0
+RUNS=3
+
+while getopts "n:l:o:f:r:" opt; do
+  case "$opt" in
+    n) PACKAGES="$OPTARG" ;;
+    l) LATENCY_MS="$OPTARG" ;;
+    o) LINES="$OPTARG" ;;
+    f) FAIL_PCT="$OPTARG" ;;
+    r) RUNS="$OPTARG" ;;
+    *) sed -n '3,16p' "$0"; exit 1 ;;
+  esac
+done
+
+shift $((OPTIND - 1))
+[ "$1" = "--" ] && shift
+
+SRC_DIR="$(cd "$(dirname "$0")" && pwd)"
+BENCH_DIR="$SRC_DIR/arcus_bench"
+WORK_DIR="$BENCH_DIR/work"
+
+# Resolved before the stand-in git is put on PATH
+COMMIT="$(git -C "$SRC_DIR" rev-parse --short HEAD 2>/dev/null || echo unknown)"
+git -C "$SRC_DIR" diff --quiet HEAD -- arcus.c arcus.h 2>/dev/null || COMMIT="$COMMIT+dirty"
+
+rm -rf "$WORK_DIR"
+mkdir -p "$WORK_DIR/bin" "$WORK_DIR/arcus_config"
+
+${CC:-clang} -O2 -o "$WORK_DIR/arcus" "$SRC_DIR/arcus.c"
+
+# Every stand-in only uses bash builtins, so each invocation costs exactly one exec and its own time is measurable
+cat > "$WORK_DIR/bin/stand-in" << 'EOF'
+#!/usr/bin/bash
+start=$EPOCHREALTIME
+manager=${0##*/}
+args="$*"
+seed=0
+
+for ((char_idx = 0; char_idx < ${#args}; ++char_idx)); do
+  printf -v code '%d' "'${args:char_idx:1}"
+  seed=$(( (seed * 31 + code) % 2147483647 ))
+done
+
+RANDOM=$seed
+status=0
+
+if [ "$manager" = "sudo" ]; then
+  printf '%s\t%s\t%s\n' "$manager" "$start" "$EPOCHREALTIME" >> "$ARCUS_BENCH_TRACE"
+  exec "$@"
+fi
+
+if (( ARCUS_BENCH_LATENCY_MS > 0 )); then
+  printf -v wait_for '%d.%03d' $((ARCUS_BENCH_LATENCY_MS / 1000)) $((ARCUS_BENCH_LATENCY_MS % 1000))
+  read -r -t "$wait_for" -u 9 _ 9<> "$ARCUS_BENCH_FIFO" || true
+fi
+
+for ((line_idx = 1; line_idx <= ARCUS_BENCH_LINES; ++line_idx)); do
+  printf '%s: (%d/%d) %s ... 100%%\n' "$manager" "$line_idx" "$ARCUS_BENCH_LINES" "$args"
+done
+
+if (( RANDOM % 100 < ARCUS_BENCH_FAIL_PCT )); then
+  echo "$manager: error: simulated failure" >&2
+  status=1
+fi
+
+printf '%s\t%s\t%s\n' "$manager" "$start" "$EPOCHREALTIME" >> "$ARCUS_BENCH_TRACE"
+exit $status
+EOF
+
+chmod +x "$WORK_DIR/bin/stand-in"
+
+for manager in sudo pacman yay flatpak git; do
+  ln -s stand-in "$WORK_DIR/bin/$manager"
+done
+
+mkfifo "$WORK_DIR/latency.fifo"
+
+{
+  for ((pkg_idx = 0; pkg_idx < PACKAGES; ++pkg_idx)); do
+    case $((pkg_idx % 4)) in
+      0) body='${ARCUS_SU_PACMAN} ${ARCUS_DEFAULT_PACMAN_ARGS} ${ARCUS_PACKAGES}' ;;
+      1) body='${ARCUS_YAY} ${ARCUS_DEFAULT_YAY_ARGS} ${ARCUS_PACKAGES}' ;;
+      2) body="flatpak install org.arcus.Bench$pkg_idx -y" ;;
+      3) body="git clone https://example.invalid/bench-$pkg_idx.git bench-$pkg_idx" ;;
+    esac
+
+    printf '{\n  "bench-%d",\n  "%s"\n}%s\n' "$pkg_idx" "$body" "$([ $((pkg_idx + 1)) -lt "$PACKAGES" ] && echo ,)"
+  done
+} > "$WORK_DIR/arcus_config/arcus.pkgs"
+
+cat > "$WORK_DIR/arcus_config/arcus.envs" << 'EOF'
+{
+  "ARCUS_SU_PACMAN",
+  "sudo pacman -S"
+},
+{
+  "ARCUS_DEFAULT_PACMAN_ARGS",
+  "--needed --noconfirm"
+},
+{
+  "ARCUS_YAY",
+  "yay -S"
+},
+{
+  "ARCUS_DEFAULT_YAY_ARGS",
+  "--needed --noconfirm"
+}
+EOF
+
+printf 'y\n' > "$WORK_DIR/answer"
+
+export PATH="$WORK_DIR/bin:$PATH"
+export ARCUS_SUDO="$WORK_DIR/bin/sudo"
+export ARCUS_BENCH_TRACE="$WORK_DIR/trace.tsv"
+export ARCUS_BENCH_FIFO="$WORK_DIR/latency.fifo"
+export ARCUS_BENCH_LATENCY_MS="$LATENCY_MS"
+export ARCUS_BENCH_LINES="$LINES"
+export ARCUS_BENCH_FAIL_PCT="$FAIL_PCT"
+
+# Forks are counted system-wide (/proc/stat), so benchmark on an otherwise idle machine
+forks_since_boot() {
+  local key value
+
+  while read -r key value _; do
+    if [ "$key" = "processes" ]; then
+      echo "$value"
+
+      return
+    fi
+  done < /proc/stat
+}
+
+RESULTS="$BENCH_DIR/results.tsv"
+HEADER=$'date\tcommit\tpackages\tlatency_ms\tlines\tfail_pct\targs\trun\tstatus\twall_ms\toverhead_us_per_pkg\tforks\tstand_in_execs\tpeak_rss_kb'
+
+# Rows written under an older header measure different things, so they're kept aside rather than mixed in
+if [ -f "$RESULTS" ] && [ "$(head -n 1 "$RESULTS")" != "$HEADER" ]; then
+  mv "$RESULTS" "$RESULTS.old"
+fi
+
+[ -f "$RESULTS" ] || printf '%s\n' "$HEADER" > "$RESULTS"
+
+SERIAL=1
+
+for arg in "$@"; do
+  case "$arg" in
+    --prefetch|--prefetch-jobs|--root) SERIAL=0 ;;
+  esac
+done
+
+exec 9<> "$ARCUS_BENCH_FIFO"
+
+total_wall=0
+total_overhead=0
+
+for ((run = 1; run <= RUNS; ++run)); do
+  rm -rf "$WORK_DIR/run"
+  mkdir "$WORK_DIR/run"
+  : > "$ARCUS_BENCH_TRACE"
+
+  forks_before=$(forks_since_boot)
+  start=$EPOCHREALTIME
+
+  (cd "$WORK_DIR/run" && exec "$WORK_DIR/arcus" install --config "$WORK_DIR/arcus_config" "$@" < "$WORK_DIR/answer" > "$WORK_DIR/output.txt" 2>&1) &
+  pid=$!
+  peak_rss=0
+
+  # VmHWM is the process's own high-water mark, sampled until it exits
+  while [ -r "/proc/$pid/status" ]; do
+    while read -r key value _; do
+      if [ "$key" = "VmHWM:" ] && [ "$value" -gt "$peak_rss" ]; then
+        peak_rss=$value
+      fi
+    done < "/proc/$pid/status" 2>/dev/null || true
+
+    read -r -t 0.005 -u 9 _ || true
+  done
+
+  status=0
+  wait "$pid" || status=$?
+
+  end=$EPOCHREALTIME
+  forks=$(( $(forks_since_boot) - forks_before - 1 ))
+
+  # Child time is what the stand-ins spent themselves, everything else is arcus (and the shells it starts)
+  child_us=0
+  execs=0
+
+  # Every stand-in invocation leaves one trace line, the shells running the bodies and the --elevate shim aren't traced
+  while IFS=$'\t' read -r _ child_start child_end; do
+    child_us=$(( child_us + ${child_end/./} - ${child_start/./} ))
+    execs=$(( execs + 1 ))
+  done < "$ARCUS_BENCH_TRACE"
+
+  wall_us=$(( ${end/./} - ${start/./} ))
+  total_wall=$(( total_wall + wall_us ))
+  overhead_us=-
+  overhead_text="n/a (children overlap)"
+
+  if (( SERIAL )); then
+    overhead_us=$(( (wall_us - child_us) / PACKAGES ))
+    overhead_text="${overhead_us}us arcus overhead per package"
+    total_overhead=$(( total_overhead + overhead_us ))
+  fi
+
+  printf '%s\t%s\t%d\t%d\t%d\t%d\t%s\t%d\t%d\t%d\t%s\t%d\t%d\t%d\n' \
+    "$(date -u +%Y-%m-%dT%H:%M:%SZ)" "$COMMIT" "$PACKAGES" "$LATENCY_MS" "$LINES" "$FAIL_PCT" "${*:--}" \
+    "$run" "$status" $((wall_us / 1000)) "$overhead_us" "$forks" "$execs" "$peak_rss" >> "$RESULTS"
+
+  echo "< RUN $run/$RUNS : exit $status, ${wall_us}us wall, $overhead_text, $forks forks, $execs stand-in execs, ${peak_rss}kB peak RSS >"
+done
+
+exec 9>&-
+
+if (( SERIAL )); then
+  echo "< AVERAGE OVER $RUNS RUN(S) : $((total_wall / RUNS / 1000))ms wall, $((total_overhead / RUNS))us arcus overhead per package >"
+else
+  echo "< AVERAGE OVER $RUNS RUN(S) : $((total_wall / RUNS / 1000))ms wall >"
+fi
+echo "< RESULTS APPENDED TO : $RESULTS >"
@@ -0,0 +1,24 @@
+#!/usr/bin/bash
+
+clang \
+  -DARCUS_EMBED_GENERATOR \
+  -Wall \
+  -Wextra \
+  -pedantic \
+  -o arcus-embed-gen \
+  arcus.c && \
+
+./arcus-embed-gen "$@" > arcus_embedded.h && \
+
+clang \
+  -DARCUS_EMBEDDED \
+  -Wall \
+  -Wextra \
+  -pedantic \
+  -I . \
+  -o arcus-embedded \
+  arcus.c && \
+
+rm -f arcus-embed-gen && \
+
+echo "< SUCCESSFULLY EMBEDDED arcus_config INTO arcus-embedded >"